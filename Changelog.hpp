@@ -1,5 +1,63 @@
 #pragma once
 /*
+    Changes in v1.6.6:
+    - BREAKING: Replaced the "m_blacklisted" vector in "Events.hpp" with a new "AtomicBitset" class, blacklisting and whitelisting is now safe to do from any thread while hooks are running and the "m_blacklistSafe" variable has been removed.
+    - BREAKING: "HookEventPre" and "HookEventPost" in "Events.hpp/cpp" now return a hook id which can be used to remove the hook later.
+    - BREAKING: Replaced "std::function" with the new "Delegate" class for pre and post hooks in "Events.hpp/cpp", as well as for every callback in the "Setting" and "Command" classes in "Variables.hpp/cpp".
+    - BREAKING: Changed the "HooksComponent::GameViewPortKeyPress" function in "Events.hpp/cpp" to use the new typed post hook.
+    - BREAKING: "EventGuard" is deprecated and moved into "DispatchFrame.hpp/cpp" as a wrapper around "DispatchFrame", "EventGuard.hpp/cpp" and the "EventPair" class were removed, "EventGuard::GetRefs" returns the amount of matching frames by value, and "EventGuard::ClearRefStore" does nothing.
+    - BREAKING: "GetAllDefaultInstancesOf" in "Instances.hpp" no longer returns archetypes, which the old "Default__" name check included, use "GetAllArchetypesOf" for them. "GetInstanceOf", "GetOrCreateInstance", and "GetAllInstancesOf" now skip objects that are pending kill.
+    - Replaced the "m_preHooks" and "m_postHooks" maps in "Events.hpp" with a new "EventTable" class, a flat dispatch table indexed directly by a functions "ObjectInternalInteger" so unhooked functions only cost a single bit test.
+    - Replaced the "EventsComponent::CanProcessHook" function with "EventsComponent::IsHooked" and "EventsComponent::FindHooks" in "Events.hpp/cpp".
+    - Added the "EventsComponent::BlacklistEvents", "EventsComponent::WhitelistEvents", "EventsComponent::BlacklistClass", and "EventsComponent::WhitelistClass" functions in "Events.hpp/cpp", for blacklisting functions in bulk by a wildcard pattern or by their owning class.
+    - Added a new "Format::MatchWildcard" function in "Formatting.hpp/cpp".
+    - Removed the redundant blacklist checks in "EventsComponent::CanCallHook" and "EventsComponent::ProcessAfter", each hooked call now only tests the blacklist once.
+    - Added the "Outer" and "Class" members to the "UObject" class in the "PlaceholderSDK".
+    - Added a new "EpochGuard" class in "EpochGuard.hpp/cpp", used for epoch based reclamation of shared read only data.
+    - Added new "UnhookEvent" and "UnhookEvents" functions in "Events.hpp/cpp".
+    - Hooks are now stored in immutable snapshots that are swapped atomically, hooking or unhooking at runtime no longer races with "ProcessEvent".
+    - Added a new "EventProfiler" class in "EventProfiler.hpp/cpp", an opt in latency profiler that records call counts, total/min/max time, and a histogram per hooked function and per callback. Commenting out "EVENT_PROFILER" in "pch.hpp" compiles it out of the dispatch path, and "EventsComponent::DispatchEvent<false>" dispatches without it.
+    - Added a new "events_profile" command in "Variables.cpp", which starts, stops, resets, or prints the most expensive hooks recorded by the "EventProfiler".
+    - Added a new "EventRecorder" class in "EventRecorder.hpp/cpp", which buffers process event records in per thread lock free rings and writes them to a binary trace file from a background thread.
+    - Added a new "events_trace" command in "Variables.cpp", which starts and stops recording or replays a trace file through "EventsComponent::ReplayTrace", which dispatches the recorded events matching a "TraceFilter" so their hooks run with a null caller and zeroed params.
+    - Added the "ParamsSize" member to the "UFunction" class in the "PlaceholderSDK".
+    - Added a new "Delegate" class in "Delegate.hpp", a non allocating callback type with inline storage that supports lambdas, function pointers, and member functions. "Delegate::Fits" tells if a callable is small enough to be bound.
+    - Added the "EventsComponent::HookEventsPre", "EventsComponent::HookEventsPost", "EventsComponent::HookClassPre", and "EventsComponent::HookClassPost" functions in "Events.hpp/cpp", for hooking every function matching a wildcard pattern or owned by a class.
+    - Added a new "EventsComponent::ResolvePatternHooks" function in "Events.hpp/cpp", which is called every tick from "HUDPostRender" and applies pattern and class hooks to newly loaded functions, including ones loaded into a garbage collected functions slot.
+    - "EventsComponent::UnhookEvent" now removes a hook from every function it was bound to, instead of only the first one.
+    - Added new "HookOptions" and "HookStats" classes in "Events.hpp/cpp", every hook function now takes optional "HookOptions" to filter callers by object, class, or ignoring default objects.
+    - Caller filters are checked in "ProcessBefore" and "ProcessAfter" before any callback is called or event is created, and skipped calls are counted per hook.
+    - Added a new "events_hooks" command in "Variables.cpp", which prints every hooked function along with each callbacks filter, call count, and skip count.
+    - Added the "HookOptions::EveryNthCall" and "HookOptions::MaxRate" options in "Events.hpp/cpp", for limiting how often a hook is called by call count or by a maximum rate using a steady clock.
+    - Added a new "DispatchFrame" class in "DispatchFrame.hpp/cpp", a thread local replacement for "EventGuard" in "Events.cpp" that needs no hash map and no shared state.
+    - Added a new "EventsComponent::DispatchEvent" function in "Events.hpp/cpp", "ProcessEventHook" and "ProcessInternalHook" now share it so each logical call is only dispatched once per thread.
+    - Added typed "HookEventPre<TCaller, TParams>" and "HookEventPost<TCaller, TParams>" template functions in "Events.hpp", which check the params size once when hooking (allowing for the structs trailing padding) and give a const callable callback typed references, skipping calls without a caller or params.
+    - Added a new "EventsComponent::HookEventAsync" function in "Events.hpp/cpp", async post hook callbacks run on a worker thread with a pooled copy of the params and fall back to running synchronously when the queue is full, "GetAsyncQueued", "GetAsyncFallbacks", and "GetAsyncBuffers" expose the counters printed by "events_hooks".
+    - Added new "ThreadPool" and "BufferPool" classes in "ThreadPool.hpp/cpp" and "BufferPool.hpp/cpp".
+    - Added a new "EventCensus" class in "EventCensus.hpp/cpp", along with the "events_census" command in "Variables.cpp" which counts every function and caller class going through process event (optionally sampling 1 in N calls) to find hook candidates.
+    - Added a vtable hook mode to the "FunctionHook" class in "FunctionHook.hpp/cpp" ("FunctionHook::AttachVTable"), enabling and disabling atomically swaps a single vtable entry without patching code or freezing threads, the page keeps its original protection afterwards.
+    - Added hook transactions to the "FunctionHook" class in "FunctionHook.hpp/cpp" ("BeginTransaction" and "CommitTransaction"), every hook attached or enabled in between is installed with a single thread freeze using MinHooks queued hooks or a single Detours transaction.
+    - Fixed "FunctionHook::Attach" in "FunctionHook.cpp" never setting the trampoline when using Detours, so "IsAttached" always returned false.
+    - MinHook now flushes the instruction cache once per batch when enabling all or queued hooks in "MinHook.cpp", instead of once per hook.
+    - MinHook now keeps a hash index from target address to hook entry in "MinHook.cpp", creating, enabling, disabling, and removing a hook no longer scans every hook.
+    - MinHook trampolines in "Buffer.hpp/cpp" are now carved from 64KB reserved regions committed a page at a time, with a free list per region and a cache of the last region used per 2GB window, so hooking nearby functions no longer searches for free memory each time, regions are released once their last trampoline is freed and on Linux free address space is found by reading "/proc/self/maps" once per search.
+    - Added a batch decode API and decoded instruction cache to the hde disassembler in "hdebatch.hpp/cpp", returning compact instruction boundaries along with relative branch and RIP relative operand info.
+    - Added a new "HookTelemetry" class in "FunctionHook.hpp/cpp", every hook now tracks its attach and enable time, override hits, and calls to the original function. Hits and original calls are counted per thread in a new "TelemetryStore" class and only summed when read, so hooked calls never write to a shared cache line.
+    - Added a registry of every "FunctionHook" in "FunctionHook.hpp/cpp", along with the "events_detours" command in "Variables.cpp" to print them and spot hooks that are never hit.
+    - Added a class index to "Instances.hpp/cpp", "GetInstanceOf" and related functions now only look at objects of the requested class instead of all of "GObjects". Every query first compares the indexed object pointers with "GObjects", so objects created in slots reused by the garbage collector are always found.
+    - Instance queries in "Instances.hpp/cpp" now tell default objects, archetypes, and pending kill objects apart by their flags instead of searching their full name for "Default__", "GetDefaultInstanceOf" and "GetAllDefaultInstancesOf" only return class default objects and the new "GetAllArchetypesOf" function returns archetypes.
+    - Added a full name index to "Instances.hpp/cpp", strict "FindObject" calls are now a single hash lookup after the first one, duplicate names are counted so the newest live object keeps the name when another one is garbage collected, and a miss compares every slot with "GObjects" before returning null.
+    - Added a new "TrigramIndex" class in "TrigramIndex.hpp/cpp", along with the "instances_trigrams" command in "Variables.cpp" to build one over every objects name in the background for faster substring searches. It's never rebuilt automatically, a warning is written once too many objects changed since it was built.
+    - Added a new "ThreadPool::ParallelFor" function in "ThreadPool.hpp/cpp", full "GObjects" name scans in "Instances.hpp/cpp" are now split across threads (static class and function caches, the full name index, trigram snapshots, and substring searches without a trigram index).
+    - Added a new "instances_scan_threads" setting in "Variables.cpp", for choosing how many threads a parallel "GObjects" scan uses.
+    - Added a new "CodeRedTests" console project in "Tests/CodeRedTests.vcxproj", which builds every component against a test sdk in "Tests/TestSDK" with "CR_TESTS" defined and runs the tests in the "Tests" folder, benchmarks only run with "--bench".
+    - Moved "EventsComponent::DispatchEvent" in "Events.hpp" to public so it can be tested without attaching the detours.
+    - "InstancesComponent::OnDestroy" in "Instances.cpp" now also clears the cached static classes and functions.
+    - The "EventRecorder" and "EventCensus" are now fed from "EventsComponent::RecordEvent" in "Events.hpp/cpp" after the "DispatchFrame" check, so a script call seen by both detours is only recorded and counted once.
+    - Added a new "FunctionHook::ForEachHook" function in "FunctionHook.hpp/cpp", which takes a "Delegate" and is used by the "events_detours" command to print every hook.
+    - Replaced the "InstancesComponent::UpdateClassIndex" call in "HUDPostRender" with the new "InstancesComponent::CheckTrigramIndex" function in "Instances.hpp/cpp", instance queries keep the class index up to date themselves.
+    - Full name lookups, substring searches, and trigram index builds in "Instances.hpp/cpp" now build and check names without holding the index lock, so other instance queries aren't blocked by them.
+
     Changes in v1.6.5:
     - Made the "VariableComponent::GetCommand" and "VariableComponent::GetSetting" functions const in "Variables.hpp/cpp".
     - Improved the "Rotator::UnrealRotator" function in "Math.cpp" to avoid unnecessary math functions.
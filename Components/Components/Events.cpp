@@ -108,6 +108,53 @@ namespace CodeRed
 		return *this;
 	}
 
+	AsyncEvent::AsyncEvent() : m_caller(nullptr), m_function(nullptr), m_params{ nullptr, 0, BUFFER_POOL_UNPOOLED }, m_type(EventTypes::Unknown) {}
+
+	AsyncEvent::AsyncEvent(class UObject* caller, class UFunction* function, const PooledBuffer& params, EventTypes eventType) : m_caller(caller), m_function(function), m_params(params), m_type(eventType) {}
+
+	AsyncEvent::AsyncEvent(const AsyncEvent& asyncEvent) : m_caller(asyncEvent.m_caller), m_function(asyncEvent.m_function), m_params(asyncEvent.m_params), m_type(asyncEvent.m_type) {}
+
+	AsyncEvent::~AsyncEvent() {}
+
+	EventTypes AsyncEvent::GetType() const
+	{
+		return m_type;
+	}
+
+	class UObject* AsyncEvent::Caller() const
+	{
+		return m_caller;
+	}
+
+	class UFunction* AsyncEvent::Function() const
+	{
+		return m_function;
+	}
+
+	const void* AsyncEvent::Params() const
+	{
+		return m_params.Data;
+	}
+
+	size_t AsyncEvent::ParamsSize() const
+	{
+		return m_params.Size;
+	}
+
+	const PooledBuffer& AsyncEvent::GetBuffer() const
+	{
+		return m_params;
+	}
+
+	AsyncEvent& AsyncEvent::operator=(const AsyncEvent& asyncEvent)
+	{
+		m_caller = asyncEvent.m_caller;
+		m_function = asyncEvent.m_function;
+		m_params = asyncEvent.m_params;
+		m_type = asyncEvent.m_type;
+		return *this;
+	}
+
 	HooksComponent::HooksComponent() : Component("Hooks", "Manages hooked functions and their arguments.") { OnCreate(); }
 
 	HooksComponent::~HooksComponent() { OnDestroy(); }
@@ -142,6 +189,8 @@ namespace CodeRed
 			}
 
 			Manager.OnTick(); // Required to process commands from different threads or commands with async delays.
+			Events.ResolvePatternHooks(); // Picks up functions from packages loaded since the last tick, for pattern and class hooks.
+			Instances.CheckTrigramIndex(); // Instance queries keep their own index up to date, this only reports a trigram index that finished building in the background.
 		}
 	}
 
@@ -163,20 +212,432 @@ namespace CodeRed
 
 	// Post Hooks
 
-	void HooksComponent::GameViewPortKeyPress(const PostEvent& event)
+	void HooksComponent::GameViewPortKeyPress(class UGameViewportClient& viewportClient, struct UGameViewportClient_TA_execHandleKeyPress_Params& params, const PostEvent& event)
+	{
+		if (params.EventType == static_cast<uint8_t>(EInputEvent::IE_Released))
+		{
+			// Blah blah do key pressed stuff here blah blah
+		}
+	}
+
+	class HooksComponent Hooks;
+
+	HookOptions::HookOptions() : Filter(CallerFilters::None), FilterObject(nullptr), FilterClass(nullptr), CallInterval(0), RateInterval(0) {}
+
+	HookOptions::HookOptions(const HookOptions& hookOptions) :
+		Filter(hookOptions.Filter),
+		FilterObject(hookOptions.FilterObject),
+		FilterClass(hookOptions.FilterClass),
+		CallInterval(hookOptions.CallInterval),
+		RateInterval(hookOptions.RateInterval)
+	{
+
+	}
+
+	HookOptions::~HookOptions() {}
+
+	HookOptions& HookOptions::CallerObject(class UObject* uObject)
+	{
+		Filter = CallerFilters::Object;
+		FilterObject = uObject;
+		return *this;
+	}
+
+	HookOptions& HookOptions::CallerClass(class UClass* uClass)
+	{
+		Filter = CallerFilters::Class;
+		FilterClass = uClass;
+		return *this;
+	}
+
+	HookOptions& HookOptions::NotDefault()
+	{
+		Filter = CallerFilters::NotDefault;
+		return *this;
+	}
+
+	HookOptions& HookOptions::EveryNthCall(uint32_t callInterval)
+	{
+		CallInterval = callInterval;
+		return *this;
+	}
+
+	HookOptions& HookOptions::MaxRate(float callsPerSecond)
+	{
+		RateInterval = ((callsPerSecond > 0.0f) ? static_cast<uint64_t>(1000000000.0 / callsPerSecond) : 0);
+		return *this;
+	}
+
+	bool HookOptions::IsLimited() const
+	{
+		return ((CallInterval > 1) || (RateInterval > 0));
+	}
+
+	bool HookOptions::PassesFilter(class UObject* caller) const
+	{
+		switch (Filter)
+		{
+		case CallerFilters::None:
+			return true;
+		case CallerFilters::Object:
+			return (caller == FilterObject);
+		case CallerFilters::Class:
+			return (caller && caller->IsA(FilterClass));
+		case CallerFilters::NotDefault:
+			return (caller && !(caller->ObjectFlags & (EObjectFlags::RF_ClassDefaultObject | EObjectFlags::RF_ArchetypeObject)));
+		default:
+			return true;
+		}
+	}
+
+	bool HookOptions::PassesLimit(class HookStats& hookStats) const
 	{
-		if (event.Params())
+		if ((CallInterval > 1) && ((hookStats.Counter.fetch_add(1, std::memory_order_relaxed) % CallInterval) != 0))
+		{
+			return false;
+		}
+
+		if (RateInterval > 0)
 		{
-			UGameViewportClient_TA_execHandleKeyPress_Params* handleKeyPress = event.GetParams<UGameViewportClient_TA_execHandleKeyPress_Params>();
+			uint64_t currentTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+			uint64_t lastCall = hookStats.LastCall.load(std::memory_order_relaxed);
 
-			if (handleKeyPress->EventType == static_cast<uint8_t>(EInputEvent::IE_Released))
+			if ((currentTime - lastCall) < RateInterval)
 			{
-				// Blah blah do key pressed stuff here blah blah
+				return false;
 			}
+
+			// If another thread got here first for the same window it wins, and this call is dropped.
+			return hookStats.LastCall.compare_exchange_strong(lastCall, currentTime, std::memory_order_relaxed);
 		}
+
+		return true;
 	}
 
-	class HooksComponent Hooks;
+	std::string HookOptions::GetFilterName() const
+	{
+		switch (Filter)
+		{
+		case CallerFilters::Object:
+			return ("Object " + (FilterObject ? FilterObject->GetFullName() : "None"));
+		case CallerFilters::Class:
+			return ("Class " + (FilterClass ? FilterClass->GetFullName() : "None"));
+		case CallerFilters::NotDefault:
+			return "Not Default";
+		default:
+			return "None";
+		}
+	}
+
+	std::string HookOptions::GetLimitName() const
+	{
+		std::string limitName;
+
+		if (CallInterval > 1)
+		{
+			limitName = "Every " + std::to_string(CallInterval) + " Calls";
+		}
+
+		if (RateInterval > 0)
+		{
+			limitName += (limitName.empty() ? "" : ", ") + Format::Precision(1000000000.0f / static_cast<float>(RateInterval), 2) + " Hz";
+		}
+
+		return (limitName.empty() ? "None" : limitName);
+	}
+
+	HookOptions& HookOptions::operator=(const HookOptions& hookOptions)
+	{
+		Filter = hookOptions.Filter;
+		FilterObject = hookOptions.FilterObject;
+		FilterClass = hookOptions.FilterClass;
+		CallInterval = hookOptions.CallInterval;
+		RateInterval = hookOptions.RateInterval;
+		return *this;
+	}
+
+	HookStats::HookStats() : Calls(0), Skipped(0), Limited(0), Counter(0), LastCall(0) {}
+
+	HookStats::~HookStats() {}
+
+	EventHooks::EventHooks() {}
+
+	EventHooks::EventHooks(const EventHooks& eventHooks) : PreHooks(eventHooks.PreHooks), PostHooks(eventHooks.PostHooks) {}
+
+	EventHooks::~EventHooks() {}
+
+	EventHooks& EventHooks::operator=(const EventHooks& eventHooks)
+	{
+		PreHooks = eventHooks.PreHooks;
+		PostHooks = eventHooks.PostHooks;
+		return *this;
+	}
+
+	EventTable::EventTable() : m_preHooked(0), m_postHooked(0) {}
+
+	EventTable::EventTable(const EventTable& eventTable) :
+		m_hookedBits(eventTable.m_hookedBits),
+		m_slots(eventTable.m_slots),
+		m_hooks(eventTable.m_hooks),
+		m_preHooked(eventTable.m_preHooked),
+		m_postHooked(eventTable.m_postHooked)
+	{
+
+	}
+
+	EventTable::~EventTable() {}
+
+	bool EventTable::IsHooked(uint64_t functionIndex) const
+	{
+		uint64_t bitWord = (functionIndex >> 6);
+		return ((bitWord < m_hookedBits.size()) && (m_hookedBits[bitWord] & (1ULL << (functionIndex & 63))));
+	}
+
+	bool EventTable::IsPreHooked(uint64_t functionIndex) const
+	{
+		const EventHooks* eventHooks = GetHooks(functionIndex);
+		return (eventHooks && !eventHooks->PreHooks.empty());
+	}
+
+	bool EventTable::IsPostHooked(uint64_t functionIndex) const
+	{
+		const EventHooks* eventHooks = GetHooks(functionIndex);
+		return (eventHooks && !eventHooks->PostHooks.empty());
+	}
+
+	const EventHooks* EventTable::GetHooks(uint64_t functionIndex) const
+	{
+		if (IsHooked(functionIndex))
+		{
+			return &m_hooks[m_slots[functionIndex] - 1];
+		}
+
+		return nullptr;
+	}
+
+	size_t EventTable::GetPreHookedCount() const
+	{
+		return m_preHooked;
+	}
+
+	size_t EventTable::GetPostHookedCount() const
+	{
+		return m_postHooked;
+	}
+
+	size_t EventTable::GetSize() const
+	{
+		return m_slots.size();
+	}
+
+	void EventTable::AddPreHook(uint64_t functionIndex, const PreHook& preHook)
+	{
+		EventHooks& eventHooks = CreateHooks(functionIndex);
+		bool hadPre = !eventHooks.PreHooks.empty();
+		bool hadPost = !eventHooks.PostHooks.empty();
+		eventHooks.PreHooks.push_back(preHook);
+		UpdateHooked(functionIndex, hadPre, hadPost);
+	}
+
+	void EventTable::AddPostHook(uint64_t functionIndex, const PostHook& postHook)
+	{
+		EventHooks& eventHooks = CreateHooks(functionIndex);
+		bool hadPre = !eventHooks.PreHooks.empty();
+		bool hadPost = !eventHooks.PostHooks.empty();
+		eventHooks.PostHooks.push_back(postHook);
+		UpdateHooked(functionIndex, hadPre, hadPost);
+	}
+
+	bool EventTable::RemoveHook(uint32_t hookId)
+	{
+		bool hookFound = false;
+
+		for (size_t functionIndex = 0; functionIndex < m_slots.size(); functionIndex++) // Pattern and class hooks share one id across every function they matched.
+		{
+			if (m_slots[functionIndex])
+			{
+				EventHooks& eventHooks = m_hooks[m_slots[functionIndex] - 1];
+				bool hadPre = !eventHooks.PreHooks.empty();
+				bool hadPost = !eventHooks.PostHooks.empty();
+				size_t preRemoved = std::erase_if(eventHooks.PreHooks, [&](const PreHook& preHook) { return (preHook.Id == hookId); });
+				size_t postRemoved = std::erase_if(eventHooks.PostHooks, [&](const PostHook& postHook) { return (postHook.Id == hookId); });
+
+				if ((preRemoved > 0) || (postRemoved > 0))
+				{
+					UpdateHooked(functionIndex, hadPre, hadPost);
+					hookFound = true;
+				}
+			}
+		}
+
+		return hookFound;
+	}
+
+	size_t EventTable::RemoveHooks(uint64_t functionIndex)
+	{
+		size_t hooksRemoved = 0;
+
+		if ((functionIndex < m_slots.size()) && m_slots[functionIndex])
+		{
+			EventHooks& eventHooks = m_hooks[m_slots[functionIndex] - 1];
+			bool hadPre = !eventHooks.PreHooks.empty();
+			bool hadPost = !eventHooks.PostHooks.empty();
+			hooksRemoved = (eventHooks.PreHooks.size() + eventHooks.PostHooks.size());
+			eventHooks.PreHooks.clear();
+			eventHooks.PostHooks.clear();
+			UpdateHooked(functionIndex, hadPre, hadPost);
+		}
+
+		return hooksRemoved;
+	}
+
+	size_t EventTable::RemoveHooks(uint64_t functionIndex, const std::vector<uint32_t>& hookIds)
+	{
+		size_t hooksRemoved = 0;
+
+		if ((functionIndex < m_slots.size()) && m_slots[functionIndex])
+		{
+			EventHooks& eventHooks = m_hooks[m_slots[functionIndex] - 1];
+			bool hadPre = !eventHooks.PreHooks.empty();
+			bool hadPost = !eventHooks.PostHooks.empty();
+			hooksRemoved += std::erase_if(eventHooks.PreHooks, [&](const PreHook& preHook) { return (std::find(hookIds.begin(), hookIds.end(), preHook.Id) != hookIds.end()); });
+			hooksRemoved += std::erase_if(eventHooks.PostHooks, [&](const PostHook& postHook) { return (std::find(hookIds.begin(), hookIds.end(), postHook.Id) != hookIds.end()); });
+
+			if (hooksRemoved > 0)
+			{
+				UpdateHooked(functionIndex, hadPre, hadPost);
+			}
+		}
+
+		return hooksRemoved;
+	}
+
+	void EventTable::Clear()
+	{
+		m_hookedBits.clear();
+		m_slots.clear();
+		m_hooks.clear();
+		m_preHooked = 0;
+		m_postHooked = 0;
+	}
+
+	EventHooks& EventTable::CreateHooks(uint64_t functionIndex)
+	{
+		uint64_t bitWord = (functionIndex >> 6);
+
+		if (bitWord >= m_hookedBits.size())
+		{
+			m_hookedBits.resize(bitWord + 1, 0);
+		}
+
+		if (functionIndex >= m_slots.size())
+		{
+			m_slots.resize(functionIndex + 1, 0);
+		}
+
+		if (!m_slots[functionIndex])
+		{
+			m_hooks.emplace_back();
+			m_slots[functionIndex] = static_cast<uint32_t>(m_hooks.size());
+		}
+
+		return m_hooks[m_slots[functionIndex] - 1];
+	}
+
+	void EventTable::UpdateHooked(uint64_t functionIndex, bool bHadPre, bool bHadPost)
+	{
+		const EventHooks& eventHooks = m_hooks[m_slots[functionIndex] - 1];
+		bool hasPre = !eventHooks.PreHooks.empty();
+		bool hasPost = !eventHooks.PostHooks.empty();
+
+		if (hasPre != bHadPre)
+		{
+			hasPre ? m_preHooked++ : m_preHooked--;
+		}
+
+		if (hasPost != bHadPost)
+		{
+			hasPost ? m_postHooked++ : m_postHooked--;
+		}
+
+		// Slots are kept when emptied so the function can be hooked again, only the bit decides if it's dispatched.
+		if (hasPre || hasPost)
+		{
+			m_hookedBits[functionIndex >> 6] |= (1ULL << (functionIndex & 63));
+		}
+		else
+		{
+			m_hookedBits[functionIndex >> 6] &= ~(1ULL << (functionIndex & 63));
+		}
+	}
+
+	EventTable& EventTable::operator=(const EventTable& eventTable)
+	{
+		m_hookedBits = eventTable.m_hookedBits;
+		m_slots = eventTable.m_slots;
+		m_hooks = eventTable.m_hooks;
+		m_preHooked = eventTable.m_preHooked;
+		m_postHooked = eventTable.m_postHooked;
+		return *this;
+	}
+
+	PatternHook::PatternHook() : Id(0), OwnerClass(nullptr) {}
+
+	PatternHook::PatternHook(const std::string& pattern, class UClass* ownerClass, const HookOptions& options) :
+		Id(0),
+		Pattern(pattern),
+		OwnerClass(ownerClass),
+		Options(options),
+		Stats(std::make_shared<HookStats>())
+	{
+
+	}
+
+	PatternHook::PatternHook(const PatternHook& patternHook) :
+		Id(patternHook.Id),
+		Pattern(patternHook.Pattern),
+		OwnerClass(patternHook.OwnerClass),
+		PreCallback(patternHook.PreCallback),
+		PostCallback(patternHook.PostCallback),
+		Options(patternHook.Options),
+		Stats(patternHook.Stats)
+	{
+
+	}
+
+	PatternHook::~PatternHook() {}
+
+	bool PatternHook::NeedsName() const
+	{
+		return !OwnerClass;
+	}
+
+	bool PatternHook::Matches(class UFunction* function, const std::string& functionName) const
+	{
+		if (function)
+		{
+			if (OwnerClass)
+			{
+				return (function->Outer == OwnerClass);
+			}
+
+			return Format::MatchWildcard(functionName, Pattern);
+		}
+
+		return false;
+	}
+
+	PatternHook& PatternHook::operator=(const PatternHook& patternHook)
+	{
+		Id = patternHook.Id;
+		Pattern = patternHook.Pattern;
+		OwnerClass = patternHook.OwnerClass;
+		PreCallback = patternHook.PreCallback;
+		PostCallback = patternHook.PostCallback;
+		Options = patternHook.Options;
+		Stats = patternHook.Stats;
+		return *this;
+	}
 
 	EventsComponent::EventsComponent() : Component("Events", "Manages function hooks and process event.") { OnCreate(); }
 
@@ -184,18 +645,27 @@ namespace CodeRed
 
 	void EventsComponent::OnCreate()
 	{
-		m_hooksSafe = false;
-		m_blacklistSafe = false;
+		m_lastHookId = 0;
+		m_resolveDiffPosition = 0;
+		m_asyncQueued = 0;
+		m_asyncFallbacks = 0;
 	}
 
 	void EventsComponent::OnDestroy()
 	{
 		DetachDetours();
+		m_asyncPool.Stop(); // Finishes every queued async callback first, so no buffers are still in use.
+		m_asyncBuffers.Clear();
 		OnCreate(); // Reset everything to default.
-		m_blacklisted.clear();
-		m_preHooks.clear();
-		m_postHooks.clear();
-		EventGuard::ClearRefStore();
+		m_blacklisted.Clear();
+
+		{
+			std::lock_guard<std::mutex> hookLock(m_hookMutex);
+			EpochGuard::Retire(m_eventTable.exchange(nullptr));
+			m_hooked.Clear();
+			m_patternHooks.clear();
+			m_resolvedSlots.clear();
+		}
 	}
 
 	bool EventsComponent::Initialize()
@@ -220,11 +690,13 @@ namespace CodeRed
 
 				// Post Hooks
 
-				HookEventPost("Function Engine.GameViewportClient.HandleKeyPress", [&](const PostEvent& event) { Hooks.GameViewPortKeyPress(event); });
+				HookEventPost<UGameViewportClient, UGameViewportClient_TA_execHandleKeyPress_Params>("Function Engine.GameViewportClient.HandleKeyPress", [&](UGameViewportClient& viewportClient, UGameViewportClient_TA_execHandleKeyPress_Params& params, const PostEvent& event) { Hooks.GameViewPortKeyPress(viewportClient, params, event); });
 
-				Console.Write(GetNameFormatted() + std::to_string(m_blacklisted.size()) + " Backlisted Event(s)!");
-				Console.Write(GetNameFormatted() + std::to_string(m_preHooks.size()) + " Pre-Hook(s) Initialized!");
-				Console.Write(GetNameFormatted() + std::to_string(m_postHooks.size()) + " Post-Hook(s) Initialized!");
+				Console.Write(GetNameFormatted() + std::to_string(m_blacklisted.Count()) + " Backlisted Event(s)!");
+				EpochGuard epochGuard;
+				const EventTable* eventTable = m_eventTable.load(std::memory_order_acquire);
+				Console.Write(GetNameFormatted() + std::to_string(eventTable ? eventTable->GetPreHookedCount() : 0) + " Pre-Hook(s) Initialized!");
+				Console.Write(GetNameFormatted() + std::to_string(eventTable ? eventTable->GetPostHookedCount() : 0) + " Post-Hook(s) Initialized!");
 				Console.Success(GetNameFormatted() + "Initialized!");
 				SetInitialized(true);
 			}
@@ -257,6 +729,11 @@ namespace CodeRed
 		return false;
 #endif
 
+		uint64_t attachStart = EventProfiler::GetTimestamp();
+		m_processEvent.SetName("ProcessEvent");
+		m_processInternal.SetName("ProcessInternal");
+		FunctionHook::BeginTransaction(); // Every detour below is installed at once when committed, with a single thread freeze.
+
 #ifdef DETOUR_PROCEVENT
 		if (!m_processEvent.IsAttached())
 		{
@@ -265,6 +742,7 @@ namespace CodeRed
 			//Attach(reinterpret_cast<uintptr_t*>(Memory::FindPattern(ProcessEvent_Pattern, ProcessEvent_Mask))); // Find pattern method.
 
 			void** vfTable = reinterpret_cast<void**>(UObject::StaticClass()->VfTableObject.Dummy);
+			//m_processEvent.AttachVTable(vfTable, 69, ProcessEventHook); // VTable method, no code patching or thread freezing but only catches objects using this exact vtable.
 
 			if (vfTable && m_processEvent.Attach(reinterpret_cast<uintptr_t*>(vfTable[69]), ProcessEventHook))
 			{
@@ -290,341 +768,1289 @@ namespace CodeRed
 				}
 				else
 				{
-					Console.Error("[Events Component] (AttachDetours) Failed to hook process internal!");
+					Console.Error("[Events Component] (AttachDetours) Failed to hook process internal!");
+				}
+			}
+		}
+#endif
+
+		if (!FunctionHook::CommitTransaction())
+		{
+			Console.Error("[Events Component] (AttachDetours) Failed to commit detours!");
+		}
+
+		Console.Write("[Events Component] Detours attached in " + FormatTime(EventProfiler::GetTimestamp() - attachStart) + ".");
+		return AreDetoursAttached();
+	}
+
+	void EventsComponent::DetachDetours()
+	{
+		m_processEvent.Detach();
+		m_processInternal.Detach();
+	}
+
+	void EventsComponent::ProcessEventHook(class UObject* caller, class UFunction* function, void* params, void* result)
+	{
+#ifdef DETOUR_PROCEVENT
+		if (m_processEvent.IsAttached())
+		{
+			m_processEvent.RecordHit();
+			DispatchEvent(caller, function, params, result, EventTypes::ProcessEvent, [&]() { m_processEvent.Call<HookTypes::ProcessEvent>()(caller, function, params, result); });
+		}
+#endif
+	}
+
+	void EventsComponent::ProcessInternalHook(class UObject* caller, struct FFrame& frame, void* result)
+	{
+#ifdef DETOUR_PROCINTERNAL
+		if (m_processInternal.IsAttached())
+		{
+			m_processInternal.RecordHit();
+			DispatchEvent(caller, static_cast<UFunction*>(frame.Node), frame.Locals, result, EventTypes::ProcessInternal, [&]() { m_processInternal.Call<HookTypes::ProcessInternal>()(caller, frame, result); });
+		}
+#endif
+	}
+
+	class UFunction* EventsComponent::FindTypedFunction(const std::string& functionName, size_t paramsSize, size_t paramsAlignment)
+	{
+		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+
+		if (foundFunction)
+		{
+			// The engines size doesn't include the padding the compiler adds to the end of the struct, so anything less than the structs alignment is allowed.
+			if ((foundFunction->ParamsSize <= paramsSize) && ((paramsSize - foundFunction->ParamsSize) < paramsAlignment))
+			{
+				return foundFunction;
+			}
+			else
+			{
+				Console.Warning("Warning: Failed to hook function \"" + functionName + "\", expected a params size of " + std::to_string(foundFunction->ParamsSize) + " but got " + std::to_string(paramsSize) + "!");
+			}
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to hook function \"" + functionName + "\"!");
+		}
+
+		return nullptr;
+	}
+
+	void EventsComponent::DispatchAsync(const std::shared_ptr<Delegate<void(const AsyncEvent&)>>& asyncHook, const PostEvent& event)
+	{
+		size_t paramsSize = ((event.Params() && event.Function()) ? event.Function()->ParamsSize : 0);
+		PooledBuffer paramsBuffer = m_asyncBuffers.Acquire(paramsSize);
+
+		if (paramsSize > 0)
+		{
+			std::memcpy(paramsBuffer.Data, event.Params(), paramsSize);
+		}
+
+		AsyncEvent asyncEvent(event.Caller(), event.Function(), paramsBuffer, event.GetType());
+
+		if (m_asyncPool.TryEnqueue([asyncHook, asyncEvent]() { (*asyncHook)(asyncEvent); m_asyncBuffers.Release(asyncEvent.GetBuffer()); }))
+		{
+			m_asyncQueued.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			// Back pressure, the workers can't keep up so the calling thread pays for this one instead of dropping it.
+			m_asyncFallbacks.fetch_add(1, std::memory_order_relaxed);
+			(*asyncHook)(asyncEvent);
+			m_asyncBuffers.Release(asyncEvent.GetBuffer());
+		}
+	}
+
+	template <bool bProfiled> void EventsComponent::DispatchEvent(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const Delegate<void()>& callOriginal)
+	{
+		bool bHooked = IsHooked(function, eventType);
+
+		if (!bHooked && IsBlacklisted(function))
+		{
+			RecordEvent(caller, function, eventType); // The original is never called, so the other detour can't see this call again.
+#ifdef TRACE_BLACKLISTS
+			if (function)
+			{
+				Console.Error("[Events Component] (DispatchEvent) Blacklist found for \"" + function->GetFullName() + "\"!");
+			}
+#endif
+
+			return;
+		}
+
+		if (bHooked || EventRecorder::IsRecording() || EventCensus::IsEnabled())
+		{
+			DispatchFrame dispatchFrame(caller, function);
+
+			if (dispatchFrame.IsFirst())
+			{
+				RecordEvent(caller, function, eventType); // Only after the frame check, so a script call seen by both detours is recorded and counted once.
+
+				if (bHooked)
+				{
+					EpochGuard epochGuard; // Keeps the snapshot alive until the post hooks are done, even if a callback unhooks itself.
+					const EventHooks* eventHooks = FindHooks(function, eventType);
+					ProcessResults processResult = ProcessBefore<bProfiled>(caller, function, params, result, eventType, eventHooks);
+
+					if (CanCallHook(processResult, eventType))
+					{
+						callOriginal();
+					}
+#ifdef TRACE_BLACKLISTS
+					else if (function)
+					{
+						Console.Error("[Events Component] (DispatchEvent) Don't want to call function \"" + function->GetFullName() + "\"!");
+					}
+#endif
+
+					ProcessAfter<bProfiled>(caller, function, params, result, eventType, eventHooks);
+					return;
+				}
+			}
+#ifdef TRACE_GUARDS
+			else if (bHooked && function)
+			{
+				Console.Error("[Events Component] (DispatchEvent) Already dispatching \"" + function->GetFullName() + "\"!");
+			}
+#endif
+
+			callOriginal(); // Still inside the frame, so if the other detour sees this call further down the stack it isn't recorded again.
+			return;
+		}
+
+		callOriginal(); // Unhooked and nothing is being recorded, which is almost every call.
+	}
+
+	void EventsComponent::RecordEvent(class UObject* caller, class UFunction* function, EventTypes eventType)
+	{
+		if (EventRecorder::IsRecording() && function)
+		{
+			EventRecorder::Record(reinterpret_cast<uint64_t>(caller), function->ObjectInternalInteger, static_cast<uint8_t>(eventType), function->ParamsSize);
+		}
+
+		if (EventCensus::IsEnabled() && function && caller && caller->Class)
+		{
+			EventCensus::Record(function->ObjectInternalInteger, caller->Class->ObjectInternalInteger);
+		}
+	}
+
+	bool EventsComponent::IsBlacklisted(class UFunction* function)
+	{
+		if (function)
+		{
+			return IsBlacklisted(function->ObjectInternalInteger);
+		}
+
+		return false;
+	}
+
+	bool EventsComponent::IsBlacklisted(uint64_t functionIndex)
+	{
+		return m_blacklisted.Test(functionIndex);
+	}
+
+	bool EventsComponent::IsPreHooked(class UFunction* function)
+	{
+		if (function)
+		{
+			return IsPreHooked(function->ObjectInternalInteger);
+		}
+
+		return false;
+	}
+
+	bool EventsComponent::IsPreHooked(uint64_t functionIndex)
+	{
+		EpochGuard epochGuard;
+		const EventTable* eventTable = m_eventTable.load(std::memory_order_acquire);
+		return (eventTable && eventTable->IsPreHooked(functionIndex));
+	}
+
+	bool EventsComponent::IsPostHooked(class UFunction* function)
+	{
+		if (function)
+		{
+			return IsPostHooked(function->ObjectInternalInteger);
+		}
+
+		return false;
+	}
+
+	bool EventsComponent::IsPostHooked(uint64_t functionIndex)
+	{
+		EpochGuard epochGuard;
+		const EventTable* eventTable = m_eventTable.load(std::memory_order_acquire);
+		return (eventTable && eventTable->IsPostHooked(functionIndex));
+	}
+
+	void EventsComponent::BlacklistEvent(const std::string& function)
+	{
+		UFunction* foundFunction = Instances.FindStaticFunction(function);
+
+		if (foundFunction)
+		{
+			m_blacklisted.Set(foundFunction->ObjectInternalInteger);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to blacklist function \"" + function + "\"!");
+		}
+	}
+
+	void EventsComponent::WhitelistEvent(const std::string& functionName)
+	{
+		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+
+		if (foundFunction)
+		{
+			m_blacklisted.Reset(foundFunction->ObjectInternalInteger);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to whitelist function \"" + functionName + "\"!");
+		}
+	}
+
+	size_t EventsComponent::BlacklistEvents(const std::string& pattern)
+	{
+		return SetBlacklisted([&](UFunction* function) { return Format::MatchWildcard(function->GetFullName(), pattern); }, true);
+	}
+
+	size_t EventsComponent::WhitelistEvents(const std::string& pattern)
+	{
+		return SetBlacklisted([&](UFunction* function) { return Format::MatchWildcard(function->GetFullName(), pattern); }, false);
+	}
+
+	size_t EventsComponent::BlacklistClass(const std::string& className)
+	{
+		UClass* foundClass = Instances.FindStaticClass(className);
+
+		if (foundClass)
+		{
+			return BlacklistClass(foundClass);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to blacklist class \"" + className + "\"!");
+		}
+
+		return 0;
+	}
+
+	size_t EventsComponent::BlacklistClass(class UClass* uClass)
+	{
+		if (uClass)
+		{
+			return SetBlacklisted([&](UFunction* function) { return (function->Outer == uClass); }, true);
+		}
+
+		return 0;
+	}
+
+	size_t EventsComponent::WhitelistClass(const std::string& className)
+	{
+		UClass* foundClass = Instances.FindStaticClass(className);
+
+		if (foundClass)
+		{
+			return WhitelistClass(foundClass);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to whitelist class \"" + className + "\"!");
+		}
+
+		return 0;
+	}
+
+	size_t EventsComponent::WhitelistClass(class UClass* uClass)
+	{
+		if (uClass)
+		{
+			return SetBlacklisted([&](UFunction* function) { return (function->Outer == uClass); }, false);
+		}
+
+		return 0;
+	}
+
+	uint32_t EventsComponent::HookEventPre(const std::string& functionName, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions)
+	{
+		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+
+		if (foundFunction)
+		{
+			return HookEventPre(foundFunction->ObjectInternalInteger, preHook, hookOptions);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to hook function \"" + functionName + "\"!");
+		}
+
+		return 0;
+	}
+
+	uint32_t EventsComponent::HookEventPre(uint64_t functionIndex, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions)
+	{
+		uint32_t hookId = 0;
+
+		if (UObject::GObjObjects() && (functionIndex < UObject::GObjObjects()->size()))
+		{
+			UObject* foundFunction = UObject::GObjObjects()->at(functionIndex);
+
+			if (foundFunction && foundFunction->IsA<UFunction>())
+			{
+				ModifyTable([&](EventTable& eventTable) {
+					hookId = ++m_lastHookId;
+					eventTable.AddPreHook(functionIndex, PreHook(hookId, preHook, hookOptions, std::make_shared<HookStats>()));
+					return true;
+				});
+			}
+			else
+			{
+				Console.Warning("Warning: Failed to hook function at index \"" + std::to_string(functionIndex) + "\"!");
+			}
+		}
+
+		return hookId;
+	}
+
+	uint32_t EventsComponent::HookEventPost(const std::string& functionName, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions)
+	{
+		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+
+		if (foundFunction)
+		{
+			return HookEventPost(foundFunction->ObjectInternalInteger, postHook, hookOptions);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to hook function \"" + functionName + "\"!");
+		}
+
+		return 0;
+	}
+
+	uint32_t EventsComponent::HookEventPost(uint64_t functionIndex, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions)
+	{
+		uint32_t hookId = 0;
+
+		if (UObject::GObjObjects() && (functionIndex < UObject::GObjObjects()->size()))
+		{
+			UObject* foundFunction = UObject::GObjObjects()->at(functionIndex);
+
+			if (foundFunction && foundFunction->IsA<UFunction>())
+			{
+				ModifyTable([&](EventTable& eventTable) {
+					hookId = ++m_lastHookId;
+					eventTable.AddPostHook(functionIndex, PostHook(hookId, postHook, hookOptions, std::make_shared<HookStats>()));
+					return true;
+				});
+			}
+			else
+			{
+				Console.Warning("Warning: Failed to hook function at index \"" + std::to_string(functionIndex) + "\"!");
+			}
+		}
+
+		return hookId;
+	}
+
+	uint32_t EventsComponent::HookEventAsync(const std::string& functionName, const Delegate<void(const AsyncEvent&)>& asyncHook, const HookOptions& hookOptions)
+	{
+		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+
+		if (foundFunction)
+		{
+			return HookEventAsync(foundFunction->ObjectInternalInteger, asyncHook, hookOptions);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to hook function \"" + functionName + "\"!");
+		}
+
+		return 0;
+	}
+
+	uint32_t EventsComponent::HookEventAsync(uint64_t functionIndex, const Delegate<void(const AsyncEvent&)>& asyncHook, const HookOptions& hookOptions)
+	{
+		if (!m_asyncPool.IsRunning())
+		{
+			m_asyncPool.Start(ASYNC_HOOK_THREADS, ASYNC_HOOK_QUEUE_SIZE); // Does nothing if another thread started it first.
+		}
+
+		// Stored on the heap once here, so each queued callback only has to copy a pointer to it.
+		std::shared_ptr<Delegate<void(const AsyncEvent&)>> sharedHook = std::make_shared<Delegate<void(const AsyncEvent&)>>(asyncHook);
+		return HookEventPost(functionIndex, [sharedHook](const PostEvent& event) { DispatchAsync(sharedHook, event); }, hookOptions);
+	}
+
+	uint64_t EventsComponent::GetAsyncQueued()
+	{
+		return m_asyncQueued.load(std::memory_order_relaxed);
+	}
+
+	uint64_t EventsComponent::GetAsyncFallbacks()
+	{
+		return m_asyncFallbacks.load(std::memory_order_relaxed);
+	}
+
+	const BufferPool& EventsComponent::GetAsyncBuffers()
+	{
+		return m_asyncBuffers;
+	}
+
+	uint32_t EventsComponent::HookEventsPre(const std::string& pattern, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions)
+	{
+		PatternHook patternHook(pattern, nullptr, hookOptions);
+		patternHook.PreCallback = preHook;
+		return AddPatternHook(patternHook);
+	}
+
+	uint32_t EventsComponent::HookEventsPost(const std::string& pattern, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions)
+	{
+		PatternHook patternHook(pattern, nullptr, hookOptions);
+		patternHook.PostCallback = postHook;
+		return AddPatternHook(patternHook);
+	}
+
+	uint32_t EventsComponent::HookClassPre(const std::string& className, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions)
+	{
+		UClass* foundClass = Instances.FindStaticClass(className);
+
+		if (foundClass)
+		{
+			return HookClassPre(foundClass, preHook, hookOptions);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to hook class \"" + className + "\"!");
+		}
+
+		return 0;
+	}
+
+	uint32_t EventsComponent::HookClassPre(class UClass* uClass, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions)
+	{
+		if (uClass)
+		{
+			PatternHook patternHook("", uClass, hookOptions);
+			patternHook.PreCallback = preHook;
+			return AddPatternHook(patternHook);
+		}
+
+		return 0;
+	}
+
+	uint32_t EventsComponent::HookClassPost(const std::string& className, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions)
+	{
+		UClass* foundClass = Instances.FindStaticClass(className);
+
+		if (foundClass)
+		{
+			return HookClassPost(foundClass, postHook, hookOptions);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to hook class \"" + className + "\"!");
+		}
+
+		return 0;
+	}
+
+	uint32_t EventsComponent::HookClassPost(class UClass* uClass, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions)
+	{
+		if (uClass)
+		{
+			PatternHook patternHook("", uClass, hookOptions);
+			patternHook.PostCallback = postHook;
+			return AddPatternHook(patternHook);
+		}
+
+		return 0;
+	}
+
+	void EventsComponent::ResolvePatternHooks()
+	{
+		if (UObject::GObjObjects() && (UObject::GObjObjects()->size() > INSTANCES_INTERATE_OFFSET))
+		{
+			std::lock_guard<std::mutex> hookLock(m_hookMutex);
+
+			if (m_patternHooks.empty())
+			{
+				m_resolvedSlots.clear(); // Nothing is bound, "AddPatternHook" resolves every slot again once a hook is added.
+				m_resolvedSlots.shrink_to_fit();
+				m_resolveDiffPosition = 0;
+				return;
+			}
+
+			std::vector<PatternMatch> patternMatches;
+			std::vector<uint64_t> staleFunctions;
+			DiffResolvedSlots(EVENTS_RESOLVE_DIFF_BUDGET, patternMatches, staleFunctions);
+
+			if (!patternMatches.empty() || !staleFunctions.empty()) // The published table is only copied if something actually changed, which is rare outside of loading screens.
+			{
+				PublishTable([&](EventTable& eventTable) {
+					ApplyResolved(eventTable, patternMatches, staleFunctions);
+					return true;
+				});
+			}
+		}
+	}
+
+	bool EventsComponent::UnhookEvent(uint32_t hookId)
+	{
+		if (hookId)
+		{
+			return ModifyTable([&](EventTable& eventTable) {
+				std::erase_if(m_patternHooks, [&](const PatternHook& patternHook) { return (patternHook.Id == hookId); });
+				return eventTable.RemoveHook(hookId);
+			});
+		}
+
+		return false;
+	}
+
+	size_t EventsComponent::UnhookEvents(const std::string& functionName)
+	{
+		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+
+		if (foundFunction)
+		{
+			return UnhookEvents(foundFunction->ObjectInternalInteger);
+		}
+		else
+		{
+			Console.Warning("Warning: Failed to unhook function \"" + functionName + "\"!");
+		}
+
+		return 0;
+	}
+
+	size_t EventsComponent::UnhookEvents(uint64_t functionIndex)
+	{
+		size_t hooksRemoved = 0;
+
+		ModifyTable([&](EventTable& eventTable) {
+			hooksRemoved = eventTable.RemoveHooks(functionIndex);
+			return (hooksRemoved > 0);
+		});
+
+		return hooksRemoved;
+	}
+
+	void EventsComponent::ProfileCommand(const std::string& arguments)
+	{
+		std::vector<std::string> splitArguments = Format::Split(arguments, ' ');
+		std::string action = (splitArguments.empty() ? "" : Format::ToLower(splitArguments[0]));
+
+		if (action == "start")
+		{
+#ifdef EVENT_PROFILER
+			EventProfiler::SetEnabled(true);
+			Console.Notify(GetNameFormatted() + "Event profiling started.");
+#else
+			Console.Warning(GetNameFormatted() + "Warning: The event profiler was compiled out, define \"EVENT_PROFILER\" to use it!");
+#endif
+		}
+		else if (action == "stop")
+		{
+			EventProfiler::SetEnabled(false);
+			Console.Notify(GetNameFormatted() + "Event profiling stopped.");
+		}
+		else if (action == "reset")
+		{
+			EventProfiler::Reset();
+			Console.Notify(GetNameFormatted() + "Event profiling data cleared.");
+		}
+		else if (action == "print")
+		{
+			size_t count = 10;
+
+			if ((splitArguments.size() > 1) && Format::IsStringDecimal(splitArguments[1]))
+			{
+				count = static_cast<size_t>(std::stoull(splitArguments[1]));
+			}
+
+			PrintProfile(count);
+		}
+		else
+		{
+			Console.Warning(GetNameFormatted() + "Warning: Unknown argument \"" + action + "\", expected \"start\", \"stop\", \"reset\", or \"print [count]\"!");
+		}
+	}
+
+	void EventsComponent::PrintProfile(size_t count) const
+	{
+		std::vector<FunctionProfile> functionProfiles = EventProfiler::GetFunctions();
+		std::vector<HookProfile> hookProfiles = EventProfiler::GetHooks();
+
+		if (functionProfiles.empty() && hookProfiles.empty())
+		{
+			Console.Warning(GetNameFormatted() + "Warning: No profiling data recorded, use \"events_profile start\" first!");
+			return;
+		}
+
+		Console.Write(GetNameFormatted() + "Most expensive hooked functions:");
+
+		for (size_t i = 0; (i < functionProfiles.size()) && (i < count); i++)
+		{
+			const FunctionProfile& functionProfile = functionProfiles[i];
+			UObject* function = (UObject::GObjObjects() && (functionProfile.FunctionIndex < UObject::GObjObjects()->size()) ? UObject::GObjObjects()->at(functionProfile.FunctionIndex) : nullptr);
+			Console.Write("#" + std::to_string(i + 1) + " " + (function ? function->GetFullName() : ("Index " + std::to_string(functionProfile.FunctionIndex))) + " (Total: " + FormatTime(functionProfile.GetTotalTime()) + ")");
+
+			if (functionProfile.PreHooks.Calls > 0)
+			{
+				Console.Write("    Pre: " + FormatProfile(functionProfile.PreHooks));
+			}
+
+			if (functionProfile.PostHooks.Calls > 0)
+			{
+				Console.Write("    Post: " + FormatProfile(functionProfile.PostHooks));
+			}
+		}
+
+		Console.Write(GetNameFormatted() + "Most expensive callbacks:");
+
+		for (size_t i = 0; (i < hookProfiles.size()) && (i < count); i++)
+		{
+			const HookProfile& hookProfile = hookProfiles[i];
+			UObject* function = (UObject::GObjObjects() && (hookProfile.FunctionIndex < UObject::GObjObjects()->size()) ? UObject::GObjObjects()->at(hookProfile.FunctionIndex) : nullptr);
+			Console.Write("#" + std::to_string(i + 1) + " Hook " + std::to_string(hookProfile.HookId) + (hookProfile.bPostHook ? " (Post) " : " (Pre) ") + (function ? function->GetFullName() : ("Index " + std::to_string(hookProfile.FunctionIndex))));
+			Console.Write("    " + FormatProfile(hookProfile.Sample));
+		}
+	}
+
+	void EventsComponent::CensusCommand(const std::string& arguments)
+	{
+		std::vector<std::string> splitArguments = Format::Split(arguments, ' ');
+		std::string action = (splitArguments.empty() ? "" : Format::ToLower(splitArguments[0]));
+
+		if (action == "start")
+		{
+			uint32_t sampleRate = 1;
+
+			if ((splitArguments.size() > 1) && Format::IsStringDecimal(splitArguments[1]))
+			{
+				sampleRate = static_cast<uint32_t>(std::stoul(splitArguments[1]));
+			}
+
+			EventCensus::Start(sampleRate);
+			Console.Notify(GetNameFormatted() + "Event census started, counting 1 in " + std::to_string(EventCensus::GetSampleRate()) + " call(s).");
+		}
+		else if (action == "stop")
+		{
+			EventCensus::Stop();
+			Console.Notify(GetNameFormatted() + "Event census stopped.");
+		}
+		else if (action == "reset")
+		{
+			EventCensus::Reset();
+			Console.Notify(GetNameFormatted() + "Event census data cleared.");
+		}
+		else if (action == "print")
+		{
+			size_t count = 20;
+
+			if ((splitArguments.size() > 1) && Format::IsStringDecimal(splitArguments[1]))
+			{
+				count = static_cast<size_t>(std::stoull(splitArguments[1]));
+			}
+
+			PrintCensus(count);
+		}
+		else
+		{
+			Console.Warning(GetNameFormatted() + "Warning: Unknown argument \"" + action + "\", expected \"start [sample rate]\", \"stop\", \"reset\", or \"print [count]\"!");
+		}
+	}
+
+	void EventsComponent::PrintCensus(size_t count) const
+	{
+		std::vector<CensusEntry> functionEntries = EventCensus::GetFunctions();
+		std::vector<CensusEntry> classEntries = EventCensus::GetClasses();
+		uint64_t sampleRate = EventCensus::GetSampleRate();
+
+		if (functionEntries.empty())
+		{
+			Console.Warning(GetNameFormatted() + "Warning: No census data recorded, use \"events_census start\" first!");
+			return;
+		}
+
+		uint64_t totalCalls = 0;
+
+		for (const CensusEntry& censusEntry : functionEntries)
+		{
+			totalCalls += censusEntry.Count;
+		}
+
+		Console.Write(GetNameFormatted() + "Most called functions (" + std::to_string(totalCalls * sampleRate) + " estimated call(s), sampling 1 in " + std::to_string(sampleRate) + "):");
+
+		for (size_t i = 0; (i < functionEntries.size()) && (i < count); i++)
+		{
+			const CensusEntry& censusEntry = functionEntries[i];
+			UObject* function = (UObject::GObjObjects() && (censusEntry.ObjectIndex < UObject::GObjObjects()->size()) ? UObject::GObjObjects()->at(censusEntry.ObjectIndex) : nullptr);
+			std::string hookedStr = (IsPreHooked(censusEntry.ObjectIndex) || IsPostHooked(censusEntry.ObjectIndex)) ? " [Hooked]" : (IsBlacklisted(censusEntry.ObjectIndex) ? " [Blacklisted]" : "");
+			Console.Write("#" + std::to_string(i + 1) + " " + (function ? function->GetFullName() : ("Index " + std::to_string(censusEntry.ObjectIndex))) + hookedStr + " (Calls: " + std::to_string(censusEntry.Count * sampleRate) + ", " + Format::Precision((static_cast<float>(censusEntry.Count) / static_cast<float>(totalCalls)) * 100.0f, 2) + "%)");
+		}
+
+		Console.Write(GetNameFormatted() + "Most active caller classes:");
+
+		for (size_t i = 0; (i < classEntries.size()) && (i < count); i++)
+		{
+			const CensusEntry& censusEntry = classEntries[i];
+			UObject* uClass = (UObject::GObjObjects() && (censusEntry.ObjectIndex < UObject::GObjObjects()->size()) ? UObject::GObjObjects()->at(censusEntry.ObjectIndex) : nullptr);
+			Console.Write("#" + std::to_string(i + 1) + " " + (uClass ? uClass->GetFullName() : ("Index " + std::to_string(censusEntry.ObjectIndex))) + " (Calls: " + std::to_string(censusEntry.Count * sampleRate) + ", " + Format::Precision((static_cast<float>(censusEntry.Count) / static_cast<float>(totalCalls)) * 100.0f, 2) + "%)");
+		}
+	}
+
+	void EventsComponent::TraceCommand(const std::string& arguments)
+	{
+		std::vector<std::string> splitArguments = Format::Split(arguments, ' ');
+		std::string action = (splitArguments.empty() ? "" : Format::ToLower(splitArguments[0]));
+		std::filesystem::path filePath = ((splitArguments.size() > 1) ? std::filesystem::path(splitArguments[1]) : (std::filesystem::current_path() / "CodeRed.trace"));
+
+		if (action == "start")
+		{
+			if (EventRecorder::Start(filePath))
+			{
+				Console.Notify(GetNameFormatted() + "Recording events to \"" + filePath.string() + "\".");
+			}
+			else
+			{
+				Console.Warning(GetNameFormatted() + "Warning: Failed to start recording to \"" + filePath.string() + "\", a recording might already be running!");
+			}
+		}
+		else if (action == "stop")
+		{
+			uint64_t droppedRecords = EventRecorder::GetDroppedCount();
+			uint64_t recordsWritten = EventRecorder::Stop();
+			Console.Notify(GetNameFormatted() + "Recording stopped, " + std::to_string(recordsWritten) + " event(s) written and " + std::to_string(droppedRecords) + " dropped.");
+		}
+		else if (action == "replay")
+		{
+			TraceFilter traceFilter;
+
+			if (splitArguments.size() > 2)
+			{
+				// Full names contain spaces, so everything after the file path is the function name.
+				std::string functionName = arguments.substr(arguments.find(splitArguments[2], splitArguments[0].size() + splitArguments[1].size()));
+				UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+
+				if (!foundFunction)
+				{
+					Console.Warning(GetNameFormatted() + "Warning: Failed to find function \"" + functionName + "\"!");
+					return;
+				}
+
+				traceFilter.FunctionIndexes.push_back(foundFunction->ObjectInternalInteger);
+			}
+
+			ReplayTrace(filePath, traceFilter);
+		}
+		else
+		{
+			Console.Warning(GetNameFormatted() + "Warning: Unknown argument \"" + action + "\", expected \"start [file]\", \"stop\", or \"replay [file] [function]\"!");
+		}
+	}
+
+	void EventsComponent::ReplayTrace(const std::filesystem::path& filePath, const TraceFilter& traceFilter) const
+	{
+		std::vector<EventRecord> eventRecords;
+
+		if (!EventRecorder::ReadTrace(filePath, eventRecords, traceFilter))
+		{
+			Console.Warning(GetNameFormatted() + "Warning: Failed to read trace file \"" + filePath.string() + "\"!");
+			return;
+		}
+
+		std::stable_sort(eventRecords.begin(), eventRecords.end(), [](const EventRecord& a, const EventRecord& b) { return (a.Timestamp < b.Timestamp); }); // Each thread is drained separately, so records are only ordered per thread.
+
+		size_t unresolvedEvents = 0;
+		size_t hookedEvents = 0;
+		size_t blacklistedEvents = 0;
+		std::vector<uint8_t> paramsBuffer;
+		uint64_t replayStart = EventProfiler::GetTimestamp();
+
+		for (const EventRecord& eventRecord : eventRecords)
+		{
+			UObject* object = (UObject::GObjObjects() && (eventRecord.FunctionIndex < UObject::GObjObjects()->size()) ? UObject::GObjObjects()->at(eventRecord.FunctionIndex) : nullptr);
+
+			if (object && object->IsA<UFunction>())
+			{
+				UFunction* function = static_cast<UFunction*>(object);
+				EventTypes eventType = static_cast<EventTypes>(eventRecord.EventType);
+				size_t paramsSize = std::max<size_t>(function->ParamsSize, eventRecord.ParamsSize);
+
+				if (IsHooked(function, eventType))
+				{
+					hookedEvents++;
+				}
+
+				if (IsBlacklisted(function))
+				{
+					blacklistedEvents++;
 				}
-			}
-		}
-#endif
 
-		if (AreDetoursAttached())
-		{
-			m_hooksSafe = true;
-			m_blacklistSafe = true;
+				// Hooks can write to the params, so they're cleared again for every event.
+				paramsBuffer.assign(paramsSize, 0);
+				DispatchEvent(nullptr, function, (paramsBuffer.empty() ? nullptr : paramsBuffer.data()), nullptr, eventType, []() {});
+			}
+			else
+			{
+				unresolvedEvents++;
+			}
 		}
 
-		return AreDetoursAttached();
+		uint64_t replayTime = (EventProfiler::GetTimestamp() - replayStart);
+		Console.Write(GetNameFormatted() + "Replayed " + std::to_string(eventRecords.size()) + " event(s) in " + FormatTime(replayTime) + " (" + FormatTime(eventRecords.empty() ? 0 : (replayTime / eventRecords.size())) + " per event).");
+		Console.Write(GetNameFormatted() + std::to_string(hookedEvents) + " hooked, " + std::to_string(blacklistedEvents) + " blacklisted, " + std::to_string(unresolvedEvents) + " unresolved.");
 	}
 
-	void EventsComponent::DetachDetours()
+	void EventsComponent::PrintHooks() const
 	{
-		m_processEvent.Detach();
-		m_processInternal.Detach();
-		m_hooksSafe = false;
-		m_blacklistSafe = false;
-	}
+		EpochGuard epochGuard;
+		const EventTable* eventTable = m_eventTable.load(std::memory_order_acquire);
 
-	void EventsComponent::ProcessEventHook(class UObject* caller, class UFunction* function, void* params, void* result)
-	{
-#ifdef DETOUR_PROCEVENT
-		if (m_processEvent.IsAttached())
+		if (!eventTable || ((eventTable->GetPreHookedCount() == 0) && (eventTable->GetPostHookedCount() == 0)))
 		{
-			if (CanProcessHook(caller, function, EventTypes::ProcessEvent))
-			{
-				EventGuard eventGuard(caller, function);
+			Console.Warning(GetNameFormatted() + "Warning: No functions are currently hooked!");
+			return;
+		}
 
-				if (eventGuard.IsFirst())
-				{
-					ProcessResults processResult = ProcessBefore(caller, function, params, result, EventTypes::ProcessEvent);
+		for (size_t functionIndex = 0; functionIndex < eventTable->GetSize(); functionIndex++)
+		{
+			const EventHooks* eventHooks = eventTable->GetHooks(functionIndex);
 
-					if (CanCallHook(function, processResult, EventTypes::ProcessEvent))
-					{
-						m_processEvent.Call<HookTypes::ProcessEvent>()(caller, function, params, result);
-					}
-#ifdef TRACE_BLACKLISTS
-					else if (function)
-					{
-						Console.Error("[Events Component] (ProcessEventHook) Don't want to call function \"" + function->GetFullName() + "\"!");
-					}
-#endif
+			if (eventHooks)
+			{
+				UObject* function = (UObject::GObjObjects() && (functionIndex < UObject::GObjObjects()->size()) ? UObject::GObjObjects()->at(functionIndex) : nullptr);
+				Console.Write(GetNameFormatted() + (function ? function->GetFullName() : ("Index " + std::to_string(functionIndex))));
 
-					ProcessAfter(caller, function, params, result, EventTypes::ProcessEvent);
-					return;
-				}
-#ifdef TRACE_GUARDS
-				else if (function)
+				for (const PreHook& preHook : eventHooks->PreHooks)
 				{
-					Console.Error("[Events Component] (ProcessEventHook) Guard isn't safe for \"" + function->GetFullName() + "\"!");
+					Console.Write("    Hook " + std::to_string(preHook.Id) + " (Pre) Filter: " + preHook.Options.GetFilterName() + ", Limit: " + preHook.Options.GetLimitName() + ", Calls: " + std::to_string(preHook.Stats->Calls.load()) + ", Skipped: " + std::to_string(preHook.Stats->Skipped.load()) + ", Limited: " + std::to_string(preHook.Stats->Limited.load()));
 				}
-#endif
-			}
-			else if (IsBlacklisted(function))
-			{
-#ifdef TRACE_BLACKLISTS
-				if (function)
+
+				for (const PostHook& postHook : eventHooks->PostHooks)
 				{
-					Console.Error("[Events Component] (ProcessEventHook) Blacklist found for \"" + function->GetFullName() + "\"!");
+					Console.Write("    Hook " + std::to_string(postHook.Id) + " (Post) Filter: " + postHook.Options.GetFilterName() + ", Limit: " + postHook.Options.GetLimitName() + ", Calls: " + std::to_string(postHook.Stats->Calls.load()) + ", Skipped: " + std::to_string(postHook.Stats->Skipped.load()) + ", Limited: " + std::to_string(postHook.Stats->Limited.load()));
 				}
-#endif
-
-				return;
 			}
+		}
 
-			m_processEvent.Call<HookTypes::ProcessEvent>()(caller, function, params, result);
+		if (m_asyncPool.IsRunning())
+		{
+			Console.Write(GetNameFormatted() + "Async Hooks Queued: " + std::to_string(m_asyncQueued.load()) + ", Synchronous Fallbacks: " + std::to_string(m_asyncFallbacks.load()) + ", Pending: " + std::to_string(m_asyncPool.GetQueuedCount()) + ", Buffers Allocated: " + std::to_string(m_asyncBuffers.GetAllocations()) + ", Reused: " + std::to_string(m_asyncBuffers.GetReuses()));
 		}
-#endif
 	}
 
-	void EventsComponent::ProcessInternalHook(class UObject* caller, struct FFrame& frame, void* result)
+	void EventsComponent::DetoursCommand(const std::string& arguments)
 	{
-#ifdef DETOUR_PROCINTERNAL
-		if (m_processInternal.IsAttached())
+		std::vector<std::string> splitArguments = Format::Split(arguments, ' ');
+		std::string action = (splitArguments.empty() ? "print" : Format::ToLower(splitArguments[0]));
+
+		if (action == "print")
 		{
-			UFunction* function = static_cast<UFunction*>(frame.Node);
-			void* params = frame.Locals;
+			PrintDetours();
+		}
+		else if (action == "reset")
+		{
+			FunctionHook::ResetAllTelemetry();
+			Console.Notify(GetNameFormatted() + "Detour call counters cleared.");
+		}
+		else
+		{
+			Console.Warning(GetNameFormatted() + "Warning: Unknown argument \"" + action + "\", expected \"print\" or \"reset\"!");
+		}
+	}
 
-			if (CanProcessHook(caller, function, EventTypes::ProcessInternal))
-			{
-				EventGuard eventGuard(caller, function);
+	void EventsComponent::PrintDetours() const
+	{
+		size_t hookCount = 0;
 
-				if (eventGuard.IsFirst())
-				{
-					ProcessResults processResult = ProcessBefore(caller, function, params, result, EventTypes::ProcessInternal);
+		FunctionHook::ForEachHook([&](const FunctionHook& functionHook) {
+			if (!functionHook.GetTarget() && functionHook.GetName().empty())
+			{
+				return; // Never used, nothing worth printing.
+			}
 
-					if (CanCallHook(function, processResult, EventTypes::ProcessInternal))
-					{
-						m_processInternal.Call<HookTypes::ProcessInternal>()(caller, frame, result);
-					}
-#ifdef TRACE_BLACKLISTS
-					else if (function)
-					{
-						Console.Error("[Events Component] (ProcessInternalHook) Cannot call function for \"" + function->GetFullName() + "\"!");
-					}
-#endif
+			const HookTelemetry& hookTelemetry = functionHook.GetTelemetry();
+			uint64_t hits = hookTelemetry.GetHits();
+			uint64_t originalCalls = hookTelemetry.GetOriginalCalls();
+			std::string stateStr = (functionHook.IsEnabled() ? "Enabled" : (functionHook.IsAttached() ? "Disabled" : "Detached"));
 
-					ProcessAfter(caller, function, params, result, EventTypes::ProcessInternal);
-					return;
-				}
-#ifdef TRACE_GUARDS
-				else if (function)
-				{
-					Console.Error("[Events Component] (ProcessInternalHook) Guard isn't safe for \"" + function->GetFullName() + "\"!");
-				}
-#endif
-			}
-			else if (IsBlacklisted(function))
+			if (functionHook.IsEnabled() && (hits == 0))
 			{
-#ifdef TRACE_BLACKLISTS
-				if (function)
-				{
-					Console.Error("[Events Component] (ProcessInternalHook) Blacklist found for \"" + function->GetFullName() + "\"!");
-				}
-#endif
-
-				return;
+				stateStr += ", Never Hit"; // Most likely the wrong address or vtable index.
 			}
 
-			m_processInternal.Call<HookTypes::ProcessInternal>()(caller, frame, result);
+			std::string detourStr = (functionHook.GetName().empty() ? "Unnamed" : functionHook.GetName());
+			detourStr += " (" + std::string((functionHook.GetMode() == HookModes::VTable) ? "VTable" : "Inline") + ", " + Format::ToHex(functionHook.GetTarget()) + ") " + stateStr;
+			detourStr += ", Hits: " + std::to_string(hits);
+			detourStr += ", Original Calls: " + std::to_string(originalCalls);
+			detourStr += ", Attach: " + FormatTime(hookTelemetry.AttachTime.load());
+			detourStr += ", Enable: " + FormatTime(hookTelemetry.EnableTime.load());
+			Console.Write(GetNameFormatted() + detourStr);
+			hookCount++;
+		});
+
+		if (hookCount == 0)
+		{
+			Console.Warning(GetNameFormatted() + "Warning: No detours have been attached!");
 		}
-#endif
 	}
 
-	bool EventsComponent::IsBlacklisted(class UFunction* function)
+	std::string EventsComponent::FormatProfile(const ProfileSample& profileSample)
 	{
-		if (function)
+		std::string profileStr = "Calls: " + std::to_string(profileSample.Calls);
+		profileStr += ", Total: " + FormatTime(profileSample.TotalTime);
+		profileStr += ", Average: " + FormatTime(profileSample.GetAverageTime());
+		profileStr += ", Min: " + FormatTime((profileSample.Calls > 0) ? profileSample.MinTime : 0);
+		profileStr += ", Max: " + FormatTime(profileSample.MaxTime);
+		profileStr += ", Histogram:";
+
+		for (size_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++)
 		{
-			return IsBlacklisted(function->ObjectInternalInteger);
+			if (profileSample.Histogram[i] > 0) // Empty buckets are skipped to keep the output short.
+			{
+				uint64_t bucketLimit = ProfileSample::GetBucketLimit(i);
+				profileStr += ((bucketLimit != UINT64_MAX) ? (" <" + FormatTime(bucketLimit)) : (" >=" + FormatTime(ProfileSample::GetBucketLimit(i - 1)))) + "=" + std::to_string(profileSample.Histogram[i]);
+			}
 		}
 
-		return false;
+		return profileStr;
 	}
 
-	bool EventsComponent::IsBlacklisted(uint64_t functionIndex)
+	std::string EventsComponent::FormatTime(uint64_t nanoseconds)
 	{
-		if (m_blacklistSafe)
+		if (nanoseconds >= 1000000)
+		{
+			return Format::Precision(static_cast<float>(nanoseconds) / 1000000.0f, 3) + "ms";
+		}
+		else if (nanoseconds >= 1000)
 		{
-			return (std::find(m_blacklisted.begin(), m_blacklisted.end(), functionIndex) != m_blacklisted.end());
+			return Format::Precision(static_cast<float>(nanoseconds) / 1000.0f, 3) + "us";
 		}
 
-		return false;
+		return std::to_string(nanoseconds) + "ns";
 	}
 
-	bool EventsComponent::IsPreHooked(class UFunction* function)
+	size_t EventsComponent::SetBlacklisted(const std::function<bool(class UFunction*)>& predicate, bool bBlacklisted)
 	{
-		if (function)
+		size_t functionsFound = 0;
+
+		if (UObject::GObjObjects())
 		{
-			return IsPreHooked(function->ObjectInternalInteger);
+			m_blacklisted.Reserve(UObject::GObjObjects()->size()); // Grow once up front, instead of per function found.
+
+			for (size_t i = 0; i < (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i++)
+			{
+				UObject* uObject = UObject::GObjObjects()->at(i);
+
+				if (uObject && uObject->IsA<UFunction>())
+				{
+					UFunction* function = static_cast<UFunction*>(uObject);
+
+					if (predicate(function))
+					{
+						if (bBlacklisted)
+						{
+							m_blacklisted.Set(function->ObjectInternalInteger);
+						}
+						else
+						{
+							m_blacklisted.Reset(function->ObjectInternalInteger);
+						}
+
+						functionsFound++;
+					}
+				}
+			}
 		}
 
-		return false;
+		return functionsFound;
 	}
 
-	bool EventsComponent::IsPreHooked(uint64_t functionIndex)
+	bool EventsComponent::CanCallHook(ProcessResults processResult, EventTypes eventType)
 	{
-		if (m_hooksSafe)
+		if (eventType != EventTypes::CallFunction) // CallFunction is limited to what you can hook, including its parameters, so this isn't supported fully for now.
 		{
-			return m_preHooks.contains(functionIndex);
+			return ((processResult != ProcessResults::Blacklist) && (processResult != ProcessResults::CallbackBlacklist)); // Already includes the blacklist test done in "ProcessBefore".
 		}
 
-		return false;
+		return true;
 	}
 
-	bool EventsComponent::IsPostHooked(class UFunction* function)
+	bool EventsComponent::ModifyTable(const std::function<bool(EventTable&)>& modifier)
 	{
-		if (function)
-		{
-			return IsPostHooked(function->ObjectInternalInteger);
-		}
-
-		return false;
+		std::lock_guard<std::mutex> hookLock(m_hookMutex); // Writers are serialized, readers never take this lock.
+		return PublishTable(modifier);
 	}
 
-	bool EventsComponent::IsPostHooked(uint64_t functionIndex)
+	bool EventsComponent::PublishTable(const std::function<bool(EventTable&)>& modifier)
 	{
-		if (m_hooksSafe)
+		const EventTable* oldTable = m_eventTable.load(std::memory_order_acquire);
+		EventTable* newTable = (oldTable ? new EventTable(*oldTable) : new EventTable());
+
+		if (modifier(*newTable))
 		{
-			return m_postHooks.contains(functionIndex);
+			m_eventTable.store(newTable, std::memory_order_seq_cst);
+			SyncHooked(oldTable, newTable); // After publishing, so a reader that sees a new bit also finds the new snapshot.
+			EpochGuard::Retire(oldTable); // Freed once every reader that could still see the old snapshot has left.
+			return true;
 		}
 
+		delete newTable;
 		return false;
 	}
 
-	void EventsComponent::BlacklistEvent(const std::string& function)
+	uint32_t EventsComponent::AddPatternHook(const PatternHook& patternHook)
 	{
-		UFunction* foundFunction = Instances.FindStaticFunction(function);
+		uint32_t hookId = 0;
 
-		if (foundFunction)
+		if (UObject::GObjObjects() && (UObject::GObjObjects()->size() > INSTANCES_INTERATE_OFFSET))
 		{
-			bool isBlacklisted = IsBlacklisted(foundFunction);
+			std::lock_guard<std::mutex> hookLock(m_hookMutex);
+			std::vector<PatternMatch> patternMatches;
+			std::vector<uint64_t> staleFunctions;
 
-			if (!isBlacklisted)
+			// Slots loaded since the last tick are resolved against the existing hooks first, after that every slot only has to be checked against the new hook.
+			DiffResolvedSlots(0, patternMatches, staleFunctions);
+			size_t existingMatches = patternMatches.size();
+
+			hookId = ++m_lastHookId;
+			m_patternHooks.push_back(patternHook);
+			m_patternHooks.back().Id = hookId;
+
+			for (size_t i = 0; i < m_resolvedSlots.size(); i++)
 			{
-				m_blacklistSafe = false;
-				m_blacklisted.push_back(foundFunction->ObjectInternalInteger);
-				std::sort(m_blacklisted.begin(), m_blacklisted.end());
-				m_blacklistSafe = true;
+				ResolveObject(i, (m_patternHooks.size() - 1), patternMatches);
+			}
+
+			size_t functionsFound = (patternMatches.size() - existingMatches);
+
+			if (!patternMatches.empty() || !staleFunctions.empty())
+			{
+				PublishTable([&](EventTable& eventTable) {
+					ApplyResolved(eventTable, patternMatches, staleFunctions);
+					return true;
+				});
+			}
+
+			if (functionsFound == 0)
+			{
+				Console.Warning("Warning: No functions found for pattern hook \"" + (patternHook.OwnerClass ? patternHook.OwnerClass->GetFullName() : patternHook.Pattern) + "\" yet!");
 			}
 		}
-		else
-		{
-			Console.Warning("Warning: Failed to blacklist function \"" + function + "\"!");
-		}
+
+		return hookId;
 	}
 
-	void EventsComponent::WhitelistEvent(const std::string& functionName)
+	void EventsComponent::DiffResolvedSlots(size_t diffBudget, std::vector<PatternMatch>& patternMatches, std::vector<uint64_t>& staleFunctions)
 	{
-		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+		size_t objectCount = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET);
+		size_t resolvedCount = std::min(m_resolvedSlots.size(), objectCount);
+		const EventTable* eventTable = m_eventTable.load(std::memory_order_acquire); // Can't be retired while "m_hookMutex" is held, so no "EpochGuard" is needed.
 
-		if (foundFunction)
+		if ((diffBudget > 0) && (resolvedCount > 0))
 		{
-			m_hooksSafe = false;
-			auto blackIt = std::find(m_blacklisted.begin(), m_blacklisted.end(), foundFunction->ObjectInternalInteger);
+			// Garbage collected functions leave their slot to be reused, so whatever was bound to the old object is unbound and the new object is resolved in its place.
+			size_t diffCount = std::min(diffBudget, resolvedCount);
+			size_t diffPosition = ((m_resolveDiffPosition < resolvedCount) ? m_resolveDiffPosition : 0);
 
-			if (blackIt != m_blacklisted.end())
+			for (size_t i = 0; i < diffCount; i++)
 			{
-				m_blacklisted.erase(blackIt);
-				std::sort(m_blacklisted.begin(), m_blacklisted.end());
+				UObject* uObject = UObject::GObjObjects()->at(diffPosition);
+
+				if (uObject != m_resolvedSlots[diffPosition])
+				{
+					if (HasPatternHooks(eventTable, diffPosition)) // A functions "ObjectInternalInteger" is its slot, so the old functions hooks are found without touching it.
+					{
+						staleFunctions.push_back(diffPosition);
+					}
+
+					m_resolvedSlots[diffPosition] = uObject;
+					ResolveObject(diffPosition, 0, patternMatches);
+				}
+
+				diffPosition = (((diffPosition + 1) < resolvedCount) ? (diffPosition + 1) : 0);
 			}
 
-			m_hooksSafe = true;
+			m_resolveDiffPosition = diffPosition;
 		}
-		else
+
+		if (objectCount > m_resolvedSlots.size()) // Nothing new was loaded, which is the case almost every tick.
 		{
-			Console.Warning("Warning: Failed to whitelist function \"" + functionName + "\"!");
+			size_t firstNew = m_resolvedSlots.size();
+			m_resolvedSlots.resize(objectCount, nullptr);
+
+			for (size_t i = firstNew; i < objectCount; i++)
+			{
+				m_resolvedSlots[i] = UObject::GObjObjects()->at(i);
+				ResolveObject(i, 0, patternMatches);
+			}
 		}
 	}
 
-	void EventsComponent::HookEventPre(const std::string& functionName, const std::function<void(PreEvent&)>& preHook)
+	void EventsComponent::ResolveObject(size_t objectIndex, size_t firstHook, std::vector<PatternMatch>& patternMatches)
 	{
-		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
+		UObject* uObject = m_resolvedSlots[objectIndex];
 
-		if (foundFunction)
+		if ((firstHook < m_patternHooks.size()) && uObject && uObject->IsA<UFunction>())
 		{
-			HookEventPre(foundFunction->ObjectInternalInteger, preHook);
+			UFunction* function = static_cast<UFunction*>(uObject);
+			bool needsName = std::any_of((m_patternHooks.begin() + firstHook), m_patternHooks.end(), [](const PatternHook& patternHook) { return patternHook.NeedsName(); });
+			std::string functionName = (needsName ? function->GetFullName() : ""); // Only built once per function, no matter how many pattern hooks there are.
+
+			for (size_t i = firstHook; i < m_patternHooks.size(); i++)
+			{
+				if (m_patternHooks[i].Matches(function, functionName))
+				{
+					patternMatches.push_back(PatternMatch{ function, i });
+				}
+			}
 		}
-		else
+	}
+
+	bool EventsComponent::HasPatternHooks(const EventTable* eventTable, uint64_t functionIndex)
+	{
+		const EventHooks* eventHooks = (eventTable ? eventTable->GetHooks(functionIndex) : nullptr);
+
+		if (eventHooks)
 		{
-			Console.Warning("Warning: Failed to hook function \"" + functionName + "\"!");
+			auto isPatternHook = [](uint32_t hookId) { return std::any_of(m_patternHooks.begin(), m_patternHooks.end(), [&](const PatternHook& patternHook) { return (patternHook.Id == hookId); }); };
+			return (std::any_of(eventHooks->PreHooks.begin(), eventHooks->PreHooks.end(), [&](const PreHook& preHook) { return isPatternHook(preHook.Id); })
+				|| std::any_of(eventHooks->PostHooks.begin(), eventHooks->PostHooks.end(), [&](const PostHook& postHook) { return isPatternHook(postHook.Id); }));
 		}
+
+		return false;
 	}
 
-	void EventsComponent::HookEventPre(uint64_t functionIndex, const std::function<void(PreEvent&)>& preHook)
+	void EventsComponent::ApplyResolved(EventTable& eventTable, const std::vector<PatternMatch>& patternMatches, const std::vector<uint64_t>& staleFunctions)
 	{
-		if (UObject::GObjObjects() && (functionIndex < UObject::GObjObjects()->size()))
+		if (!staleFunctions.empty())
 		{
-			UObject* foundFunction = UObject::GObjObjects()->at(functionIndex);
+			std::vector<uint32_t> patternIds;
 
-			if (foundFunction && foundFunction->IsA<UFunction>())
+			for (const PatternHook& patternHook : m_patternHooks)
 			{
-				m_hooksSafe = false;
-				m_preHooks[functionIndex].push_back(preHook);
-				m_hooksSafe = true;
+				patternIds.push_back(patternHook.Id);
 			}
-			else
+
+			for (uint64_t functionIndex : staleFunctions)
 			{
-				Console.Warning("Warning: Failed to hook function at index \"" + std::to_string(functionIndex) + "\"!");
+				eventTable.RemoveHooks(functionIndex, patternIds); // Hooks added by name stay, they were bound to this index on purpose.
 			}
 		}
-	}
 
-	void EventsComponent::HookEventPost(const std::string& functionName, const std::function<void(const PostEvent&)>& postHook)
-	{
-		UFunction* foundFunction = Instances.FindStaticFunction(functionName);
-
-		if (foundFunction)
+		for (const PatternMatch& patternMatch : patternMatches)
 		{
-			HookEventPost(foundFunction->ObjectInternalInteger, postHook);
-		}
-		else
-		{
-			Console.Warning("Warning: Failed to hook function \"" + functionName + "\"!");
+			const PatternHook& patternHook = m_patternHooks[patternMatch.HookIndex];
+
+			if (patternHook.PreCallback)
+			{
+				eventTable.AddPreHook(patternMatch.Function->ObjectInternalInteger, PreHook(patternHook.Id, patternHook.PreCallback, patternHook.Options, patternHook.Stats));
+			}
+
+			if (patternHook.PostCallback)
+			{
+				eventTable.AddPostHook(patternMatch.Function->ObjectInternalInteger, PostHook(patternHook.Id, patternHook.PostCallback, patternHook.Options, patternHook.Stats));
+			}
 		}
 	}
 
-	void EventsComponent::HookEventPost(uint64_t functionIndex, const std::function<void(const PostEvent&)>& postHook)
+	void EventsComponent::SyncHooked(const EventTable* oldTable, const EventTable* newTable)
 	{
-		if (UObject::GObjObjects() && (functionIndex < UObject::GObjObjects()->size()))
+		size_t tableSize = std::max((oldTable ? oldTable->GetSize() : 0), (newTable ? newTable->GetSize() : 0));
+
+		for (size_t i = 0; i < tableSize; i++)
 		{
-			UObject* foundFunction = UObject::GObjObjects()->at(functionIndex);
+			bool bWasHooked = (oldTable && oldTable->IsHooked(i));
+			bool bIsHooked = (newTable && newTable->IsHooked(i));
 
-			if (foundFunction && foundFunction->IsA<UFunction>())
+			if (bIsHooked && !bWasHooked)
 			{
-				m_hooksSafe = false;
-				m_postHooks[functionIndex].push_back(postHook);
-				m_hooksSafe = true;
+				m_hooked.Set(i);
 			}
-			else
+			else if (bWasHooked && !bIsHooked)
 			{
-				Console.Warning("Warning: Failed to hook function at index \"" + std::to_string(functionIndex) + "\"!");
+				m_hooked.Reset(i); // A reader that still sees the bit finds no hooks in the new snapshot, and just calls the original function.
 			}
 		}
 	}
 
-	bool EventsComponent::CanCallHook(class UFunction* function, ProcessResults processResult, EventTypes eventType)
+	bool EventsComponent::IsHooked(class UFunction* function, EventTypes eventType)
 	{
-		if (eventType != EventTypes::CallFunction) // CallFunction is limited to what you can hook, including its parameters, so this isn't supported fully for now.
+		if ((eventType != EventTypes::Unknown) && function)
 		{
-			return ((processResult != ProcessResults::Blacklist) && (processResult != ProcessResults::CallbackBlacklist) && !IsBlacklisted(function));
+			return m_hooked.Test(function->ObjectInternalInteger); // Single bit test for unhooked functions, the snapshot itself is only loaded once this passes.
 		}
 
-		return true;
+		return false;
 	}
 
-	bool EventsComponent::CanProcessHook(class UObject* caller, class UFunction* function, EventTypes eventType)
+	const EventHooks* EventsComponent::FindHooks(class UFunction* function, EventTypes eventType)
 	{
 		if ((eventType != EventTypes::Unknown) && function)
 		{
-			return (IsPreHooked(function) || IsPostHooked(function));
+			const EventTable* eventTable = m_eventTable.load(std::memory_order_acquire);
+
+			if (eventTable)
+			{
+				return eventTable->GetHooks(function->ObjectInternalInteger);
+			}
 		}
 
-		return false;
+		return nullptr;
 	}
 
-	ProcessResults EventsComponent::ProcessBefore(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType)
+	template <bool bProfiled> ProcessResults EventsComponent::ProcessBefore(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const EventHooks* eventHooks)
 	{
 		ProcessResults processResult = ProcessResults::Should;
 
 		if (function)
 		{
-			if (IsPreHooked(function->ObjectInternalInteger))
+			if (eventHooks && !eventHooks->PreHooks.empty())
 			{
-				processResult = ProcessResults::ShouldCallback; // At least one callback was found.
-				PreEvent preEvent(caller, function, params, eventType);
+				std::optional<PreEvent> preEvent; // Only created once a callback passes its caller filter.
+#ifdef EVENT_PROFILER
+				bool profiling = (bProfiled && EventProfiler::IsEnabled()); // Read once, so toggling mid dispatch can't leave a half recorded call.
+#else
+				constexpr bool profiling = false; // Every profiling branch below is folded away.
+#endif
+				uint64_t functionStart = (profiling ? EventProfiler::GetTimestamp() : 0);
 
-				for (const auto& functionHook : m_preHooks[function->ObjectInternalInteger])
+				for (const PreHook& functionHook : eventHooks->PreHooks)
 				{
-					functionHook(preEvent);
+					if (!functionHook.Options.PassesFilter(caller))
+					{
+						functionHook.Stats->Skipped.fetch_add(1, std::memory_order_relaxed);
+						continue;
+					}
+					else if (functionHook.Options.IsLimited() && !functionHook.Options.PassesLimit(*functionHook.Stats))
+					{
+						functionHook.Stats->Limited.fetch_add(1, std::memory_order_relaxed);
+						continue;
+					}
+
+					if (!preEvent)
+					{
+						preEvent.emplace(caller, function, params, eventType);
+						processResult = ProcessResults::ShouldCallback; // At least one callback was found.
+					}
+
+					functionHook.Stats->Calls.fetch_add(1, std::memory_order_relaxed);
+
+					if (profiling)
+					{
+						uint64_t hookStart = EventProfiler::GetTimestamp();
+						functionHook.Callback(*preEvent);
+						EventProfiler::RecordHook(functionHook.Id, function->ObjectInternalInteger, false, (EventProfiler::GetTimestamp() - hookStart));
+					}
+					else
+					{
+						functionHook.Callback(*preEvent);
+					}
 
-					if (!preEvent.IsCallable() && (eventType != EventTypes::CallFunction)) // Can't blacklist from CallFunction or else it will crash, would need to hook "UObject::SkipFunction" and call that instead.
+					if (!preEvent->IsCallable() && (eventType != EventTypes::CallFunction)) // Can't blacklist from CallFunction or else it will crash, would need to hook "UObject::SkipFunction" and call that instead.
 					{
 #ifdef TRACE_BLACKLISTS
 						Console.Notify("[Events Component] (ProcessBefore) CallbackBlacklist!");
@@ -632,6 +2058,11 @@ namespace CodeRed
 						processResult = ProcessResults::CallbackBlacklist; // Callback was found, and it said we should blacklist it.
 					}
 				}
+
+				if (profiling && preEvent)
+				{
+					EventProfiler::RecordFunction(function->ObjectInternalInteger, false, (EventProfiler::GetTimestamp() - functionStart));
+				}
 			}
 
 			if ((processResult != ProcessResults::CallbackBlacklist) && (eventType != EventTypes::CallFunction)) // Save ourselves some function calls and checks, it's already blacklisted.
@@ -659,22 +2090,55 @@ namespace CodeRed
 		return processResult;
 	}
 
-	ProcessResults EventsComponent::ProcessAfter(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType)
+	template <bool bProfiled> ProcessResults EventsComponent::ProcessAfter(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const EventHooks* eventHooks)
 	{
 		ProcessResults processResult = ProcessResults::Should;
 
 		if (function)
 		{
-			if (IsPostHooked(function->ObjectInternalInteger))
+			if (eventHooks && !eventHooks->PostHooks.empty())
 			{
-				processResult = ProcessResults::ShouldCallback; // At least one callback was found.
-				PostEvent postEvent(caller, function, params, result, eventType);
+				std::optional<PostEvent> postEvent; // Only created once a callback passes its caller filter.
+#ifdef EVENT_PROFILER
+				bool profiling = (bProfiled && EventProfiler::IsEnabled());
+#else
+				constexpr bool profiling = false;
+#endif
+				uint64_t functionStart = (profiling ? EventProfiler::GetTimestamp() : 0);
 
-				for (const auto& functionHook : m_postHooks[function->ObjectInternalInteger])
+				for (const PostHook& functionHook : eventHooks->PostHooks)
 				{
-					functionHook(postEvent);
+					if (!functionHook.Options.PassesFilter(caller))
+					{
+						functionHook.Stats->Skipped.fetch_add(1, std::memory_order_relaxed);
+						continue;
+					}
+					else if (functionHook.Options.IsLimited() && !functionHook.Options.PassesLimit(*functionHook.Stats))
+					{
+						functionHook.Stats->Limited.fetch_add(1, std::memory_order_relaxed);
+						continue;
+					}
+
+					if (!postEvent)
+					{
+						postEvent.emplace(caller, function, params, result, eventType);
+						processResult = ProcessResults::ShouldCallback; // At least one callback was found.
+					}
+
+					functionHook.Stats->Calls.fetch_add(1, std::memory_order_relaxed);
+
+					if (profiling)
+					{
+						uint64_t hookStart = EventProfiler::GetTimestamp();
+						functionHook.Callback(*postEvent);
+						EventProfiler::RecordHook(functionHook.Id, function->ObjectInternalInteger, true, (EventProfiler::GetTimestamp() - hookStart));
+					}
+					else
+					{
+						functionHook.Callback(*postEvent);
+					}
 
-					if (!postEvent.IsCallable() && (eventType != EventTypes::CallFunction)) // Can't blacklist from CallFunction or else it will crash, would need to hook "UObject::SkipFunction" and call that instead.
+					if (!postEvent->IsCallable() && (eventType != EventTypes::CallFunction)) // Can't blacklist from CallFunction or else it will crash, would need to hook "UObject::SkipFunction" and call that instead.
 					{
 #ifdef TRACE_BLACKLISTS
 						Console.Notify("[Events Component] (ProcessAfter) CallbackBlacklist!");
@@ -683,25 +2147,9 @@ namespace CodeRed
 					}
 				}
 
-				if ((processResult != ProcessResults::CallbackBlacklist) && (eventType != EventTypes::CallFunction)) // Save ourselves some function calls and checks, it's already blacklisted.
+				if (profiling && postEvent)
 				{
-					if (IsBlacklisted(function->ObjectInternalInteger))
-					{
-						if (processResult == ProcessResults::ShouldCallback)
-						{
-#ifdef TRACE_BLACKLISTS
-							Console.Notify("[Events Component] (ProcessAfter) CallbackBlacklist!");
-#endif
-							processResult = ProcessResults::CallbackBlacklist;
-						}
-						else
-						{
-#ifdef TRACE_BLACKLISTS
-							Console.Notify("[Events Component] (ProcessAfter) Blacklist!)");
-#endif
-							processResult = ProcessResults::Blacklist;
-						}
-					}
+					EventProfiler::RecordFunction(function->ObjectInternalInteger, true, (EventProfiler::GetTimestamp() - functionStart));
 				}
 			}
 		}
@@ -709,5 +2157,9 @@ namespace CodeRed
 		return processResult;
 	}
 
+	// Defined here so the hot path stays out of the header, these are the only two versions that exist.
+	template void EventsComponent::DispatchEvent<true>(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const Delegate<void()>& callOriginal);
+	template void EventsComponent::DispatchEvent<false>(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const Delegate<void()>& callOriginal);
+
 	class EventsComponent Events;
 }
\ No newline at end of file
@@ -60,6 +60,43 @@ namespace CodeRed
 		PostEvent& operator=(const PostEvent& postEvent);
 	};
 
+	// Post event handed to async hooks on a worker thread, the params are a copy taken right after the function was processed.
+	// The caller and function are only safe to use as identifiers, the caller may already be destroyed by the time the callback runs.
+	class AsyncEvent
+	{
+	private:
+		class UObject* m_caller;		// The calling object, never dereference this from a worker thread.
+		class UFunction* m_function;	// The unreal function that was processed.
+		PooledBuffer m_params;			// Copy of the params struct, owned by the "EventsComponent" buffer pool.
+		EventTypes m_type;				// The origin type of this function call.
+
+	public:
+		AsyncEvent();
+		AsyncEvent(class UObject* caller, class UFunction* function, const PooledBuffer& params, EventTypes eventType);
+		AsyncEvent(const AsyncEvent& asyncEvent);
+		~AsyncEvent();
+
+	public:
+		EventTypes GetType() const;
+		class UObject* Caller() const;
+		class UFunction* Function() const;
+		const void* Params() const;
+		size_t ParamsSize() const;
+		template <typename T> const T* GetParams() const
+		{
+			if (m_params.Data && (m_params.Size >= sizeof(T)))
+			{
+				return reinterpret_cast<const T*>(m_params.Data);
+			}
+
+			return nullptr;
+		}
+		const PooledBuffer& GetBuffer() const;
+
+	public:
+		AsyncEvent& operator=(const AsyncEvent& asyncEvent);
+	};
+
 	class HooksComponent : public Component
 	{
 	public:
@@ -77,11 +114,191 @@ namespace CodeRed
 		void PlayerControllerTick(PreEvent& event);
 
 	public: // Post Hooks
-		void GameViewPortKeyPress(const PostEvent& event);
+		void GameViewPortKeyPress(class UGameViewportClient& viewportClient, struct UGameViewportClient_TA_execHandleKeyPress_Params& params, const PostEvent& event);
 	};
 
 	extern class HooksComponent Hooks;
 
+	enum class CallerFilters : uint8_t
+	{
+		None,			// Every caller is accepted.
+		Object,			// Only a specific object instance.
+		Class,			// Only callers that are a subclass of a specific class.
+		NotDefault		// Any caller that isn't a class default object or archetype.
+	};
+
+	// Optional settings for a hook, checked in "ProcessBefore" and "ProcessAfter" before its callback or any event is created.
+	class HookOptions
+	{
+	public:
+		CallerFilters Filter;
+		class UObject* FilterObject;
+		class UClass* FilterClass;
+		uint32_t CallInterval;		// Only every Nth call that passed the filter reaches the callback, zero or one calls every time.
+		uint64_t RateInterval;		// Minimum time between calls in nanoseconds, zero means unlimited.
+
+	public:
+		HookOptions();
+		HookOptions(const HookOptions& hookOptions);
+		~HookOptions();
+
+	public:
+		HookOptions& CallerObject(class UObject* uObject);
+		HookOptions& CallerClass(class UClass* uClass);
+		HookOptions& NotDefault();
+		HookOptions& EveryNthCall(uint32_t callInterval);
+		HookOptions& MaxRate(float callsPerSecond);
+		bool IsLimited() const;
+		bool PassesFilter(class UObject* caller) const;
+		bool PassesLimit(class HookStats& hookStats) const; // Only called if "IsLimited" returns true, updates the hooks shared counters.
+		std::string GetFilterName() const;
+		std::string GetLimitName() const;
+
+	public:
+		HookOptions& operator=(const HookOptions& hookOptions);
+	};
+
+	// Counters for a single hook, shared between every function and table snapshot the hook is in.
+	class HookStats
+	{
+	public:
+		std::atomic<uint64_t> Calls;	// Times the callback was called.
+		std::atomic<uint64_t> Skipped;	// Times the caller filter rejected the call before the callback.
+		std::atomic<uint64_t> Limited;	// Times the call passed the filter, but was dropped by the rate limit or call interval.
+		std::atomic<uint64_t> Counter;	// Calls that passed the filter, used for the call interval.
+		std::atomic<uint64_t> LastCall;	// Steady clock time in nanoseconds of the last call let through by the rate limit.
+
+	public:
+		HookStats();
+		HookStats(const HookStats& hookStats) = delete;
+		~HookStats();
+
+	public:
+		HookStats& operator=(const HookStats& hookStats) = delete;
+	};
+
+	// A single callback bound to a function, along with the id it was registered with so it can be removed later.
+	template <typename T> class EventHook
+	{
+	public:
+		uint32_t Id;
+		T Callback;
+		HookOptions Options;
+		std::shared_ptr<HookStats> Stats;
+
+	public:
+		EventHook() : Id(0), Callback(nullptr) {}
+		EventHook(uint32_t id, const T& callback, const HookOptions& options, const std::shared_ptr<HookStats>& stats) : Id(id), Callback(callback), Options(options), Stats(stats) {}
+		EventHook(const EventHook& eventHook) : Id(eventHook.Id), Callback(eventHook.Callback), Options(eventHook.Options), Stats(eventHook.Stats) {}
+		~EventHook() {}
+
+	public:
+		EventHook& operator=(const EventHook& eventHook)
+		{
+			Id = eventHook.Id;
+			Callback = eventHook.Callback;
+			Options = eventHook.Options;
+			Stats = eventHook.Stats;
+			return *this;
+		}
+	};
+
+	typedef EventHook<Delegate<void(PreEvent&)>> PreHook;
+	typedef EventHook<Delegate<void(const PostEvent&)>> PostHook;
+
+	// Storage for every callback bound to a single function, owned by the "EventTable" class.
+	class EventHooks
+	{
+	public:
+		std::vector<PreHook> PreHooks;
+		std::vector<PostHook> PostHooks;
+
+	public:
+		EventHooks();
+		EventHooks(const EventHooks& eventHooks);
+		~EventHooks();
+
+	public:
+		EventHooks& operator=(const EventHooks& eventHooks);
+	};
+
+	// Flat dispatch table indexed directly by a functions "ObjectInternalInteger", unhooked functions only cost a single bit test.
+	// Published tables are never modified, adding or removing a hook copies the table and publishes the copy (see "EventsComponent::ModifyTable").
+	class EventTable
+	{
+	private:
+		std::vector<uint64_t> m_hookedBits;		// One bit per object index, set if the function has at least one pre or post hook.
+		std::vector<uint32_t> m_slots;			// Object index to its position in "m_hooks" plus one, zero means the function has never been hooked.
+		std::vector<EventHooks> m_hooks;		// Contiguous storage for the callbacks of every hooked function.
+		size_t m_preHooked;						// Amount of functions with at least one pre hook.
+		size_t m_postHooked;					// Amount of functions with at least one post hook.
+
+	public:
+		EventTable();
+		EventTable(const EventTable& eventTable);
+		~EventTable();
+
+	public:
+		bool IsHooked(uint64_t functionIndex) const;
+		bool IsPreHooked(uint64_t functionIndex) const;
+		bool IsPostHooked(uint64_t functionIndex) const;
+		const EventHooks* GetHooks(uint64_t functionIndex) const;
+		size_t GetPreHookedCount() const;
+		size_t GetPostHookedCount() const;
+		size_t GetSize() const; // One past the highest object index that has ever been hooked.
+
+	public:
+		void AddPreHook(uint64_t functionIndex, const PreHook& preHook);
+		void AddPostHook(uint64_t functionIndex, const PostHook& postHook);
+		bool RemoveHook(uint32_t hookId);
+		size_t RemoveHooks(uint64_t functionIndex);
+		size_t RemoveHooks(uint64_t functionIndex, const std::vector<uint32_t>& hookIds); // Only removes the hooks with one of these ids from the function.
+		void Clear();
+
+	private:
+		EventHooks& CreateHooks(uint64_t functionIndex);
+		void UpdateHooked(uint64_t functionIndex, bool bHadPre, bool bHadPost);
+
+	public:
+		EventTable& operator=(const EventTable& eventTable);
+	};
+
+	// A hook registered by a wildcard pattern or owning class instead of an exact name, every matching function gets its callbacks in the "EventTable".
+	class PatternHook
+	{
+	public:
+		uint32_t Id;
+		std::string Pattern;					// Wildcard matched against a functions full name, empty if hooking by class.
+		class UClass* OwnerClass;				// Hooks every function owned by this class, nullptr if hooking by pattern.
+		Delegate<void(PreEvent&)> PreCallback;
+		Delegate<void(const PostEvent&)> PostCallback;
+		HookOptions Options;
+		std::shared_ptr<HookStats> Stats;
+
+	public:
+		PatternHook();
+		PatternHook(const std::string& pattern, class UClass* ownerClass, const HookOptions& options);
+		PatternHook(const PatternHook& patternHook);
+		~PatternHook();
+
+	public:
+		bool NeedsName() const;
+		bool Matches(class UFunction* function, const std::string& functionName) const; // Function name is only used if "NeedsName" returns true.
+
+	public:
+		PatternHook& operator=(const PatternHook& patternHook);
+	};
+
+	// A function that matched a pattern hook while resolving "GObjects" slots, applied to the next published table.
+	struct PatternMatch
+	{
+		class UFunction* Function;
+		size_t HookIndex; // Position of the pattern hook in "m_patternHooks", which can't change while "m_hookMutex" is held.
+	};
+
+	static constexpr size_t ASYNC_HOOK_THREADS = 2;			// Worker threads started for async post hooks, only started once the first async hook is added.
+	static constexpr size_t ASYNC_HOOK_QUEUE_SIZE = 4096;	// Max queued async callbacks, once full callbacks run synchronously on the calling thread instead.
+
 	// Manages everything related to hooking functions form Process Event, as well as detouring.
 	class EventsComponent : public Component
 	{
@@ -90,11 +307,20 @@ namespace CodeRed
 		static inline FunctionHook m_processInternal;
 
 	private: // Custom callbacks and function Blacklist.
-		static inline std::atomic<bool> m_hooksSafe; // Used to prevent thread racing issues related to adding or removing data from the maps.
-		static inline std::atomic<bool> m_blacklistSafe; // Similar thread racing issue preventive measure as "m_hooksSafe".
-		static inline std::vector<uint64_t> m_blacklisted; // Blacklisted functions internal integer.
-		static inline std::map<uint64_t, std::vector<std::function<void(PreEvent&)>>> m_preHooks; // Hooked functions internal integer and bound function.
-		static inline std::map<uint64_t, std::vector<std::function<void(const PostEvent&)>>> m_postHooks; // Hooked functions internal integer and bound function.
+		static inline AtomicBitset m_blacklisted; // Blacklisted functions internal integer, safe to modify from any thread while hooks are running.
+		static inline std::atomic<const EventTable*> m_eventTable; // Currently published snapshot of hooked functions and their callbacks, readers must hold an "EpochGuard" while using it.
+		static inline AtomicBitset m_hooked; // Copy of the published tables hooked bits, so unhooked functions are a single bit test without an "EpochGuard".
+		static inline std::mutex m_hookMutex; // Serializes adding and removing hooks, readers never touch this.
+		static inline uint32_t m_lastHookId; // Last id given out to a hook, only modified while holding "m_hookMutex".
+		static inline std::vector<PatternHook> m_patternHooks; // Pattern and class hooks, only accessed while holding "m_hookMutex".
+		static inline std::vector<class UObject*> m_resolvedSlots; // Object each "GObjects" slot held when pattern hooks were last resolved against it, only accessed while holding "m_hookMutex".
+		static inline size_t m_resolveDiffPosition; // Where the next rolling recheck of already resolved slots starts, only accessed while holding "m_hookMutex".
+
+	private: // Async post hooks.
+		static inline ThreadPool m_asyncPool; // Runs async hook callbacks, the calling thread only copies the params and queues the callback.
+		static inline BufferPool m_asyncBuffers; // Recycled params copies for async hooks, released once the callback finishes.
+		static inline std::atomic<uint64_t> m_asyncQueued; // Async callbacks handed off to the worker threads.
+		static inline std::atomic<uint64_t> m_asyncFallbacks; // Async callbacks that ran synchronously because the queue was full.
 
 	public:
 		EventsComponent();
@@ -111,6 +337,9 @@ namespace CodeRed
 		static void DetachDetours(); // Called by the deconstuctor, necessary for if your DLL gets intentionally (or unintentionally) unloaded before your game exits.
 		static void ProcessEventHook(class UObject* caller, class UFunction* function, void* params, void* result); // ProcessEvent gets redirected to this function.
 		static void ProcessInternalHook(class UObject* caller, struct FFrame& frame, void* result); // ProcessInternal gets redirected to this function.
+		// Shared by every detour, each logical call is only dispatched once per thread.
+		// With "bProfiled" false the "EventProfiler" is left out of the call entirely, the same code every call gets when "EVENT_PROFILER" isn't defined.
+		template <bool bProfiled = true> static void DispatchEvent(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const Delegate<void()>& callOriginal);
 
 	public:
 		static bool IsBlacklisted(class UFunction* function);
@@ -121,16 +350,110 @@ namespace CodeRed
 		static bool IsPostHooked(uint64_t functionIndex);
 		static void BlacklistEvent(const std::string& functionName);
 		static void WhitelistEvent(const std::string& functionName);
-		static void HookEventPre(const std::string& functionName, const std::function<void(PreEvent&)>& preHook);
-		static void HookEventPre(uint64_t functionIndex, const std::function<void(PreEvent&)>& preHook);
-		static void HookEventPost(const std::string& functionName, const std::function<void(const PostEvent&)>& postHook);
-		static void HookEventPost(uint64_t functionIndex, const std::function<void(const PostEvent&)>& postHook);
+		static size_t BlacklistEvents(const std::string& pattern); // Blacklists every function whose full name matches the wildcard pattern, returns the amount of functions found.
+		static size_t WhitelistEvents(const std::string& pattern);
+		static size_t BlacklistClass(const std::string& className); // Blacklists every function owned by the given class, returns the amount of functions found.
+		static size_t BlacklistClass(class UClass* uClass);
+		static size_t WhitelistClass(const std::string& className);
+		static size_t WhitelistClass(class UClass* uClass);
+		static uint32_t HookEventPre(const std::string& functionName, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions = HookOptions()); // Safe to call from any thread at any time, returns the hooks id or zero if it failed.
+		static uint32_t HookEventPre(uint64_t functionIndex, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions = HookOptions());
+		static uint32_t HookEventPost(const std::string& functionName, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions = HookOptions());
+		static uint32_t HookEventPost(uint64_t functionIndex, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions = HookOptions());
+		static uint32_t HookEventAsync(const std::string& functionName, const Delegate<void(const AsyncEvent&)>& asyncHook, const HookOptions& hookOptions = HookOptions()); // Post hook that runs on a worker thread with a copy of the params, for callbacks that never touch game objects.
+		static uint32_t HookEventAsync(uint64_t functionIndex, const Delegate<void(const AsyncEvent&)>& asyncHook, const HookOptions& hookOptions = HookOptions());
+		static uint64_t GetAsyncQueued(); // Async callbacks handed off to the worker threads.
+		static uint64_t GetAsyncFallbacks(); // Async callbacks that ran on the calling thread because the queue was full.
+		static const BufferPool& GetAsyncBuffers(); // Pool the async params copies come from, for its allocation and reuse counters.
+		static uint32_t HookEventsPre(const std::string& pattern, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions = HookOptions()); // Hooks every function whose full name matches the wildcard pattern, including ones loaded later.
+		static uint32_t HookEventsPost(const std::string& pattern, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions = HookOptions());
+		static uint32_t HookClassPre(const std::string& className, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions = HookOptions()); // Hooks every function owned by the given class, including ones loaded later.
+		static uint32_t HookClassPre(class UClass* uClass, const Delegate<void(PreEvent&)>& preHook, const HookOptions& hookOptions = HookOptions());
+		static uint32_t HookClassPost(const std::string& className, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions = HookOptions());
+		static uint32_t HookClassPost(class UClass* uClass, const Delegate<void(const PostEvent&)>& postHook, const HookOptions& hookOptions = HookOptions());
+		static void ResolvePatternHooks(); // Resolves pattern and class hooks for objects created since the last call, called every tick from "HUDPostRender".
+
+		// Typed hooks, the params struct size is checked against the function once when hooking so the callback gets references without any casts or null checks.
+		// The callback is only called if the event has both a caller and params, and is stored as const so it can't change state shared between threads without its own locking.
+		// Example: HookEventPre<APlayerController, APlayerController_execPlayerTick_Params>("Function Engine.PlayerController.PlayerTick", [&](APlayerController& controller, APlayerController_execPlayerTick_Params& params, PreEvent& event) {});
+		template <typename TCaller, typename TParams, typename TCallback> static uint32_t HookEventPre(const std::string& functionName, TCallback&& callback, const HookOptions& hookOptions = HookOptions())
+		{
+			static_assert(std::is_base_of_v<UObject, TCaller>, "Caller type must be a subclass of UObject!");
+			static_assert(std::is_invocable_v<const std::decay_t<TCallback>&, TCaller&, TParams&, PreEvent&>, "Callback must be callable as const and take the caller, params, and event as references!");
+			UFunction* foundFunction = FindTypedFunction(functionName, (std::is_empty_v<TParams> ? 0 : sizeof(TParams)), alignof(TParams));
+
+			if (foundFunction)
+			{
+				return HookEventPre(foundFunction->ObjectInternalInteger, [callback = std::forward<TCallback>(callback)](PreEvent& event) {
+					if (event.Caller() && event.Params()) // Calls made from native code without a params struct can't be given a reference.
+					{
+						callback(*static_cast<TCaller*>(event.Caller()), *static_cast<TParams*>(event.Params()), event);
+					}
+				}, hookOptions);
+			}
+
+			return 0;
+		}
+
+		template <typename TCaller, typename TParams, typename TCallback> static uint32_t HookEventPost(const std::string& functionName, TCallback&& callback, const HookOptions& hookOptions = HookOptions())
+		{
+			static_assert(std::is_base_of_v<UObject, TCaller>, "Caller type must be a subclass of UObject!");
+			static_assert(std::is_invocable_v<const std::decay_t<TCallback>&, TCaller&, TParams&, const PostEvent&>, "Callback must be callable as const and take the caller, params, and event as references!");
+			UFunction* foundFunction = FindTypedFunction(functionName, (std::is_empty_v<TParams> ? 0 : sizeof(TParams)), alignof(TParams));
+
+			if (foundFunction)
+			{
+				return HookEventPost(foundFunction->ObjectInternalInteger, [callback = std::forward<TCallback>(callback)](const PostEvent& event) {
+					if (event.Caller() && event.Params()) // Calls made from native code without a params struct can't be given a reference.
+					{
+						callback(*static_cast<TCaller*>(event.Caller()), *static_cast<TParams*>(event.Params()), event);
+					}
+				}, hookOptions);
+			}
+
+			return 0;
+		}
+
+		static bool UnhookEvent(uint32_t hookId); // Removes a single pre or post hook by the id it was given when created.
+		static size_t UnhookEvents(const std::string& functionName); // Removes every pre and post hook bound to the function, returns the amount removed.
+		static size_t UnhookEvents(uint64_t functionIndex);
+
+	public:
+		void ProfileCommand(const std::string& arguments); // Handles the "events_profile" command, arguments are "start", "stop", "reset", or "print" followed by an optional count.
+		void PrintProfile(size_t count) const; // Prints the most expensive hooked functions and callbacks recorded by the "EventProfiler".
+		void CensusCommand(const std::string& arguments); // Handles the "events_census" command, arguments are "start" followed by an optional sample rate, "stop", "reset", or "print" followed by an optional count.
+		void PrintCensus(size_t count) const; // Prints the most called functions and caller classes counted by the "EventCensus", hooked or not.
+		void TraceCommand(const std::string& arguments); // Handles the "events_trace" command, arguments are "start", "stop", or "replay" followed by an optional file path, "replay" also takes an optional function name.
+		// Replays the recorded events matching the filter through "DispatchEvent" against the current object table, and prints how long it took.
+		// Hooks are called with a null caller and zeroed params, the recorded caller is only an address and the params were never recorded.
+		void ReplayTrace(const std::filesystem::path& filePath, const TraceFilter& traceFilter = TraceFilter()) const;
+		void PrintHooks() const; // Handles the "events_hooks" command, prints every hooked function along with its callbacks filters and counters.
+		void DetoursCommand(const std::string& arguments); // Handles the "events_detours" command, arguments are "print" or "reset".
+		void PrintDetours() const; // Prints every "FunctionHook" with its state, hit and original call counters, and how long it took to attach and enable.
 
 	private:
-		static bool CanCallHook(class UFunction* function, ProcessResults processResult, EventTypes eventType);
-		static bool CanProcessHook(class UObject* caller, class UFunction* function, EventTypes eventType);
-		static ProcessResults ProcessBefore(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType);
-		static ProcessResults ProcessAfter(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType);
+		static std::string FormatProfile(const ProfileSample& profileSample);
+		static std::string FormatTime(uint64_t nanoseconds);
+		static class UFunction* FindTypedFunction(const std::string& functionName, size_t paramsSize, size_t paramsAlignment); // Returns nullptr if the function wasn't found, or its params size doesn't match the struct without trailing padding.
+		static void RecordEvent(class UObject* caller, class UFunction* function, EventTypes eventType); // Feeds the "EventRecorder" and "EventCensus" if they're enabled, only called once per logical call.
+		static void DispatchAsync(const std::shared_ptr<Delegate<void(const AsyncEvent&)>>& asyncHook, const PostEvent& event); // Copies the params and queues the async callback, or calls it right away if the queue is full.
+		static size_t SetBlacklisted(const std::function<bool(class UFunction*)>& predicate, bool bBlacklisted);
+		static bool CanCallHook(ProcessResults processResult, EventTypes eventType);
+		static bool ModifyTable(const std::function<bool(EventTable&)>& modifier); // Copies the current snapshot, and publishes the copy if the modifier returns true.
+		static bool PublishTable(const std::function<bool(EventTable&)>& modifier); // Same as "ModifyTable", but must already hold "m_hookMutex".
+		static uint32_t AddPatternHook(const PatternHook& patternHook);
+		// Must hold "m_hookMutex", resolves new slots and "diffBudget" already resolved ones that now hold a different object against every pattern hook.
+		// Slots whose old object had pattern hooks bound to it are added to "staleFunctions", so they can be unbound before the new object is bound.
+		static void DiffResolvedSlots(size_t diffBudget, std::vector<PatternMatch>& patternMatches, std::vector<uint64_t>& staleFunctions);
+		static void ResolveObject(size_t objectIndex, size_t firstHook, std::vector<PatternMatch>& patternMatches); // Must hold "m_hookMutex", only pattern hooks from "firstHook" onwards are checked.
+		static bool HasPatternHooks(const EventTable* eventTable, uint64_t functionIndex); // Must hold "m_hookMutex".
+		static void ApplyResolved(EventTable& eventTable, const std::vector<PatternMatch>& patternMatches, const std::vector<uint64_t>& staleFunctions); // Must hold "m_hookMutex".
+		static void SyncHooked(const EventTable* oldTable, const EventTable* newTable); // Must hold "m_hookMutex", updates "m_hooked" for every function whose hooked bit changed.
+		static bool IsHooked(class UFunction* function, EventTypes eventType);
+		static const EventHooks* FindHooks(class UFunction* function, EventTypes eventType); // Returns nullptr if the function has no hooks, the caller must be holding an "EpochGuard".
+		// Both are given the hooks found once in "DispatchEvent", which holds the "EpochGuard" that keeps them alive until the call is done.
+		template <bool bProfiled> static ProcessResults ProcessBefore(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const EventHooks* eventHooks);
+		template <bool bProfiled> static ProcessResults ProcessAfter(class UObject* caller, class UFunction* function, void* params, void* result, EventTypes eventType, const EventHooks* eventHooks);
 	};
 
 	extern class EventsComponent Events;
@@ -3,6 +3,8 @@
 
 namespace CodeRed
 {
+	//#define CLASSIFY_BY_NAME // Uncomment if your SDK doesn't have "RF_ClassDefaultObject" and "RF_ArchetypeObject", archetypes can't be told apart by name.
+
 	InstancesComponent::InstancesComponent() : Component("Instances", "Manages class instances and objects.") { OnCreate(); }
 
 	InstancesComponent::~InstancesComponent() { OnDestroy(); }
@@ -13,25 +15,59 @@ namespace CodeRed
 		I_AHUD = nullptr;
 		I_UGameViewportClient = nullptr;
 		I_APlayerController = nullptr;
+		m_namesIndexed = false;
+		m_trigramsBuilding = false;
+		m_trigramsCancelled = false;
+		m_trigramsReady = false;
+		m_trigramsReported = true;
+		m_trigramsTracking = false;
+		m_trigramsStaleWarned = false;
+		m_trigramBuildTime = 0;
+		m_trigramQueries = 0;
+		m_trigramQueryTime = 0;
+		m_scanThreads = 0;
 	}
 
-	void InstancesComponent::OnDestroy() {}
+	void InstancesComponent::OnDestroy()
+	{
+		ClearTrigramIndex();
+		ClearClassIndex();
+		m_scanPool.Stop();
+		m_staticClasses.clear();
+		m_staticFunctions.clear();
+	}
 
 	class UClass* InstancesComponent::FindStaticClass(const std::string& className)
 	{
-		if (m_staticClasses.empty() && UObject::GObjObjects())
+		if (m_staticClasses.empty() && UObject::GObjObjects() && (UObject::GObjObjects()->size() > INSTANCES_INTERATE_OFFSET))
 		{
-			for (size_t i = 0; i < (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i++)
-			{
-				UObject* uObject = UObject::GObjObjects()->at(i);
+			size_t objectCount = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET);
+			size_t chunkCount = GetScanChunks(objectCount);
+			std::vector<std::vector<std::pair<std::string, UClass*>>> chunkClasses(chunkCount);
 
-				if (uObject)
+			ParallelScan(objectCount, chunkCount, [&chunkClasses](size_t begin, size_t end, size_t chunkIndex) {
+				for (size_t i = begin; i < end; i++)
 				{
-					if ((uObject->GetFullName().find("Class") == 0))
+					UObject* uObject = UObject::GObjObjects()->at(i);
+
+					if (uObject)
 					{
-						m_staticClasses[uObject->GetFullName()] = static_cast<UClass*>(uObject);
+						std::string objectFullName = uObject->GetFullName();
+
+						if (objectFullName.find("Class") == 0)
+						{
+							chunkClasses[chunkIndex].emplace_back(std::move(objectFullName), static_cast<UClass*>(uObject));
+						}
 					}
 				}
+			});
+
+			for (std::vector<std::pair<std::string, UClass*>>& staticClasses : chunkClasses)
+			{
+				for (std::pair<std::string, UClass*>& staticClass : staticClasses)
+				{
+					m_staticClasses[std::move(staticClass.first)] = staticClass.second; // Merged in chunk order, so later objects still replace earlier ones like a single loop would.
+				}
 			}
 		}
 
@@ -58,19 +94,30 @@ namespace CodeRed
 
 	class UFunction* InstancesComponent::FindStaticFunction(const std::string& className)
 	{
-		if (m_staticFunctions.empty() && UObject::GObjObjects())
+		if (m_staticFunctions.empty() && UObject::GObjObjects() && (UObject::GObjObjects()->size() > INSTANCES_INTERATE_OFFSET))
 		{
-			for (size_t i = 0; i < (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i++)
-			{
-				UObject* uObject = UObject::GObjObjects()->at(i);
+			size_t objectCount = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET);
+			size_t chunkCount = GetScanChunks(objectCount);
+			std::vector<std::vector<std::pair<std::string, UFunction*>>> chunkFunctions(chunkCount);
 
-				if (uObject)
+			ParallelScan(objectCount, chunkCount, [&chunkFunctions](size_t begin, size_t end, size_t chunkIndex) {
+				for (size_t i = begin; i < end; i++)
 				{
+					UObject* uObject = UObject::GObjObjects()->at(i);
+
 					if (uObject && uObject->IsA<UFunction>())
 					{
-						m_staticFunctions[uObject->GetFullName()] = static_cast<UFunction*>(uObject);
+						chunkFunctions[chunkIndex].emplace_back(uObject->GetFullName(), static_cast<UFunction*>(uObject));
 					}
 				}
+			});
+
+			for (std::vector<std::pair<std::string, UFunction*>>& staticFunctions : chunkFunctions)
+			{
+				for (std::pair<std::string, UFunction*>& staticFunction : staticFunctions)
+				{
+					m_staticFunctions[std::move(staticFunction.first)] = staticFunction.second;
+				}
 			}
 		}
 
@@ -82,6 +129,783 @@ namespace CodeRed
 		return nullptr;
 	}
 
+	void InstancesComponent::UpdateClassIndex()
+	{
+		std::lock_guard<std::mutex> indexLock(m_indexMutex);
+		UpdateSlots();
+	}
+
+	void InstancesComponent::UpdateSlots()
+	{
+		IndexNewObjects();
+
+		if (UObject::GObjObjects() && !m_slotObjects.empty())
+		{
+			// The garbage collector hands freed slots out again without "GObjects" changing size, so every slot is compared with what it holds now.
+			// Both sides are plain pointer arrays, so whole blocks are compared with "memcmp" and only blocks that differ are looked at one slot at a time.
+			// Only the object pointer is compared here, objects that changed class in place are moved the next time their old class is queried.
+			UObject* const* currentObjects = UObject::GObjObjects()->data();
+			size_t slotCount = m_slotObjects.size();
+
+			for (size_t blockStart = 0; blockStart < slotCount; blockStart += INSTANCES_COMPARE_BLOCK_SIZE)
+			{
+				size_t blockEnd = std::min((blockStart + INSTANCES_COMPARE_BLOCK_SIZE), slotCount);
+
+				if (std::memcmp(&m_slotObjects[blockStart], &currentObjects[blockStart], ((blockEnd - blockStart) * sizeof(UObject*))) != 0)
+				{
+					for (size_t objectIndex = blockStart; objectIndex < blockEnd; objectIndex++)
+					{
+						if (m_slotObjects[objectIndex] != currentObjects[objectIndex])
+						{
+							RemoveSlot(objectIndex);
+							IndexSlot(objectIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void InstancesComponent::ClearClassIndex()
+	{
+		std::lock_guard<std::mutex> indexLock(m_indexMutex);
+		m_indexedSlots.clear();
+		m_slotObjects.clear();
+		m_classIndex.clear();
+		m_subclassCache.clear();
+		m_nameIndex.clear();
+		m_slotNames.clear();
+		m_namesIndexed = false;
+	}
+
+	std::vector<class UObject*> InstancesComponent::GetObjectsOf(class UClass* uClass)
+	{
+		std::vector<UObject*> classObjects;
+
+		if (UObject::GObjObjects())
+		{
+			std::lock_guard<std::mutex> indexLock(m_indexMutex);
+			CollectObjectsOf(uClass);
+			classObjects.reserve(m_queryIndexes.size());
+
+			for (uint32_t objectIndex : m_queryIndexes)
+			{
+				classObjects.push_back(m_slotObjects[objectIndex]);
+			}
+		}
+
+		return classObjects;
+	}
+
+	class UObject* InstancesComponent::FindObjectByFullName(std::string_view fullName)
+	{
+		if (UObject::GObjObjects())
+		{
+			std::vector<UObject*> slotObjects;
+
+			{
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+				IndexNewObjects();
+
+				if (!m_namesIndexed)
+				{
+					slotObjects = m_slotObjects;
+				}
+			}
+
+			if (!slotObjects.empty())
+			{
+				// Naming every object takes as long as a full "FindObject" loop, so it's done without the lock and other queries can keep using the class index meanwhile.
+				std::vector<std::string> fullNames;
+				GetFullNames(slotObjects, fullNames);
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+
+				if (!m_namesIndexed)
+				{
+					m_namesIndexed = true;
+					m_slotNames.assign(m_indexedSlots.size(), nullptr);
+
+					for (size_t i = 0; i < m_indexedSlots.size(); i++)
+					{
+						// Slots that were indexed or reused while the names were built are named again here instead.
+						if ((i < slotObjects.size()) && (slotObjects[i] == m_slotObjects[i]))
+						{
+							NameSlot(i, std::move(fullNames[i]));
+						}
+						else
+						{
+							NameSlot(i);
+						}
+					}
+				}
+			}
+
+			bool bSlotsUpdated = false;
+
+			for (int32_t attempt = 0; attempt < 3; attempt++)
+			{
+				UObject* uObject = nullptr;
+				bool bNamed = false;
+
+				{
+					std::lock_guard<std::mutex> indexLock(m_indexMutex);
+					auto nameIt = m_nameIndex.find(fullName);
+
+					if (nameIt != m_nameIndex.end())
+					{
+						uint32_t objectIndex = nameIt->second.Owner;
+						bNamed = true;
+
+						if ((objectIndex != INSTANCES_NAME_NO_OWNER) && IsSlotCurrent(objectIndex))
+						{
+							uObject = m_slotObjects[objectIndex];
+						}
+					}
+				}
+
+				// The slot might have been reused since it was named, even by a new object at the same address, so the name is checked again.
+				if (uObject && (uObject->GetFullName() == fullName))
+				{
+					return uObject;
+				}
+
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+
+				// Objects created in reused slots aren't named until their slot is compared with "GObjects", which is only done once a lookup misses so hits stay a single hash lookup.
+				if (!bSlotsUpdated)
+				{
+					UpdateSlots();
+					bSlotsUpdated = true;
+
+					if (!bNamed)
+					{
+						continue;
+					}
+				}
+				else if (!bNamed)
+				{
+					break;
+				}
+
+				auto nameIt = m_nameIndex.find(fullName);
+
+				if (nameIt == m_nameIndex.end())
+				{
+					break;
+				}
+
+				// Every slot with this name is indexed again, which hands the name to the newest one that still has it, or names the object that replaced it.
+				m_staleIndexes.clear();
+
+				for (size_t i = 0; i < m_slotNames.size(); i++)
+				{
+					if (m_slotNames[i] == &nameIt->first)
+					{
+						m_staleIndexes.push_back(static_cast<uint32_t>(i));
+					}
+				}
+
+				for (uint32_t staleIndex : m_staleIndexes)
+				{
+					RemoveSlot(staleIndex);
+					IndexSlot(staleIndex);
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool InstancesComponent::BuildTrigramIndex()
+	{
+		if (!UObject::GObjObjects() || m_trigramsBuilding.exchange(true))
+		{
+			return false;
+		}
+
+		if (m_trigramThread.joinable())
+		{
+			m_trigramThread.join();
+		}
+
+		std::vector<UObject*> slotObjects;
+		std::vector<std::string> objectNames;
+		size_t snapshotDirty = 0;
+
+		{
+			std::lock_guard<std::mutex> indexLock(m_indexMutex);
+			UpdateSlots();
+			slotObjects = m_slotObjects;
+
+			// The old index stays usable until the new one replaces it, so slots that changed before the snapshot are only forgotten once it's replaced.
+			m_trigramsTracking = true;
+			m_trigramsCancelled = false;
+			snapshotDirty = m_trigramDirty.size();
+		}
+
+		// Names are built from the snapshot without the lock, copying them out of the full name index would hold it just as long.
+		// Slots that change in the meantime were already added to "m_trigramDirty", so queries still check them by hand.
+		GetFullNames(slotObjects, objectNames);
+
+		m_trigramThread = std::thread([this, snapshotDirty, objectNames = std::move(objectNames)]() {
+			uint64_t buildStart = EventProfiler::GetTimestamp();
+			TrigramIndex trigramIndex;
+
+			for (size_t i = 0; i < objectNames.size(); i++)
+			{
+				if (m_trigramsCancelled.load(std::memory_order_relaxed))
+				{
+					m_trigramsBuilding = false;
+					return;
+				}
+
+				if (!objectNames[i].empty())
+				{
+					trigramIndex.Add(static_cast<uint32_t>(i), objectNames[i]);
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+				m_trigramIndex = std::move(trigramIndex);
+				m_trigramDirty.erase(m_trigramDirty.begin(), (m_trigramDirty.begin() + std::min(snapshotDirty, m_trigramDirty.size())));
+				m_trigramBuildTime = (EventProfiler::GetTimestamp() - buildStart);
+				m_trigramsReady = true;
+				m_trigramsReported = false;
+			}
+
+			m_trigramsBuilding = false;
+		});
+
+		return true;
+	}
+
+	void InstancesComponent::ClearTrigramIndex()
+	{
+		m_trigramsCancelled = true;
+
+		if (m_trigramThread.joinable())
+		{
+			m_trigramThread.join();
+		}
+
+		std::lock_guard<std::mutex> indexLock(m_indexMutex);
+		m_trigramIndex.Clear();
+		m_trigramDirty.clear();
+		m_trigramDirty.shrink_to_fit();
+		m_trigramsReady = false;
+		m_trigramsReported = true;
+		m_trigramsTracking = false;
+		m_trigramsStaleWarned = false;
+		m_trigramBuildTime = 0;
+		m_trigramQueries = 0;
+		m_trigramQueryTime = 0;
+	}
+
+	bool InstancesComponent::FindNameMatches(std::string_view substring, class UClass* uClass, bool bNewestOnly, std::vector<class UObject*>& nameMatches)
+	{
+		nameMatches.clear();
+
+		if (!UObject::GObjObjects() || (substring.size() < TRIGRAM_LENGTH))
+		{
+			return false;
+		}
+
+		uint64_t queryStart = EventProfiler::GetTimestamp();
+		std::vector<UObject*> candidates;
+
+		{
+			std::lock_guard<std::mutex> indexLock(m_indexMutex);
+
+			if (!m_trigramsReady)
+			{
+				return false;
+			}
+
+			UpdateSlots(); // Reused slots are only added to "m_trigramDirty" once they're compared with "GObjects".
+			m_trigramIndex.Query(substring, m_queryIndexes);
+			m_queryIndexes.insert(m_queryIndexes.end(), m_trigramDirty.begin(), m_trigramDirty.end());
+			std::sort(m_queryIndexes.begin(), m_queryIndexes.end());
+			m_queryIndexes.erase(std::unique(m_queryIndexes.begin(), m_queryIndexes.end()), m_queryIndexes.end());
+			candidates.reserve(m_queryIndexes.size());
+
+			for (auto indexIt = m_queryIndexes.rbegin(); indexIt != m_queryIndexes.rend(); indexIt++)
+			{
+				if (IsSlotCurrent(*indexIt))
+				{
+					candidates.push_back(m_slotObjects[*indexIt]);
+				}
+			}
+		}
+
+		// Candidates only share every trigram with the substring, and their slot might have been reused since, so the real name is always checked without holding the lock.
+		for (UObject* uObject : candidates)
+		{
+			if (uObject->IsA(uClass) && (uObject->GetFullName().find(substring) != std::string::npos))
+			{
+				nameMatches.push_back(uObject);
+
+				if (bNewestOnly)
+				{
+					break;
+				}
+			}
+		}
+
+		std::lock_guard<std::mutex> indexLock(m_indexMutex);
+		m_trigramQueries++;
+		m_trigramQueryTime += (EventProfiler::GetTimestamp() - queryStart);
+		return true;
+	}
+
+	void InstancesComponent::CheckTrigramIndex()
+	{
+		std::lock_guard<std::mutex> indexLock(m_indexMutex);
+
+		if (m_trigramsReady && !m_trigramsReported)
+		{
+			m_trigramsReported = true;
+			m_trigramsStaleWarned = false;
+			Console.Write(GetNameFormatted() + "Trigram index built for " + std::to_string(m_trigramIndex.GetNameCount()) + " object(s) in " + Format::Precision(static_cast<float>(m_trigramBuildTime) / 1000000.0f, 2) + "ms, using " + std::to_string(m_trigramIndex.GetMemoryUsage() / 1024) + "KB.");
+		}
+
+		// Rebuilding names every object on the calling thread, which would hitch the game if it was started from here, so it's left to the "instances_trigrams" command.
+		if (m_trigramsReady && !m_trigramsStaleWarned && !m_trigramsBuilding && (m_trigramDirty.size() > INSTANCES_TRIGRAM_DIRTY_LIMIT))
+		{
+			m_trigramsStaleWarned = true;
+			Console.Warning(GetNameFormatted() + "Warning: " + std::to_string(m_trigramDirty.size()) + " object(s) changed since the trigram index was built, use \"instances_trigrams build\" to rebuild it!");
+		}
+	}
+
+	void InstancesComponent::TrigramCommand(const std::string& arguments)
+	{
+		std::vector<std::string> splitArguments = Format::Split(arguments, ' ');
+		std::string action = (splitArguments.empty() ? "print" : Format::ToLower(splitArguments[0]));
+
+		if (action == "build")
+		{
+			if (BuildTrigramIndex())
+			{
+				Console.Notify(GetNameFormatted() + "Building trigram index in the background, it's written here once it's done.");
+			}
+			else
+			{
+				Console.Warning(GetNameFormatted() + "Warning: A trigram index is already being built!");
+			}
+		}
+		else if (action == "clear")
+		{
+			ClearTrigramIndex();
+			Console.Notify(GetNameFormatted() + "Trigram index cleared.");
+		}
+		else if (action == "print")
+		{
+			PrintTrigrams();
+		}
+		else
+		{
+			Console.Warning(GetNameFormatted() + "Warning: Unknown argument \"" + action + "\", expected \"build\", \"clear\", or \"print\"!");
+		}
+	}
+
+	void InstancesComponent::PrintTrigrams()
+	{
+		std::lock_guard<std::mutex> indexLock(m_indexMutex);
+
+		if (!m_trigramsReady)
+		{
+			Console.Warning(GetNameFormatted() + (m_trigramsBuilding ? "Warning: The trigram index is still being built!" : "Warning: No trigram index built, use \"instances_trigrams build\" first!"));
+			return;
+		}
+
+		Console.Write(GetNameFormatted() + "Trigram Index Objects: " + std::to_string(m_trigramIndex.GetNameCount()) + ", Trigrams: " + std::to_string(m_trigramIndex.GetTrigramCount()) + ", Memory: " + std::to_string(m_trigramIndex.GetMemoryUsage() / 1024) + "KB, Build Time: " + Format::Precision(static_cast<float>(m_trigramBuildTime) / 1000000.0f, 2) + "ms");
+		Console.Write(GetNameFormatted() + "Queries: " + std::to_string(m_trigramQueries) + ", Average: " + Format::Precision((m_trigramQueries > 0) ? (static_cast<float>(m_trigramQueryTime / m_trigramQueries) / 1000.0f) : 0.0f, 2) + "us, Changed Since Build: " + std::to_string(m_trigramDirty.size()) + (m_trigramsBuilding ? " (Rebuilding)" : ""));
+	}
+
+	size_t InstancesComponent::GetScanThreads() const
+	{
+		size_t scanThreads = m_scanThreads.load();
+
+		if (scanThreads == 0)
+		{
+			return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, INSTANCES_SCAN_MAX_THREADS);
+		}
+
+		return scanThreads;
+	}
+
+	void InstancesComponent::SetScanThreads(size_t threadCount)
+	{
+		std::lock_guard<std::mutex> scanLock(m_scanMutex);
+		threadCount = std::min(threadCount, INSTANCES_SCAN_MAX_THREADS);
+
+		if (m_scanThreads.exchange(threadCount) != threadCount)
+		{
+			m_scanPool.Stop(); // Restarted with the new thread count by the next scan.
+		}
+	}
+
+	void InstancesComponent::FindNameMatchesByScan(std::string_view substring, const std::vector<class UObject*>& classObjects, bool bNewestOnly, std::vector<class UObject*>& nameMatches)
+	{
+		nameMatches.clear();
+		size_t chunkCount = GetScanChunks(classObjects.size());
+		std::vector<std::vector<UObject*>> chunkMatches(chunkCount);
+
+		ParallelScan(classObjects.size(), chunkCount, [&](size_t begin, size_t end, size_t chunkIndex) {
+			for (size_t i = end; i > begin; i--) // Newest first inside each chunk, so "bNewestOnly" can stop at the first match.
+			{
+				if (classObjects[i - 1]->GetFullName().find(substring) != std::string::npos)
+				{
+					chunkMatches[chunkIndex].push_back(classObjects[i - 1]);
+
+					if (bNewestOnly)
+					{
+						break;
+					}
+				}
+			}
+		});
+
+		for (auto chunkIt = chunkMatches.rbegin(); chunkIt != chunkMatches.rend(); chunkIt++)
+		{
+			for (UObject* uObject : *chunkIt)
+			{
+				nameMatches.push_back(uObject);
+
+				if (bNewestOnly)
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	size_t InstancesComponent::GetScanChunks(size_t objectCount) const
+	{
+		return std::clamp<size_t>((objectCount / INSTANCES_SCAN_CHUNK_SIZE), 1, GetScanThreads());
+	}
+
+	void InstancesComponent::ParallelScan(size_t objectCount, size_t chunkCount, const Delegate<void(size_t, size_t, size_t)>& body)
+	{
+		if (chunkCount <= 1)
+		{
+			body(0, objectCount, 0);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> scanLock(m_scanMutex);
+
+			if (!m_scanPool.IsRunning())
+			{
+				m_scanPool.Start((GetScanThreads() - 1), INSTANCES_SCAN_MAX_THREADS); // The calling thread is the last one.
+			}
+		}
+
+		m_scanPool.ParallelFor(objectCount, chunkCount, body);
+	}
+
+	void InstancesComponent::GetFullNames(const std::vector<class UObject*>& objects, std::vector<std::string>& fullNames)
+	{
+		fullNames.clear();
+		fullNames.resize(objects.size());
+
+		ParallelScan(objects.size(), GetScanChunks(objects.size()), [&objects, &fullNames](size_t begin, size_t end, size_t chunkIndex) {
+			for (size_t i = begin; i < end; i++)
+			{
+				if (objects[i])
+				{
+					fullNames[i] = objects[i]->GetFullName();
+				}
+			}
+		});
+	}
+
+	ObjectTypes InstancesComponent::GetObjectType(class UObject* object)
+	{
+		if (object)
+		{
+#ifdef CLASSIFY_BY_NAME
+			if (object->GetFullName().find("Default__") != std::string::npos)
+			{
+				return ObjectTypes::Default;
+			}
+#else
+			if (object->ObjectFlags & EObjectFlags::RF_ClassDefaultObject)
+			{
+				return ObjectTypes::Default;
+			}
+			else if (object->ObjectFlags & EObjectFlags::RF_ArchetypeObject)
+			{
+				return ObjectTypes::Archetype;
+			}
+#endif
+		}
+
+		return ObjectTypes::Instance;
+	}
+
+	bool InstancesComponent::IsDefaultObject(class UObject* object)
+	{
+		return (GetObjectType(object) != ObjectTypes::Instance);
+	}
+
+	bool InstancesComponent::IsArchetypeObject(class UObject* object)
+	{
+		return (GetObjectType(object) == ObjectTypes::Archetype);
+	}
+
+	bool InstancesComponent::IsPendingKill(class UObject* object)
+	{
+		return (object && (object->ObjectFlags & EObjectFlags::RF_PendingKill));
+	}
+
+	void InstancesComponent::CollectObjectsOf(class UClass* uClass)
+	{
+		m_queryIndexes.clear();
+		m_staleIndexes.clear();
+
+		if (uClass && UObject::GObjObjects())
+		{
+			UpdateSlots();
+
+			for (UClass* subclass : GetSubclassesOf(uClass))
+			{
+				for (uint32_t objectIndex : m_classIndex[subclass])
+				{
+					UObject* uObject = UObject::GObjObjects()->at(objectIndex);
+
+					if (uObject && (uObject == m_slotObjects[objectIndex]) && (uObject->Class == subclass))
+					{
+						m_queryIndexes.push_back(objectIndex);
+					}
+					else
+					{
+						m_staleIndexes.push_back(objectIndex); // Buckets can't be changed while we're looping through them.
+					}
+				}
+			}
+
+			for (uint32_t objectIndex : m_staleIndexes)
+			{
+				RemoveSlot(objectIndex);
+				IndexSlot(objectIndex);
+			}
+
+			std::sort(m_queryIndexes.begin(), m_queryIndexes.end());
+		}
+	}
+
+	void InstancesComponent::IndexNewObjects()
+	{
+		if (UObject::GObjObjects())
+		{
+			size_t tableSize = static_cast<size_t>(UObject::GObjObjects()->size());
+			size_t objectCount = ((tableSize > INSTANCES_INTERATE_OFFSET) ? (tableSize - INSTANCES_INTERATE_OFFSET) : 0);
+			size_t indexedCount = m_indexedSlots.size();
+
+			if (objectCount > indexedCount)
+			{
+				m_indexedSlots.resize(objectCount, IndexedSlot{ nullptr, ObjectTypes::Instance, 0 });
+				m_slotObjects.resize(objectCount, nullptr);
+
+				if (m_namesIndexed)
+				{
+					m_slotNames.resize(objectCount, nullptr);
+				}
+
+				for (size_t i = indexedCount; i < objectCount; i++)
+				{
+					IndexSlot(i);
+				}
+			}
+			else if (objectCount < indexedCount) // The game never shrinks "GObjects", but if it's replaced the slots past its end can't be compared anymore.
+			{
+				for (size_t i = objectCount; i < indexedCount; i++)
+				{
+					RemoveSlot(i);
+				}
+
+				m_indexedSlots.resize(objectCount);
+				m_slotObjects.resize(objectCount);
+
+				if (m_namesIndexed)
+				{
+					m_slotNames.resize(objectCount);
+				}
+			}
+		}
+	}
+
+	void InstancesComponent::IndexSlot(size_t objectIndex)
+	{
+		UObject* uObject = UObject::GObjObjects()->at(static_cast<int32_t>(objectIndex));
+		IndexedSlot& indexedSlot = m_indexedSlots[objectIndex];
+		m_slotObjects[objectIndex] = uObject;
+		indexedSlot.Class = (uObject ? uObject->Class : nullptr);
+		indexedSlot.Type = GetObjectType(uObject); // Only done once per object, so the name fallback doesn't cost anything per query.
+		indexedSlot.BucketPosition = 0;
+
+		if (indexedSlot.Class)
+		{
+			std::vector<uint32_t>& classBucket = m_classIndex[indexedSlot.Class];
+
+			if (classBucket.empty())
+			{
+				m_subclassCache.clear(); // Cached subclass lists only include classes that had objects when they were built.
+			}
+
+			indexedSlot.BucketPosition = static_cast<uint32_t>(classBucket.size());
+			classBucket.push_back(static_cast<uint32_t>(objectIndex));
+		}
+
+		if (m_namesIndexed)
+		{
+			NameSlot(objectIndex);
+		}
+
+		if (m_trigramsTracking)
+		{
+			m_trigramDirty.push_back(static_cast<uint32_t>(objectIndex));
+		}
+	}
+
+	void InstancesComponent::RemoveSlot(size_t objectIndex)
+	{
+		IndexedSlot& indexedSlot = m_indexedSlots[objectIndex];
+
+		if (indexedSlot.Class)
+		{
+			std::vector<uint32_t>& classBucket = m_classIndex[indexedSlot.Class];
+			uint32_t lastIndex = classBucket.back();
+
+			// Order inside a bucket doesn't matter, so the last index is swapped in and popped.
+			classBucket[indexedSlot.BucketPosition] = lastIndex;
+			m_indexedSlots[lastIndex].BucketPosition = indexedSlot.BucketPosition;
+			classBucket.pop_back();
+		}
+
+		if (m_namesIndexed)
+		{
+			UnnameSlot(objectIndex);
+		}
+
+		indexedSlot = IndexedSlot{ nullptr, ObjectTypes::Instance, 0 };
+		m_slotObjects[objectIndex] = nullptr;
+	}
+
+	const std::vector<class UClass*>& InstancesComponent::GetSubclassesOf(class UClass* uClass)
+	{
+		auto subclassIt = m_subclassCache.find(uClass);
+
+		if (subclassIt != m_subclassCache.end())
+		{
+			return subclassIt->second;
+		}
+
+		std::vector<UClass*>& subclasses = m_subclassScratch;
+		subclasses.clear();
+		bool bComplete = true;
+
+		for (const auto& [bucketClass, classBucket] : m_classIndex)
+		{
+			// There's no way to walk a class hierarchy from the class itself in every SDK, so any live object in the bucket is used to ask instead.
+			UObject* liveObject = nullptr;
+
+			for (uint32_t objectIndex : classBucket)
+			{
+				UObject* uObject = UObject::GObjObjects()->at(objectIndex);
+
+				if (uObject && (uObject == m_slotObjects[objectIndex]) && (uObject->Class == bucketClass))
+				{
+					liveObject = uObject;
+					break;
+				}
+			}
+
+			if (liveObject)
+			{
+				if (liveObject->IsA(uClass))
+				{
+					subclasses.push_back(bucketClass);
+				}
+			}
+			else if (!classBucket.empty())
+			{
+				bComplete = false; // Only stale objects left, this bucket has to be asked again next time.
+			}
+		}
+
+		if (bComplete)
+		{
+			return (m_subclassCache[uClass] = subclasses);
+		}
+
+		return subclasses;
+	}
+
+	bool InstancesComponent::IsSlotCurrent(size_t objectIndex) const
+	{
+		if (objectIndex < m_indexedSlots.size())
+		{
+			UObject* uObject = UObject::GObjObjects()->at(static_cast<int32_t>(objectIndex));
+			return (uObject && (uObject == m_slotObjects[objectIndex]));
+		}
+
+		return false;
+	}
+
+	void InstancesComponent::NameSlot(size_t objectIndex)
+	{
+		UObject* uObject = m_slotObjects[objectIndex];
+
+		if (uObject)
+		{
+			NameSlot(objectIndex, uObject->GetFullName());
+		}
+	}
+
+	void InstancesComponent::NameSlot(size_t objectIndex, std::string&& fullName)
+	{
+		if (m_slotObjects[objectIndex] && !fullName.empty())
+		{
+			auto [nameIt, bInserted] = m_nameIndex.try_emplace(std::move(fullName), NameEntry{ static_cast<uint32_t>(objectIndex), 0 });
+			NameEntry& nameEntry = nameIt->second;
+			nameEntry.Count++;
+
+			// "FindObject" always returned the newest object with a name, but a higher slot only keeps it while it still holds the object it was named with.
+			if (!bInserted && ((nameEntry.Owner == INSTANCES_NAME_NO_OWNER) || (nameEntry.Owner < objectIndex) || !IsSlotCurrent(nameEntry.Owner)))
+			{
+				nameEntry.Owner = static_cast<uint32_t>(objectIndex);
+			}
+
+			m_slotNames[objectIndex] = &nameIt->first; // Keys in an unordered map never move, even when it rehashes.
+		}
+	}
+
+	void InstancesComponent::UnnameSlot(size_t objectIndex)
+	{
+		if (m_slotNames[objectIndex])
+		{
+			auto nameIt = m_nameIndex.find(*m_slotNames[objectIndex]);
+			m_slotNames[objectIndex] = nullptr;
+
+			if (nameIt != m_nameIndex.end())
+			{
+				NameEntry& nameEntry = nameIt->second;
+
+				if (--nameEntry.Count == 0)
+				{
+					m_nameIndex.erase(nameIt);
+				}
+				else if (nameEntry.Owner == objectIndex)
+				{
+					nameEntry.Owner = INSTANCES_NAME_NO_OWNER; // Other slots still have this name, the next lookup finds which of them is newest instead of searching for it here.
+				}
+			}
+		}
+	}
+
 	void InstancesComponent::MarkInvincible(class UObject* object)
 	{
 		if (object)
@@ -3,6 +3,37 @@
 
 namespace CodeRed
 {
+	// What kind of object something is, which never changes after it's created so it's cached per "GObjects" slot.
+	enum class ObjectTypes : uint8_t
+	{
+		Instance,	// A normal object, created at runtime or loaded from a package.
+		Default,	// A class default object, the ones with "Default__" in their name.
+		Archetype	// A template other objects are created from, such as the components of a class default object.
+	};
+
+	// A single "GObjects" slot as it was when it was indexed, if the slot later holds a different object it's moved to the right class bucket.
+	// The object itself is kept in "m_slotObjects" instead, so every slot can be compared with "GObjects" in one pass.
+	struct IndexedSlot
+	{
+		class UClass* Class;
+		ObjectTypes Type;
+		uint32_t BucketPosition; // Where this slots object index is in its class bucket, so it can be removed without searching.
+	};
+
+	// Transparent hash for the full name index, so it can be searched with a "std::string_view" without creating a temporary string.
+	struct FullNameHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view fullName) const { return std::hash<std::string_view>{}(fullName); }
+	};
+
+	// Full names aren't unique while the game runs, so every slot with the name is counted and only the newest slot that still holds its object owns it.
+	struct NameEntry
+	{
+		uint32_t Owner; // The object index "FindObjectByFullName" checks first, or "INSTANCES_NAME_NO_OWNER" if it was unnamed.
+		uint32_t Count; // Amount of slots with this name, the entry is only erased once none are left.
+	};
+
 	// Automatically stores active class instances that can be retrieved at any time.
 	class InstancesComponent : public Component
 	{
@@ -20,25 +51,106 @@ namespace CodeRed
 		std::map<std::string, class UFunction*> m_staticFunctions;
 		std::vector<class UObject*> m_createdObjects;
 
+	private:
+		std::mutex m_indexMutex;
+		std::vector<IndexedSlot> m_indexedSlots; // One for every "GObjects" slot that has been indexed so far.
+		std::vector<class UObject*> m_slotObjects; // The object every indexed slot held when it was indexed, laid out like "GObjects" so they can be compared directly.
+		std::unordered_map<class UClass*, std::vector<uint32_t>> m_classIndex; // Object indexes grouped by their exact class, empty buckets are kept around.
+		std::unordered_map<class UClass*, std::vector<class UClass*>> m_subclassCache; // Every indexed class that is a child of the key, cleared when an empty bucket is filled.
+		std::vector<uint32_t> m_queryIndexes; // Results of the last "CollectObjectsOf" call, reused so queries don't allocate.
+		std::vector<uint32_t> m_staleIndexes;
+		std::vector<class UClass*> m_subclassScratch; // Subclass lists that couldn't be cached yet, because a bucket only had stale objects in it.
+		std::unordered_map<std::string, NameEntry, FullNameHash, std::equal_to<>> m_nameIndex; // Full name to object index, only built once the first strict "FindObject" is called.
+		std::vector<const std::string*> m_slotNames; // The key every named slot has in "m_nameIndex", including ones that don't own it, so it can be removed once the object is gone.
+		bool m_namesIndexed;
+
+	private:
+		TrigramIndex m_trigramIndex; // Only searched once "m_trigramsReady" is set, built on "m_trigramThread" from a snapshot of every objects name.
+		std::thread m_trigramThread;
+		std::atomic<bool> m_trigramsBuilding;
+		std::atomic<bool> m_trigramsCancelled;
+		bool m_trigramsReady;
+		bool m_trigramsReported; // If the build stats have been written to the console yet, the build thread can't do it itself.
+		bool m_trigramsTracking; // Set from the moment the snapshot is taken, so slots indexed after it are remembered in "m_trigramDirty".
+		bool m_trigramsStaleWarned; // If the "INSTANCES_TRIGRAM_DIRTY_LIMIT" warning has been written since the index was last built.
+		std::vector<uint32_t> m_trigramDirty; // Slots indexed after the snapshot was taken, substring queries always check these by hand.
+		uint64_t m_trigramBuildTime;
+		uint64_t m_trigramQueries;
+		uint64_t m_trigramQueryTime;
+
+	private:
+		ThreadPool m_scanPool; // Only started the first time a scan is large enough to split up, the calling thread always scans a chunk itself.
+		std::atomic<size_t> m_scanThreads; // Total threads used by a scan including the calling one, zero picks one per core. Set from the settings callback while scans can be running.
+		std::mutex m_scanMutex;
+
+	public:
+		// Indexes objects created since the last call, and compares every already indexed slot with "GObjects" for objects created in reused slots.
+		// Every query does this itself before it looks at the index, so calling it by hand is never needed to see new objects.
+		void UpdateClassIndex();
+		void ClearClassIndex();
+		std::vector<class UObject*> GetObjectsOf(class UClass* uClass); // Every indexed object that is an instance of the class or its subclasses, in the same order as "GObjects".
+		// Exact full name lookup, the first call names every object so it's as slow as one "FindObject" loop, after that it's a single hash lookup.
+		// Objects created or garbage collected after that are named and removed along with the class index, the result is always checked against its current name.
+		// A miss compares every slot with "GObjects" and looks again before returning null, so objects created in reused slots are still found.
+		class UObject* FindObjectByFullName(std::string_view fullName);
+
+	public:
+		// Optional trigram index for substring searches, non strict "FindObject" and "FindAllObjects" use it once it's built and fall back to looping otherwise.
+		// Names are read on the calling thread because objects can be destroyed while the game runs, only the index itself is built in the background.
+		bool BuildTrigramIndex(); // Returns false if an index is already being built.
+		void ClearTrigramIndex();
+		bool FindNameMatches(std::string_view substring, class UClass* uClass, bool bNewestOnly, std::vector<class UObject*>& nameMatches); // Returns false if the index isn't built or the substring is too short, matches are newest first.
+		void CheckTrigramIndex(); // Called every tick from "HUDPostRender", writes the build stats once a background build is done and warns once it should be rebuilt.
+		void TrigramCommand(const std::string& arguments); // Handles the "instances_trigrams" command, arguments are "build", "clear", or "print".
+		void PrintTrigrams(); // Prints the trigram index size and memory usage, along with how long it took to build and the average query time.
+
+	public:
+		// Full "GObjects" scans that have to build a name for every object are split into chunks and run on a thread pool, each chunk fills its own results which are merged after.
+		size_t GetScanThreads() const;
+		void SetScanThreads(size_t threadCount); // Zero uses one thread per core, one scans everything on the calling thread like before.
+		void FindNameMatchesByScan(std::string_view substring, const std::vector<class UObject*>& classObjects, bool bNewestOnly, std::vector<class UObject*>& nameMatches); // Loops through "classObjects", matches are newest first.
+
+	private:
+		size_t GetScanChunks(size_t objectCount) const;
+		void ParallelScan(size_t objectCount, size_t chunkCount, const Delegate<void(size_t, size_t, size_t)>& body); // Runs "body(begin, end, chunkIndex)" for every chunk, returns once they're all done.
+		void GetFullNames(const std::vector<class UObject*>& objects, std::vector<std::string>& fullNames); // Builds every name with a parallel scan, null objects get an empty name.
+
+	public:
+		// Classifies objects by their flags instead of their name, so nothing is allocated. Uncomment "CLASSIFY_BY_NAME" in "Instances.cpp" if your SDK doesn't have these flags.
+		static ObjectTypes GetObjectType(class UObject* object);
+		static bool IsDefaultObject(class UObject* object); // Returns true for both class default objects and archetypes, which is what the "Default__" name check used to find.
+		static bool IsArchetypeObject(class UObject* object);
+		static bool IsPendingKill(class UObject* object); // Always read from the objects flags, as it changes once the object is destroyed.
+
+	private:
+		void UpdateSlots(); // Must hold "m_indexMutex", indexes new objects and reindexes every slot that holds a different object than it was indexed with.
+		void CollectObjectsOf(class UClass* uClass); // Must hold "m_indexMutex", fills "m_queryIndexes" with every valid object index in the same order as "GObjects".
+		void IndexNewObjects(); // Must hold "m_indexMutex", also drops slots past the end if "GObjects" got smaller.
+		void IndexSlot(size_t objectIndex); // Must hold "m_indexMutex", the slot must not already be in a bucket.
+		void RemoveSlot(size_t objectIndex); // Must hold "m_indexMutex".
+		const std::vector<class UClass*>& GetSubclassesOf(class UClass* uClass); // Must hold "m_indexMutex", only valid until the index is changed again.
+		bool IsSlotCurrent(size_t objectIndex) const; // Must hold "m_indexMutex", returns true if the slot still holds the object it was indexed with.
+		void NameSlot(size_t objectIndex); // Must hold "m_indexMutex".
+		void NameSlot(size_t objectIndex, std::string&& fullName); // Must hold "m_indexMutex".
+		void UnnameSlot(size_t objectIndex); // Must hold "m_indexMutex".
+
 	public: // Helper functions for class instance grabbing/manipulation.
-		// All GetInstanceOf related functions loop through the entire GObject TArray, which can be resource heavy if you're using them everywhere.
-		// So rely on hooking functions and storing classes here instead, only use GetInstanceOf functions them when needed.
+		// All GetInstanceOf related functions go through the class index above, so they only visit objects of the requested class and its subclasses.
+		// It's still faster to rely on hooking functions and storing classes here instead, only use GetInstanceOf functions them when needed.
 
 		// Get the default constructor of a class type. Example: UGameData_TA* gameData = GetDefaultInstanceOf<UGameData_TA>();
 		template<typename T> T* GetDefaultInstanceOf()
 		{
 			if (std::is_base_of<UObject, T>::value && UObject::GObjObjects())
 			{
-				for (size_t i = 0; i < (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i++)
-				{
-					UObject* uObject = UObject::GObjObjects()->at(i);
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+				CollectObjectsOf(T::StaticClass());
 
-					if (uObject && uObject->IsA<T>())
+				for (uint32_t objectIndex : m_queryIndexes)
+				{
+					if (m_indexedSlots[objectIndex].Type == ObjectTypes::Default) // Archetypes are skipped, "CreateInstance" would copy whatever template they were made for.
 					{
-						if (uObject->GetFullName().find("Default__") != std::string::npos)
-						{
-							return static_cast<T*>(uObject);
-						}
+						return static_cast<T*>(m_slotObjects[objectIndex]);
 					}
 				}
 			}
@@ -51,16 +163,16 @@ namespace CodeRed
 		{
 			if (std::is_base_of<UObject, T>::value && UObject::GObjObjects())
 			{
-				for (size_t i = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i > 0; i--)
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+				CollectObjectsOf(T::StaticClass());
+
+				for (auto indexIt = m_queryIndexes.rbegin(); indexIt != m_queryIndexes.rend(); indexIt++)
 				{
-					UObject* uObject = UObject::GObjObjects()->at(i);
+					UObject* uObject = m_slotObjects[*indexIt];
 
-					if (uObject && uObject->IsA<T>())
+					if ((m_indexedSlots[*indexIt].Type == ObjectTypes::Instance) && !IsPendingKill(uObject))
 					{
-						if (uObject->GetFullName().find("Default__") == std::string::npos)
-						{
-							return static_cast<T*>(uObject);
-						}
+						return static_cast<T*>(uObject);
 					}
 				}
 			}
@@ -73,17 +185,11 @@ namespace CodeRed
 		{
 			if (std::is_base_of<UObject, T>::value && UObject::GObjObjects())
 			{
-				for (size_t i = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i > 0; i--)
-				{
-					UObject* uObject = UObject::GObjObjects()->at(i);
+				T* uObject = GetInstanceOf<T>();
 
-					if (uObject && uObject->IsA<T>())
-					{
-						if (uObject->GetFullName().find("Default__") == std::string::npos)
-						{
-							return static_cast<T*>(uObject);
-						}
-					}
+				if (uObject)
+				{
+					return uObject;
 				}
 
 				return CreateInstance<T>();
@@ -99,16 +205,17 @@ namespace CodeRed
 
 			if (std::is_base_of<UObject, T>::value && UObject::GObjObjects())
 			{
-				for (size_t i = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i > 0; i--)
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+				CollectObjectsOf(T::StaticClass());
+				objectInstances.reserve(m_queryIndexes.size()); // The returned vector is the only allocation.
+
+				for (auto indexIt = m_queryIndexes.rbegin(); indexIt != m_queryIndexes.rend(); indexIt++)
 				{
-					UObject* uObject = UObject::GObjObjects()->at(i);
+					UObject* uObject = m_slotObjects[*indexIt];
 
-					if (uObject && uObject->IsA<T>())
+					if ((m_indexedSlots[*indexIt].Type == ObjectTypes::Instance) && !IsPendingKill(uObject))
 					{
-						if (uObject->GetFullName().find("Default__") == std::string::npos)
-						{
-							objectInstances.push_back(static_cast<T*>(uObject));
-						}
+						objectInstances.push_back(static_cast<T*>(uObject));
 					}
 				}
 			}
@@ -116,23 +223,33 @@ namespace CodeRed
 			return objectInstances;
 		}
 
-		// Get all default instances of a class type.
+		// Get all default instances of a class type, archetypes aren't included.
 		template<typename T> std::vector<T*> GetAllDefaultInstancesOf()
+		{
+			return GetAllObjectsOfType<T>(ObjectTypes::Default);
+		}
+
+		// Get all archetypes of a class type, the templates objects such as the components of a class default object are created from.
+		template<typename T> std::vector<T*> GetAllArchetypesOf()
+		{
+			return GetAllObjectsOfType<T>(ObjectTypes::Archetype);
+		}
+
+		// Get all objects of a class type that are of the given object type, newest first like the other "GetAll" functions.
+		template<typename T> std::vector<T*> GetAllObjectsOfType(ObjectTypes objectType)
 		{
 			std::vector<T*> objectInstances;
 
 			if (std::is_base_of<UObject, T>::value && UObject::GObjObjects())
 			{
-				for (size_t i = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i > 0; i--)
-				{
-					UObject* uObject = UObject::GObjObjects()->at(i);
+				std::lock_guard<std::mutex> indexLock(m_indexMutex);
+				CollectObjectsOf(T::StaticClass());
 
-					if (uObject && uObject->IsA<T>())
+				for (auto indexIt = m_queryIndexes.rbegin(); indexIt != m_queryIndexes.rend(); indexIt++)
+				{
+					if (m_indexedSlots[*indexIt].Type == objectType)
 					{
-						if (uObject->GetFullName().find("Default__") != std::string::npos)
-						{
-							objectInstances.push_back(static_cast<T*>(uObject));
-						}
+						objectInstances.push_back(static_cast<T*>(m_slotObjects[*indexIt]));
 					}
 				}
 			}
@@ -143,29 +260,22 @@ namespace CodeRed
 		// Get an object instance by it's name and class type. Example: UTexture2D* texture = FindObject<UTexture2D>("WhiteSquare");
 		template<typename T> T* FindObject(const std::string& objectName, bool bStrictFind = false)
 		{
-			if (std::is_base_of<UObject, T>::value && UObject::GObjObjects())
+			if (std::is_base_of<UObject, T>::value)
 			{
-				for (size_t i = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i > 0; i--)
+				if (bStrictFind)
 				{
-					UObject* uObject = UObject::GObjObjects()->at(i);
+					UObject* uObject = FindObjectByFullName(objectName);
+					return ((uObject && uObject->IsA<T>()) ? static_cast<T*>(uObject) : nullptr);
+				}
 
-					if (uObject && uObject->IsA<T>())
-					{
-						std::string objectFullName = uObject->GetFullName();
-
-						if (bStrictFind)
-						{
-							if (objectFullName == objectName)
-							{
-								return static_cast<T*>(uObject);
-							}
-						}
-						else if (objectFullName.find(objectName) != std::string::npos)
-						{
-							return static_cast<T*>(uObject);
-						}
-					}
+				std::vector<UObject*> nameMatches;
+
+				if (!FindNameMatches(objectName, T::StaticClass(), true, nameMatches))
+				{
+					FindNameMatchesByScan(objectName, GetObjectsOf(T::StaticClass()), true, nameMatches);
 				}
+
+				return (nameMatches.empty() ? nullptr : static_cast<T*>(nameMatches.front()));
 			}
 
 			return nullptr;
@@ -176,19 +286,18 @@ namespace CodeRed
 		{
 			std::vector<T*> objectInstances;
 
-			if (std::is_base_of<UObject, T>::value && UObject::GObjObjects())
+			if (std::is_base_of<UObject, T>::value)
 			{
-				for (size_t i = (UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET); i > 0; i--)
+				std::vector<UObject*> nameMatches;
+
+				if (!FindNameMatches(objectName, T::StaticClass(), false, nameMatches))
 				{
-					UObject* uObject = UObject::GObjObjects()->at(i);
+					FindNameMatchesByScan(objectName, GetObjectsOf(T::StaticClass()), false, nameMatches);
+				}
 
-					if (uObject && uObject->IsA<T>())
-					{
-						if (uObject->GetFullName().find(objectName) != std::string::npos)
-						{
-							objectInstances.push_back(static_cast<T*>(uObject));
-						}
-					}
+				for (UObject* uObject : nameMatches)
+				{
+					objectInstances.push_back(static_cast<T*>(uObject));
 				}
 			}
 
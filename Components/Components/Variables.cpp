@@ -813,25 +813,25 @@ namespace CodeRed
 		return this;
 	}
 
-	Setting* Setting::BindCallback(const std::function<void()>& callback)
+	Setting* Setting::BindCallback(const Delegate<void()>& callback)
 	{
 		m_callback = callback;
 		return this;
 	}
 
-	Setting* Setting::BindSettingCallback(const std::function<void(class Setting*)>& callback)
+	Setting* Setting::BindSettingCallback(const Delegate<void(class Setting*)>& callback)
 	{
 		m_settingCallback = callback;
 		return this;
 	}
 
-	Setting* Setting::BindBoolCallback(const std::function<void(bool)>& callback)
+	Setting* Setting::BindBoolCallback(const Delegate<void(bool)>& callback)
 	{
 		m_boolCallback = callback;
 		return this;
 	}
 
-	Setting* Setting::BindStringCallback(const std::function<void(std::string)>& callback)
+	Setting* Setting::BindStringCallback(const Delegate<void(std::string)>& callback)
 	{
 		m_stringCallback = callback;
 		return this;
@@ -1002,13 +1002,13 @@ namespace CodeRed
 		return this;
 	}
 
-	Command* Command::BindCallback(const std::function<void()>& callback)
+	Command* Command::BindCallback(const Delegate<void()>& callback)
 	{
 		m_callback = callback;
 		return this;
 	}
 
-	Command* Command::BindStringCallback(const std::function<void(std::string)>& callback)
+	Command* Command::BindStringCallback(const Delegate<void(std::string)>& callback)
 	{
 		m_stringCallback = callback;
 		return this;
@@ -1049,6 +1049,13 @@ namespace CodeRed
 		{
 			CreateCommand("reset_setting", new Command(VariableIds::MANAGER_RESET_SETTING, "Reset a setting to its default/original value."))->BindStringCallback([&](const std::string& arguments) { ResetSetting(arguments); });
 			CreateCommand("unreal_command", new Command(VariableIds::MANAGER_UNREAL_COMMAND, "Execute a Unreal Engine 3 command with the given arguments."))->BindStringCallback([&](const std::string& arguments) { Manager.UnrealCommand(arguments); });
+			CreateCommand("events_profile", new Command(VariableIds::EVENTS_PROFILE, "Profile hooked functions and their callbacks, arguments are \"start\", \"stop\", \"reset\", or \"print [count]\"."))->BindStringCallback([&](const std::string& arguments) { Events.ProfileCommand(arguments); });
+			CreateCommand("events_trace", new Command(VariableIds::EVENTS_TRACE, "Record process event traffic to a binary trace file, arguments are \"start [file]\", \"stop\", or \"replay [file] [function]\"."))->BindStringCallback([&](const std::string& arguments) { Events.TraceCommand(arguments); });
+			CreateCommand("events_hooks", new Command(VariableIds::EVENTS_HOOKS, "Print every hooked function, along with each callbacks caller filter and how many calls it ran or skipped."))->SetNeedsArgs(false)->BindCallback([&]() { Events.PrintHooks(); });
+			CreateCommand("events_census", new Command(VariableIds::EVENTS_CENSUS, "Count every function going through process event to find hook candidates, arguments are \"start [sample rate]\", \"stop\", \"reset\", or \"print [count]\"."))->BindStringCallback([&](const std::string& arguments) { Events.CensusCommand(arguments); });
+			CreateCommand("events_detours", new Command(VariableIds::EVENTS_DETOURS, "Print every detour with how often it was hit and called its original function, along with its attach and enable time, arguments are \"print\" or \"reset\"."))->SetNeedsArgs(false)->BindStringCallback([&](const std::string& arguments) { Events.DetoursCommand(arguments); });
+			CreateCommand("instances_trigrams", new Command(VariableIds::INSTANCES_TRIGRAMS, "Build a trigram index of every objects name in the background to speed up substring searches, arguments are \"build\", \"clear\", or \"print\"."))->SetNeedsArgs(false)->BindStringCallback([&](const std::string& arguments) { Instances.TrigramCommand(arguments); });
+			CreateSetting("instances_scan_threads", new Setting(VariableIds::INSTANCES_SCAN_THREADS, SettingTypes::Int32, "Amount of threads used when scanning every object by name, zero uses one per core.", "0", true))->SetInt32Range(0, static_cast<int32_t>(INSTANCES_SCAN_MAX_THREADS))->BindCallback([&]() { Instances.SetScanThreads(static_cast<size_t>(GetSetting(VariableIds::INSTANCES_SCAN_THREADS)->GetInt32Value())); });
 
 			Console.Write(GetNameFormatted() + std::to_string(m_commands.size()) + " Command(s) Initialized!");
 			Console.Write(GetNameFormatted() + std::to_string(m_settings.size()) + " Setting(s) Initialized!");
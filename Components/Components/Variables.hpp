@@ -44,6 +44,17 @@ namespace CodeRed
 		MANAGER_RESET_SETTING,
 		MANAGER_UNREAL_COMMAND,
 
+		// Default events commands.
+		EVENTS_PROFILE,
+		EVENTS_TRACE,
+		EVENTS_HOOKS,
+		EVENTS_CENSUS,
+		EVENTS_DETOURS,
+
+		// Default instances commands and settings.
+		INSTANCES_TRIGRAMS,
+		INSTANCES_SCAN_THREADS,
+
 		// User created variables.
 		PLACEHOLDER_DO_THING,
 		PLACEHOLDER_ENABLED,
@@ -89,10 +100,10 @@ namespace CodeRed
 		std::map<VariableIds, bool> m_sharedSettings;			// Settings used as a reference in radio buttons.
 
 	private: // Callbacks.
-		std::function<void()> m_callback;						// Callback function if one is bound.
-		std::function<void(Setting*)> m_settingCallback;		// Optional callback containing a pointer to itself as an argument.
-		std::function<void(std::string)> m_stringCallback;		// Optional callback containing the settings new string value as an argument.
-		std::function<void(bool)> m_boolCallback;				// Optional callback containing the settings new bool value as an argument.
+		Delegate<void()> m_callback;							// Callback function if one is bound.
+		Delegate<void(Setting*)> m_settingCallback;				// Optional callback containing a pointer to itself as an argument.
+		Delegate<void(std::string)> m_stringCallback;			// Optional callback containing the settings new string value as an argument.
+		Delegate<void(bool)> m_boolCallback;					// Optional callback containing the settings new bool value as an argument.
 
 	public:
 		Setting() = delete;
@@ -170,10 +181,10 @@ namespace CodeRed
 		Setting* SetLocked(bool bLocked);
 		Setting* LockWithValue(const std::string& sValue);
 		Setting* UnbindCallbacks();
-		Setting* BindCallback(const std::function<void()>& callback);
-		Setting* BindSettingCallback(const std::function<void(Setting*)>& callback);
-		Setting* BindBoolCallback(const std::function<void(bool)>& callback);
-		Setting* BindStringCallback(const std::function<void(std::string)>& callback);
+		Setting* BindCallback(const Delegate<void()>& callback);
+		Setting* BindSettingCallback(const Delegate<void(Setting*)>& callback);
+		Setting* BindBoolCallback(const Delegate<void(bool)>& callback);
+		Setting* BindStringCallback(const Delegate<void(std::string)>& callback);
 		void TriggerCallbacks(bool bSkipSave = false);
 
 	public:
@@ -184,8 +195,8 @@ namespace CodeRed
 	{
 	private:
 		std::string m_description;								// Commands description.
-		std::function<void()> m_callback;						// Commands callback.
-		std::function<void(std::string)> m_stringCallback;		// Commands callback with string arguments.
+		Delegate<void()> m_callback;							// Commands callback.
+		Delegate<void(std::string)> m_stringCallback;			// Commands callback with string arguments.
 
 	public:
 		Command() = delete;
@@ -207,8 +218,8 @@ namespace CodeRed
 		Command* SetHidden(bool bHidden);
 		Command* SetLocked(bool bLocked);
 		Command* SetNeedsArgs(bool bNeedsArgs);
-		Command* BindCallback(const std::function<void()>& callback);
-		Command* BindStringCallback(const std::function<void(std::string)>& callback);
+		Command* BindCallback(const Delegate<void()>& callback);
+		Command* BindStringCallback(const Delegate<void(std::string)>& callback);
 		Command* UnbindCallbacks();
 
 	public:
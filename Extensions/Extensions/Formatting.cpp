@@ -444,6 +444,44 @@ namespace CodeRed::Format
         return (matches == matchStr.length());
     }
 
+    bool MatchWildcard(const std::string& str, const std::string& pattern)
+    {
+        size_t strPos = 0;
+        size_t patternPos = 0;
+        size_t starPos = std::string::npos;
+        size_t starMatch = 0;
+
+        while (strPos < str.length())
+        {
+            if ((patternPos < pattern.length()) && ((pattern[patternPos] == '?') || (pattern[patternPos] == str[strPos])))
+            {
+                strPos++;
+                patternPos++;
+            }
+            else if ((patternPos < pattern.length()) && (pattern[patternPos] == '*'))
+            {
+                starPos = patternPos++;
+                starMatch = strPos;
+            }
+            else if (starPos != std::string::npos)
+            {
+                patternPos = (starPos + 1);
+                strPos = ++starMatch;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while ((patternPos < pattern.length()) && (pattern[patternPos] == '*'))
+        {
+            patternPos++;
+        }
+
+        return (patternPos == pattern.length());
+    }
+
     std::vector<std::string> Split(const std::string& str, char character)
     {
         std::vector<std::string> splitStrings;
@@ -54,6 +54,7 @@ namespace CodeRed::Format
 	// Helper Functions.
 
 	bool StringSequenceMatches(const std::string& baseStr, const std::string& matchStr, size_t startPos);
+	bool MatchWildcard(const std::string& str, const std::string& pattern); // Supports "*" for any amount of characters and "?" for any single character.
 	std::vector<std::string> Split(const std::string& str, char character);
 	std::vector<std::string> SplitRange(const std::string& str, char from, char to, bool bIncludeChar);
 	template <typename T> void Shuffle(T& input)
@@ -0,0 +1,126 @@
+#include "AtomicBitset.hpp"
+
+namespace CodeRed
+{
+	BitsetBlock::BitsetBlock(size_t wordCount) : WordCount(wordCount), Words(std::make_unique<std::atomic<uint64_t>[]>(wordCount))
+	{
+		for (size_t i = 0; i < WordCount; i++)
+		{
+			Words[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	BitsetBlock::~BitsetBlock() {}
+
+	AtomicBitset::AtomicBitset() : m_block(nullptr) {}
+
+	AtomicBitset::~AtomicBitset()
+	{
+		m_block = nullptr;
+		m_blocks.clear();
+	}
+
+	bool AtomicBitset::Test(size_t index) const
+	{
+		const BitsetBlock* bitsetBlock = m_block.load(std::memory_order_acquire);
+		size_t bitWord = (index >> 6);
+
+		if (bitsetBlock && (bitWord < bitsetBlock->WordCount))
+		{
+			return (bitsetBlock->Words[bitWord].load(std::memory_order_relaxed) & (1ULL << (index & 63)));
+		}
+
+		return false;
+	}
+
+	size_t AtomicBitset::Count() const
+	{
+		size_t bitCount = 0;
+		const BitsetBlock* bitsetBlock = m_block.load(std::memory_order_acquire);
+
+		if (bitsetBlock)
+		{
+			for (size_t i = 0; i < bitsetBlock->WordCount; i++)
+			{
+				bitCount += std::popcount(bitsetBlock->Words[i].load(std::memory_order_relaxed));
+			}
+		}
+
+		return bitCount;
+	}
+
+	size_t AtomicBitset::Capacity() const
+	{
+		const BitsetBlock* bitsetBlock = m_block.load(std::memory_order_acquire);
+
+		if (bitsetBlock)
+		{
+			return (bitsetBlock->WordCount * 64);
+		}
+
+		return 0;
+	}
+
+	void AtomicBitset::Set(size_t index)
+	{
+		std::lock_guard<std::mutex> writeLock(m_writeMutex);
+		BitsetBlock* bitsetBlock = Grow((index >> 6) + 1);
+		bitsetBlock->Words[index >> 6].fetch_or((1ULL << (index & 63)), std::memory_order_release);
+	}
+
+	void AtomicBitset::Reset(size_t index)
+	{
+		std::lock_guard<std::mutex> writeLock(m_writeMutex);
+		BitsetBlock* bitsetBlock = m_block.load(std::memory_order_relaxed);
+
+		if (bitsetBlock && ((index >> 6) < bitsetBlock->WordCount))
+		{
+			bitsetBlock->Words[index >> 6].fetch_and(~(1ULL << (index & 63)), std::memory_order_release);
+		}
+	}
+
+	void AtomicBitset::Reserve(size_t bitCount)
+	{
+		std::lock_guard<std::mutex> writeLock(m_writeMutex);
+		Grow((bitCount + 63) >> 6);
+	}
+
+	void AtomicBitset::Clear()
+	{
+		std::lock_guard<std::mutex> writeLock(m_writeMutex);
+		BitsetBlock* bitsetBlock = m_block.load(std::memory_order_relaxed);
+
+		if (bitsetBlock)
+		{
+			for (size_t i = 0; i < bitsetBlock->WordCount; i++)
+			{
+				bitsetBlock->Words[i].store(0, std::memory_order_release);
+			}
+		}
+	}
+
+	BitsetBlock* AtomicBitset::Grow(size_t wordCount)
+	{
+		BitsetBlock* oldBlock = m_block.load(std::memory_order_relaxed);
+
+		if (oldBlock && (oldBlock->WordCount >= wordCount))
+		{
+			return oldBlock;
+		}
+
+		size_t newCount = (oldBlock ? std::max(wordCount, (oldBlock->WordCount * 2)) : wordCount); // Geometric growth keeps the amount of retired blocks small.
+		std::unique_ptr<BitsetBlock> newBlock = std::make_unique<BitsetBlock>(newCount);
+
+		if (oldBlock)
+		{
+			for (size_t i = 0; i < oldBlock->WordCount; i++)
+			{
+				newBlock->Words[i].store(oldBlock->Words[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+
+		m_block.store(newBlock.get(), std::memory_order_release);
+		m_blocks.push_back(std::move(newBlock));
+		return m_block.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	// Used exclusively by the "AtomicBitset" class, a fixed size block of words that gets replaced as a whole when the bitset grows.
+	class BitsetBlock
+	{
+	public:
+		size_t WordCount;
+		std::unique_ptr<std::atomic<uint64_t>[]> Words;
+
+	public:
+		BitsetBlock() = delete;
+		explicit BitsetBlock(size_t wordCount);
+		BitsetBlock(const BitsetBlock& bitsetBlock) = delete;
+		~BitsetBlock();
+
+	public:
+		BitsetBlock& operator=(const BitsetBlock& bitsetBlock) = delete;
+	};
+
+	// Growable bitset keyed by object index, readers never lock and can't see a torn word while another thread is writing or growing it.
+	class AtomicBitset
+	{
+	private:
+		std::atomic<BitsetBlock*> m_block; // Currently published block, only ever swapped as a whole.
+		std::vector<std::unique_ptr<BitsetBlock>> m_blocks; // Every block ever published, old ones are kept alive since readers might still be using them.
+		mutable std::mutex m_writeMutex; // Writers are serialized, readers never touch this.
+
+	public:
+		AtomicBitset();
+		AtomicBitset(const AtomicBitset& atomicBitset) = delete;
+		~AtomicBitset();
+
+	public:
+		bool Test(size_t index) const;
+		size_t Count() const;
+		size_t Capacity() const;
+
+	public:
+		void Set(size_t index);
+		void Reset(size_t index);
+		void Reserve(size_t bitCount);
+		void Clear();
+
+	private:
+		BitsetBlock* Grow(size_t wordCount); // Must be called while holding "m_writeMutex".
+
+	public:
+		AtomicBitset& operator=(const AtomicBitset& atomicBitset) = delete;
+	};
+}
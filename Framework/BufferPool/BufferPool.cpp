@@ -0,0 +1,100 @@
+#include "BufferPool.hpp"
+
+namespace CodeRed
+{
+	BufferPool::BufferPool() : m_allocations(0), m_reuses(0) {}
+
+	BufferPool::~BufferPool() { Clear(); }
+
+	uint64_t BufferPool::GetAllocations() const
+	{
+		return m_allocations.load(std::memory_order_relaxed);
+	}
+
+	uint64_t BufferPool::GetReuses() const
+	{
+		return m_reuses.load(std::memory_order_relaxed);
+	}
+
+	PooledBuffer BufferPool::Acquire(size_t size)
+	{
+		PooledBuffer pooledBuffer{ nullptr, static_cast<uint32_t>(size), GetSizeClass(size) };
+
+		if (pooledBuffer.SizeClass != BUFFER_POOL_UNPOOLED)
+		{
+			{
+				std::lock_guard<std::mutex> poolLock(m_poolMutex);
+				std::vector<uint8_t*>& freeBuffers = m_freeBuffers[pooledBuffer.SizeClass];
+
+				if (!freeBuffers.empty())
+				{
+					pooledBuffer.Data = freeBuffers.back();
+					freeBuffers.pop_back();
+				}
+			}
+
+			if (pooledBuffer.Data)
+			{
+				m_reuses.fetch_add(1, std::memory_order_relaxed);
+				return pooledBuffer;
+			}
+
+			pooledBuffer.Data = new uint8_t[BUFFER_POOL_MIN_SIZE << pooledBuffer.SizeClass];
+		}
+		else
+		{
+			pooledBuffer.Data = new uint8_t[size];
+		}
+
+		m_allocations.fetch_add(1, std::memory_order_relaxed);
+		return pooledBuffer;
+	}
+
+	void BufferPool::Release(const PooledBuffer& pooledBuffer)
+	{
+		if (pooledBuffer.Data)
+		{
+			if (pooledBuffer.SizeClass != BUFFER_POOL_UNPOOLED)
+			{
+				std::lock_guard<std::mutex> poolLock(m_poolMutex);
+				std::vector<uint8_t*>& freeBuffers = m_freeBuffers[pooledBuffer.SizeClass];
+
+				if (freeBuffers.size() < BUFFER_POOL_MAX_CACHED)
+				{
+					freeBuffers.push_back(pooledBuffer.Data);
+					return;
+				}
+			}
+
+			delete[] pooledBuffer.Data;
+		}
+	}
+
+	void BufferPool::Clear()
+	{
+		std::lock_guard<std::mutex> poolLock(m_poolMutex);
+
+		for (std::vector<uint8_t*>& freeBuffers : m_freeBuffers)
+		{
+			for (uint8_t* buffer : freeBuffers)
+			{
+				delete[] buffer;
+			}
+
+			freeBuffers.clear();
+		}
+	}
+
+	uint8_t BufferPool::GetSizeClass(size_t size)
+	{
+		for (uint8_t sizeClass = 0; sizeClass < BUFFER_POOL_CLASSES; sizeClass++)
+		{
+			if (size <= (BUFFER_POOL_MIN_SIZE << sizeClass))
+			{
+				return sizeClass;
+			}
+		}
+
+		return BUFFER_POOL_UNPOOLED;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t BUFFER_POOL_MIN_SIZE = 64;			// Smallest size class in bytes, each class after is double the previous one.
+	static constexpr size_t BUFFER_POOL_CLASSES = 8;			// Size classes from 64 bytes up to 8 kilobytes, anything larger isn't recycled.
+	static constexpr size_t BUFFER_POOL_MAX_CACHED = 256;		// Max free buffers kept per size class, extras are deleted when released.
+	static constexpr uint8_t BUFFER_POOL_UNPOOLED = 0xFF;
+
+	// A buffer given out by the "BufferPool" class, plain data so it can be captured and copied around freely until it's released.
+	struct PooledBuffer
+	{
+		uint8_t* Data;
+		uint32_t Size;		// Requested size, the actual allocation is rounded up to its size class.
+		uint8_t SizeClass;	// Size class the buffer is returned to, or "BUFFER_POOL_UNPOOLED".
+	};
+
+	// Recycles fixed size class buffers, so copying data for another thread doesn't hit the allocator every time.
+	class BufferPool
+	{
+	private:
+		std::mutex m_poolMutex;
+		std::array<std::vector<uint8_t*>, BUFFER_POOL_CLASSES> m_freeBuffers;
+		std::atomic<uint64_t> m_allocations;	// Buffers that had to be newly allocated.
+		std::atomic<uint64_t> m_reuses;			// Buffers that were recycled from a free list.
+
+	public:
+		BufferPool();
+		BufferPool(const BufferPool& bufferPool) = delete;
+		~BufferPool();
+
+	public:
+		uint64_t GetAllocations() const;
+		uint64_t GetReuses() const;
+		PooledBuffer Acquire(size_t size);
+		void Release(const PooledBuffer& pooledBuffer);
+		void Clear(); // Deletes every free buffer, buffers still acquired are unaffected.
+
+	private:
+		static uint8_t GetSizeClass(size_t size);
+
+	public:
+		BufferPool& operator=(const BufferPool& bufferPool) = delete;
+	};
+}
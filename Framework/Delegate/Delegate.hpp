@@ -0,0 +1,141 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t DELEGATE_STORAGE_SIZE = 64; // Max size of a bound callable in bytes, large enough for a handful of captures or a wrapped "std::function".
+
+	template <typename T> class Delegate;
+
+	// Non allocating replacement for "std::function", the bound callable is always stored inline so binding and calling never touch the heap.
+	// Callables larger than "DELEGATE_STORAGE_SIZE" fail to compile instead of silently falling back to an allocation.
+	template <typename R, typename... Args> class Delegate<R(Args...)>
+	{
+	private:
+		enum class StorageOps : uint8_t
+		{
+			Copy,
+			Destroy
+		};
+
+		typedef R(*InvokeFunc)(void*, Args...);
+		typedef void(*ManageFunc)(StorageOps, void*, const void*);
+
+	private:
+		alignas(std::max_align_t) mutable uint8_t m_storage[DELEGATE_STORAGE_SIZE];
+		InvokeFunc m_invoke;
+		ManageFunc m_manage; // Null for trivially copyable callables, so copying is a plain memcpy and nothing needs to be destroyed.
+
+	public:
+		Delegate() : m_invoke(nullptr), m_manage(nullptr) {}
+		Delegate(std::nullptr_t) : m_invoke(nullptr), m_manage(nullptr) {}
+		template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+		Delegate(F&& callable) : m_invoke(nullptr), m_manage(nullptr)
+		{
+			Bind(std::forward<F>(callable));
+		}
+		Delegate(const Delegate& delegate) : m_invoke(nullptr), m_manage(nullptr)
+		{
+			CopyFrom(delegate);
+		}
+		~Delegate()
+		{
+			Reset();
+		}
+
+	public:
+		template <typename F> static constexpr bool Fits = ((sizeof(std::decay_t<F>) <= DELEGATE_STORAGE_SIZE) && (alignof(std::decay_t<F>) <= alignof(std::max_align_t))); // If "Bind" would accept the callable's size and alignment.
+
+	public:
+		template <auto Method, typename T> static Delegate FromMethod(T* object) // Binds a member function without any type erased wrapper, "Delegate<void(PreEvent&)>::FromMethod<&HooksComponent::HUDPostRender>(&Hooks)".
+		{
+			return Delegate([object](Args... args) -> R { return (object->*Method)(std::forward<Args>(args)...); });
+		}
+
+		bool IsBound() const
+		{
+			return (m_invoke != nullptr);
+		}
+
+		template <typename F> void Bind(F&& callable)
+		{
+			typedef std::decay_t<F> Callable;
+			static_assert(sizeof(Callable) <= DELEGATE_STORAGE_SIZE, "Callable is too large for a delegate, capture less or capture by reference!");
+			static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over aligned for a delegate!");
+			static_assert(std::is_copy_constructible_v<Callable>, "Callable must be copy constructible!");
+
+			Reset();
+			new (m_storage) Callable(std::forward<F>(callable));
+			m_invoke = [](void* storage, Args... args) -> R { return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...); };
+
+			if constexpr (!std::is_trivially_copyable_v<Callable>)
+			{
+				m_manage = [](StorageOps storageOp, void* storage, const void* source) {
+					if (storageOp == StorageOps::Copy)
+					{
+						new (storage) Callable(*static_cast<const Callable*>(source));
+					}
+					else
+					{
+						static_cast<Callable*>(storage)->~Callable();
+					}
+				};
+			}
+		}
+
+		void Reset()
+		{
+			if (m_manage)
+			{
+				m_manage(StorageOps::Destroy, m_storage, nullptr);
+			}
+
+			m_invoke = nullptr;
+			m_manage = nullptr;
+		}
+
+	private:
+		void CopyFrom(const Delegate& delegate)
+		{
+			if (delegate.m_manage)
+			{
+				delegate.m_manage(StorageOps::Copy, m_storage, delegate.m_storage);
+			}
+			else if (delegate.m_invoke)
+			{
+				std::memcpy(m_storage, delegate.m_storage, DELEGATE_STORAGE_SIZE);
+			}
+
+			m_invoke = delegate.m_invoke;
+			m_manage = delegate.m_manage;
+		}
+
+	public:
+		R operator()(Args... args) const
+		{
+			return m_invoke(m_storage, std::forward<Args>(args)...);
+		}
+
+		explicit operator bool() const
+		{
+			return IsBound();
+		}
+
+		Delegate& operator=(const Delegate& delegate)
+		{
+			if (this != &delegate)
+			{
+				Reset();
+				CopyFrom(delegate);
+			}
+
+			return *this;
+		}
+
+		Delegate& operator=(std::nullptr_t)
+		{
+			Reset();
+			return *this;
+		}
+	};
+}
@@ -0,0 +1,126 @@
+#include "DispatchFrame.hpp"
+
+namespace CodeRed
+{
+	DispatchFrame::DispatchFrame(class UObject* caller, class UFunction* function) : m_isFirst(true)
+	{
+		size_t trackedDepth = std::min(m_depth, DISPATCH_MAX_DEPTH);
+
+		for (size_t i = trackedDepth; i > 0; i--) // Newest first, the duplicate is almost always the frame directly above.
+		{
+			const DispatchEntry& dispatchEntry = m_frames[i - 1];
+
+			if ((dispatchEntry.Caller == caller) && (dispatchEntry.Function == function))
+			{
+				m_isFirst = false;
+				break;
+			}
+		}
+
+		if (m_depth < DISPATCH_MAX_DEPTH)
+		{
+			m_frames[m_depth].Caller = caller;
+			m_frames[m_depth].Function = function;
+		}
+
+		m_depth++;
+	}
+
+	DispatchFrame::~DispatchFrame()
+	{
+		m_depth--;
+	}
+
+	bool DispatchFrame::IsFirst() const
+	{
+		return m_isFirst;
+	}
+
+	size_t DispatchFrame::GetDepth()
+	{
+		return m_depth;
+	}
+
+	size_t DispatchFrame::GetCount(class UObject* caller, class UFunction* function)
+	{
+		size_t frameCount = 0;
+		size_t trackedDepth = std::min(m_depth, DISPATCH_MAX_DEPTH);
+
+		for (size_t i = 0; i < trackedDepth; i++)
+		{
+			if ((m_frames[i].Caller == caller) && (m_frames[i].Function == function))
+			{
+				frameCount++;
+			}
+		}
+
+		return frameCount;
+	}
+
+	EventGuard::EventGuard() : m_caller(nullptr), m_function(nullptr), m_isFirst(false) {}
+
+	EventGuard::EventGuard(class UObject* caller, class UStruct* function) : m_caller(nullptr), m_function(nullptr), m_isFirst(false)
+	{
+		Store(caller, function);
+	}
+
+	EventGuard::EventGuard(class UObject* caller, class UFunction* function) : m_caller(nullptr), m_function(nullptr), m_isFirst(false)
+	{
+		Store(caller, function);
+	}
+
+	EventGuard::EventGuard(const EventGuard& eventGuard) : m_caller(eventGuard.m_caller), m_function(eventGuard.m_function), m_isFirst(eventGuard.m_isFirst) {}
+
+	EventGuard::~EventGuard() {}
+
+	class UObject* EventGuard::GetCaller() const
+	{
+		return m_caller;
+	}
+
+	class UFunction* EventGuard::GetFunction() const
+	{
+		return m_function;
+	}
+
+	bool EventGuard::IsFirst() const
+	{
+		return m_isFirst;
+	}
+
+	uint8_t EventGuard::GetRefs() const
+	{
+		return static_cast<uint8_t>(std::min<size_t>(DispatchFrame::GetCount(m_caller, m_function), UINT8_MAX));
+	}
+
+	void EventGuard::Store(class UObject* caller, class UStruct* function)
+	{
+		Store(caller, static_cast<UFunction*>(function));
+	}
+
+	void EventGuard::Store(class UObject* caller, class UFunction* function)
+	{
+		if (!m_frame && (caller || function))
+		{
+			m_caller = caller;
+			m_function = function;
+
+			if (caller && function)
+			{
+				m_frame.emplace(caller, function);
+				m_isFirst = m_frame->IsFirst();
+			}
+		}
+	}
+
+	void EventGuard::ClearRefStore() {}
+
+	EventGuard& EventGuard::operator=(const EventGuard& eventGuard)
+	{
+		m_frame.reset(); // Gives back our own frame first, the copied call is never tracked by this guard.
+		m_caller = eventGuard.m_caller;
+		m_function = eventGuard.m_function;
+		m_isFirst = eventGuard.m_isFirst;
+		return *this;
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t DISPATCH_MAX_DEPTH = 64; // Max nested dispatches tracked per thread, anything deeper is always treated as the first.
+
+	// Used exclusively by the "DispatchFrame" class, kept trivial so the thread local stack needs no initialization guard.
+	struct DispatchEntry
+	{
+		class UObject* Caller;
+		class UFunction* Function;
+	};
+
+	// Marks a caller and function as being dispatched on the current thread, so the same logical call seen again through another hook (such as ProcessEvent then ProcessInternal) is only dispatched once.
+	// Everything is stored in a thread local stack, there is no shared state or hashing, and only the frames currently active on this thread are compared.
+	class DispatchFrame
+	{
+	private:
+		static inline thread_local std::array<DispatchEntry, DISPATCH_MAX_DEPTH> m_frames{};
+		static inline thread_local size_t m_depth = 0;
+		bool m_isFirst;
+
+	public:
+		DispatchFrame() = delete;
+		DispatchFrame(class UObject* caller, class UFunction* function);
+		DispatchFrame(const DispatchFrame& dispatchFrame) = delete;
+		~DispatchFrame();
+
+	public:
+		bool IsFirst() const;
+		static size_t GetDepth();
+		static size_t GetCount(class UObject* caller, class UFunction* function); // Amount of frames on this thread for the caller and function, only the first "DISPATCH_MAX_DEPTH" frames are tracked.
+
+	public:
+		DispatchFrame& operator=(const DispatchFrame& dispatchFrame) = delete;
+	};
+
+	// Deprecated, use "DispatchFrame" instead. Only kept so existing code still compiles, it pushes a "DispatchFrame" and reads everything back from it.
+	// Like a scoped lock guards must go out of scope in the reverse order they were stored, which is always the case when they're only used as local variables.
+	class EventGuard
+	{
+	private:
+		std::optional<DispatchFrame> m_frame; // Only set for the guard that stored the call, copies never own a frame.
+		class UObject* m_caller;
+		class UFunction* m_function;
+		bool m_isFirst;
+
+	public:
+		EventGuard();
+		EventGuard(class UObject* caller, class UStruct* function);
+		EventGuard(class UObject* caller, class UFunction* function);
+		EventGuard(const EventGuard& eventGuard);
+		~EventGuard();
+
+	public:
+		class UObject* GetCaller() const;
+		class UFunction* GetFunction() const;
+		bool IsFirst() const;
+		uint8_t GetRefs() const; // Amount of frames on this thread for the same caller and function.
+
+	public:
+		void Store(class UObject* caller, class UStruct* function);
+		void Store(class UObject* caller, class UFunction* function); // Does nothing if this guard already stored a call.
+		static void ClearRefStore(); // Does nothing, frames are always removed once they go out of scope so there's nothing left to clear.
+
+	public:
+		EventGuard& operator=(const EventGuard& eventGuard);
+	};
+}
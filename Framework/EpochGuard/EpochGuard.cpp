@@ -0,0 +1,147 @@
+#include "EpochGuard.hpp"
+
+namespace CodeRed
+{
+	EpochRetired::EpochRetired() : Epoch(0), Deleter(nullptr) {}
+
+	EpochRetired::EpochRetired(uint64_t epoch, const std::function<void()>& deleter) : Epoch(epoch), Deleter(deleter) {}
+
+	EpochRetired::EpochRetired(const EpochRetired& epochRetired) : Epoch(epochRetired.Epoch), Deleter(epochRetired.Deleter) {}
+
+	EpochRetired::~EpochRetired() {}
+
+	EpochRetired& EpochRetired::operator=(const EpochRetired& epochRetired)
+	{
+		Epoch = epochRetired.Epoch;
+		Deleter = epochRetired.Deleter;
+		return *this;
+	}
+
+	EpochSlot::EpochSlot() : Index(-1), Depth(0) {}
+
+	EpochSlot::~EpochSlot()
+	{
+		EpochGuard::ReleaseSlot(Index);
+		Index = -1;
+	}
+
+	EpochGuard::EpochGuard()
+	{
+		EpochSlot& threadSlot = m_threadSlot;
+
+		if (threadSlot.Depth++ == 0)
+		{
+			if (threadSlot.Index < 0)
+			{
+				threadSlot.Index = ClaimSlot();
+			}
+
+			if (threadSlot.Index >= 0)
+			{
+				// Sequentially consistent so any pointer loaded after this is either visible to "Reclaim", or is already the newest one.
+				m_readerEpochs[threadSlot.Index].store(m_globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+			}
+			else
+			{
+				m_overflowReaders.fetch_add(1, std::memory_order_seq_cst);
+			}
+		}
+	}
+
+	EpochGuard::~EpochGuard()
+	{
+		EpochSlot& threadSlot = m_threadSlot;
+
+		if (--threadSlot.Depth == 0)
+		{
+			if (threadSlot.Index >= 0)
+			{
+				m_readerEpochs[threadSlot.Index].store(0, std::memory_order_release);
+			}
+			else
+			{
+				m_overflowReaders.fetch_sub(1, std::memory_order_release);
+			}
+		}
+	}
+
+	void EpochGuard::Retire(const std::function<void()>& deleter)
+	{
+		if (deleter)
+		{
+			{
+				std::lock_guard<std::mutex> retiredLock(m_retiredMutex);
+				m_retired.emplace_back(m_globalEpoch.fetch_add(1, std::memory_order_seq_cst), deleter); // Readers that announce after this point can only see the newly published pointer.
+			}
+
+			Reclaim();
+		}
+	}
+
+	size_t EpochGuard::Reclaim()
+	{
+		std::vector<EpochRetired> reclaimable;
+
+		{
+			std::lock_guard<std::mutex> retiredLock(m_retiredMutex);
+
+			if (m_retired.empty() || (m_overflowReaders.load(std::memory_order_seq_cst) > 0))
+			{
+				return 0;
+			}
+
+			uint64_t oldestEpoch = UINT64_MAX;
+
+			for (size_t i = 0; i < EPOCH_MAX_READERS; i++)
+			{
+				uint64_t readerEpoch = m_readerEpochs[i].load(std::memory_order_seq_cst);
+
+				if (readerEpoch && (readerEpoch < oldestEpoch))
+				{
+					oldestEpoch = readerEpoch;
+				}
+			}
+
+			auto retiredIt = std::partition(m_retired.begin(), m_retired.end(), [&](const EpochRetired& epochRetired) { return (epochRetired.Epoch >= oldestEpoch); });
+			reclaimable.assign(retiredIt, m_retired.end());
+			m_retired.erase(retiredIt, m_retired.end());
+		}
+
+		for (const EpochRetired& epochRetired : reclaimable)
+		{
+			epochRetired.Deleter(); // Called outside of the lock in case the deleter retires something itself.
+		}
+
+		return reclaimable.size();
+	}
+
+	size_t EpochGuard::GetRetiredCount()
+	{
+		std::lock_guard<std::mutex> retiredLock(m_retiredMutex);
+		return m_retired.size();
+	}
+
+	void EpochGuard::ReleaseSlot(int32_t slotIndex)
+	{
+		if ((slotIndex >= 0) && (slotIndex < static_cast<int32_t>(EPOCH_MAX_READERS)))
+		{
+			m_readerEpochs[slotIndex].store(0, std::memory_order_release);
+			m_readerClaimed[slotIndex].store(false, std::memory_order_release);
+		}
+	}
+
+	int32_t EpochGuard::ClaimSlot()
+	{
+		for (size_t i = 0; i < EPOCH_MAX_READERS; i++)
+		{
+			bool expected = false;
+
+			if (!m_readerClaimed[i].load(std::memory_order_relaxed) && m_readerClaimed[i].compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+			{
+				return static_cast<int32_t>(i);
+			}
+		}
+
+		return -1;
+	}
+}
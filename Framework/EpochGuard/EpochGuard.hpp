@@ -0,0 +1,78 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t EPOCH_MAX_READERS = 256; // Max amount of threads with their own reader slot, any extra threads share a single counter that pauses reclamation while they read.
+
+	// Used exclusively by the "EpochGuard" class, an unpublished object and the epoch it was retired in.
+	class EpochRetired
+	{
+	public:
+		uint64_t Epoch;
+		std::function<void()> Deleter;
+
+	public:
+		EpochRetired();
+		EpochRetired(uint64_t epoch, const std::function<void()>& deleter);
+		EpochRetired(const EpochRetired& epochRetired);
+		~EpochRetired();
+
+	public:
+		EpochRetired& operator=(const EpochRetired& epochRetired);
+	};
+
+	// Used exclusively by the "EpochGuard" class, each thread claims a reader slot the first time it reads and releases it when the thread exits.
+	class EpochSlot
+	{
+	public:
+		int32_t Index; // Reader slot for this thread, negative if it hasn't been claimed or none were available.
+		uint32_t Depth; // Nested guards on this thread, only the outermost one announces an epoch.
+
+	public:
+		EpochSlot();
+		EpochSlot(const EpochSlot& epochSlot) = delete;
+		~EpochSlot();
+
+	public:
+		EpochSlot& operator=(const EpochSlot& epochSlot) = delete;
+	};
+
+	// Epoch based reclamation for lock free snapshots, similar logic to a scoped lock except readers never wait on writers.
+	// Readers hold a guard while using a published pointer, writers swap the pointer and retire the old one which gets deleted once no reader can still see it.
+	class EpochGuard
+	{
+	private:
+		static inline std::atomic<uint64_t> m_globalEpoch = 1;
+		static inline std::array<std::atomic<uint64_t>, EPOCH_MAX_READERS> m_readerEpochs{}; // Epoch each reader slot announced when it started reading, zero if it isn't reading.
+		static inline std::array<std::atomic<bool>, EPOCH_MAX_READERS> m_readerClaimed{};
+		static inline std::atomic<uint32_t> m_overflowReaders = 0;
+		static inline std::mutex m_retiredMutex;
+		static inline std::vector<EpochRetired> m_retired;
+		static inline thread_local EpochSlot m_threadSlot;
+
+	public:
+		EpochGuard();
+		EpochGuard(const EpochGuard& epochGuard) = delete;
+		~EpochGuard();
+
+	public:
+		static void Retire(const std::function<void()>& deleter);
+		template <typename T> static void Retire(T* object)
+		{
+			if (object)
+			{
+				Retire([object]() { delete object; });
+			}
+		}
+		static size_t Reclaim(); // Deletes every retired object that no reader can see anymore, returns the amount deleted.
+		static size_t GetRetiredCount();
+		static void ReleaseSlot(int32_t slotIndex);
+
+	private:
+		static int32_t ClaimSlot();
+
+	public:
+		EpochGuard& operator=(const EpochGuard& epochGuard) = delete;
+	};
+}
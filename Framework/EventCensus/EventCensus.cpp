@@ -0,0 +1,187 @@
+#include "EventCensus.hpp"
+
+namespace CodeRed
+{
+	CensusCounters::CensusCounters() : m_size(0) {}
+
+	CensusCounters::~CensusCounters() {}
+
+	size_t CensusCounters::GetSize() const
+	{
+		return m_size;
+	}
+
+	uint64_t CensusCounters::GetCount(size_t objectIndex) const
+	{
+		if (objectIndex < m_size)
+		{
+			return m_counts[objectIndex].load(std::memory_order_relaxed);
+		}
+
+		return 0;
+	}
+
+	bool CensusCounters::NeedsGrow(size_t objectIndex) const
+	{
+		return (objectIndex >= m_size);
+	}
+
+	void CensusCounters::Grow(size_t objectIndex)
+	{
+		size_t newSize = std::max(CENSUS_MIN_COUNTERS, std::bit_ceil(objectIndex + 1));
+		std::unique_ptr<std::atomic<uint64_t>[]> newCounts = std::make_unique<std::atomic<uint64_t>[]>(newSize);
+
+		for (size_t i = 0; i < newSize; i++)
+		{
+			newCounts[i].store(((i < m_size) ? m_counts[i].load(std::memory_order_relaxed) : 0), std::memory_order_relaxed);
+		}
+
+		m_counts = std::move(newCounts);
+		m_size = newSize;
+	}
+
+	void CensusCounters::Increment(size_t objectIndex)
+	{
+		std::atomic<uint64_t>& counter = m_counts[objectIndex];
+		counter.store((counter.load(std::memory_order_relaxed) + 1), std::memory_order_relaxed); // Single writer, so this doesn't need to be a locked add.
+	}
+
+	void CensusCounters::Clear()
+	{
+		for (size_t i = 0; i < m_size; i++)
+		{
+			m_counts[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	CensusStore::CensusStore() {}
+
+	CensusStore::~CensusStore() {}
+
+	bool EventCensus::IsEnabled()
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	void EventCensus::Start(uint32_t sampleRate)
+	{
+		m_sampleRate.store(std::max(sampleRate, 1U), std::memory_order_relaxed);
+		m_enabled.store(true, std::memory_order_relaxed);
+	}
+
+	void EventCensus::Stop()
+	{
+		m_enabled.store(false, std::memory_order_relaxed);
+	}
+
+	void EventCensus::Reset()
+	{
+		std::lock_guard<std::mutex> storeLock(m_storeMutex);
+
+		for (const std::shared_ptr<CensusStore>& censusStore : m_stores)
+		{
+			std::lock_guard<std::mutex> threadLock(censusStore->Mutex);
+			censusStore->Functions.Clear();
+			censusStore->Classes.Clear();
+		}
+	}
+
+	uint32_t EventCensus::GetSampleRate()
+	{
+		return m_sampleRate.load(std::memory_order_relaxed);
+	}
+
+	void EventCensus::Record(uint64_t functionIndex, uint64_t classIndex)
+	{
+		static thread_local uint32_t sampleCounter = 0;
+		uint32_t sampleRate = m_sampleRate.load(std::memory_order_relaxed);
+
+		if ((sampleRate > 1) && ((++sampleCounter % sampleRate) != 0))
+		{
+			return;
+		}
+
+		CensusStore& censusStore = GetThreadStore();
+
+		if (censusStore.Functions.NeedsGrow(functionIndex) || censusStore.Classes.NeedsGrow(classIndex))
+		{
+			std::lock_guard<std::mutex> threadLock(censusStore.Mutex);
+
+			if (censusStore.Functions.NeedsGrow(functionIndex))
+			{
+				censusStore.Functions.Grow(functionIndex);
+			}
+
+			if (censusStore.Classes.NeedsGrow(classIndex))
+			{
+				censusStore.Classes.Grow(classIndex);
+			}
+		}
+
+		censusStore.Functions.Increment(functionIndex);
+		censusStore.Classes.Increment(classIndex);
+	}
+
+	std::vector<CensusEntry> EventCensus::GetFunctions()
+	{
+		return MergeCounters(&CensusStore::Functions);
+	}
+
+	std::vector<CensusEntry> EventCensus::GetClasses()
+	{
+		return MergeCounters(&CensusStore::Classes);
+	}
+
+	CensusStore& EventCensus::GetThreadStore()
+	{
+		// Kept alive by "m_stores" after the thread exits, so its counts still show up in the report.
+		static thread_local std::shared_ptr<CensusStore> threadStore;
+
+		if (!threadStore)
+		{
+			threadStore = std::make_shared<CensusStore>();
+			std::lock_guard<std::mutex> storeLock(m_storeMutex);
+			m_stores.push_back(threadStore);
+		}
+
+		return *threadStore;
+	}
+
+	std::vector<CensusEntry> EventCensus::MergeCounters(CensusCounters CensusStore::* counters)
+	{
+		std::vector<uint64_t> mergedCounts;
+
+		{
+			std::lock_guard<std::mutex> storeLock(m_storeMutex);
+
+			for (const std::shared_ptr<CensusStore>& censusStore : m_stores)
+			{
+				std::lock_guard<std::mutex> threadLock(censusStore->Mutex);
+				const CensusCounters& threadCounters = ((*censusStore).*counters);
+
+				if (mergedCounts.size() < threadCounters.GetSize())
+				{
+					mergedCounts.resize(threadCounters.GetSize(), 0);
+				}
+
+				for (size_t i = 0; i < threadCounters.GetSize(); i++)
+				{
+					mergedCounts[i] += threadCounters.GetCount(i);
+				}
+			}
+		}
+
+		std::vector<CensusEntry> censusEntries;
+
+		for (size_t i = 0; i < mergedCounts.size(); i++)
+		{
+			if (mergedCounts[i] > 0)
+			{
+				censusEntries.push_back(CensusEntry{ i, mergedCounts[i] });
+			}
+		}
+
+		std::sort(censusEntries.begin(), censusEntries.end(), [](const CensusEntry& a, const CensusEntry& b) { return (a.Count > b.Count); });
+		return censusEntries;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t CENSUS_MIN_COUNTERS = 4096; // Initial amount of counters per thread, grows to the next power of two past the highest object index seen.
+
+	// Amount of calls counted for a single function or caller class.
+	struct CensusEntry
+	{
+		uint64_t ObjectIndex;	// The function or class "ObjectInternalInteger".
+		uint64_t Count;			// Calls that were sampled, multiply by the sample rate for an estimate of the real amount.
+	};
+
+	// Flat counter array indexed by object index, only the owning thread ever increments it.
+	class CensusCounters
+	{
+	private:
+		std::unique_ptr<std::atomic<uint64_t>[]> m_counts; // Atomic only so other threads can read them without tearing, increments are a plain load and store.
+		size_t m_size;
+
+	public:
+		CensusCounters();
+		CensusCounters(const CensusCounters& censusCounters) = delete;
+		~CensusCounters();
+
+	public:
+		size_t GetSize() const;
+		uint64_t GetCount(size_t objectIndex) const;
+		bool NeedsGrow(size_t objectIndex) const;
+		void Grow(size_t objectIndex); // Must be holding the owning stores mutex, so readers never see the old array being freed.
+		void Increment(size_t objectIndex); // Only called by the owning thread, after "NeedsGrow" returned false.
+		void Clear();
+
+	public:
+		CensusCounters& operator=(const CensusCounters& censusCounters) = delete;
+	};
+
+	// Used exclusively by the "EventCensus" class, each thread counts into its own store so game threads never wait on each other.
+	class CensusStore
+	{
+	public:
+		std::mutex Mutex; // Only taken when growing, reading, or clearing the counters.
+		CensusCounters Functions;
+		CensusCounters Classes;
+
+	public:
+		CensusStore();
+		CensusStore(const CensusStore& censusStore) = delete;
+		~CensusStore();
+
+	public:
+		CensusStore& operator=(const CensusStore& censusStore) = delete;
+	};
+
+	// Counts every function dispatched through the detours, used to find out which functions and caller classes are the hottest before hooking them.
+	// When it's disabled the only cost is a single relaxed load, when enabled a sampled call is two counter increments on the calling thread.
+	class EventCensus
+	{
+	private:
+		static inline std::atomic<bool> m_enabled = false;
+		static inline std::atomic<uint32_t> m_sampleRate = 1; // Only every Nth call per thread is counted, one counts every call.
+		static inline std::mutex m_storeMutex;
+		static inline std::vector<std::shared_ptr<CensusStore>> m_stores; // Every thread that has counted something, merged only when a report is requested.
+
+	public:
+		EventCensus() = delete;
+		EventCensus(const EventCensus& eventCensus) = delete;
+		~EventCensus() = delete;
+
+	public:
+		static bool IsEnabled();
+		static void Start(uint32_t sampleRate);
+		static void Stop();
+		static void Reset();
+		static uint32_t GetSampleRate();
+		static void Record(uint64_t functionIndex, uint64_t classIndex);
+		static std::vector<CensusEntry> GetFunctions(); // Merged from every thread, sorted by the most calls.
+		static std::vector<CensusEntry> GetClasses();
+
+	private:
+		static CensusStore& GetThreadStore();
+		static std::vector<CensusEntry> MergeCounters(CensusCounters CensusStore::* counters);
+
+	public:
+		EventCensus& operator=(const EventCensus& eventCensus) = delete;
+	};
+}
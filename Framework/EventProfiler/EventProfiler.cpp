@@ -0,0 +1,251 @@
+#include "EventProfiler.hpp"
+
+namespace CodeRed
+{
+	ProfileSample::ProfileSample() : Calls(0), TotalTime(0), MinTime(UINT64_MAX), MaxTime(0), Histogram{} {}
+
+	ProfileSample::ProfileSample(const ProfileSample& profileSample) :
+		Calls(profileSample.Calls),
+		TotalTime(profileSample.TotalTime),
+		MinTime(profileSample.MinTime),
+		MaxTime(profileSample.MaxTime),
+		Histogram(profileSample.Histogram)
+	{
+
+	}
+
+	ProfileSample::~ProfileSample() {}
+
+	uint64_t ProfileSample::GetAverageTime() const
+	{
+		if (Calls > 0)
+		{
+			return (TotalTime / Calls);
+		}
+
+		return 0;
+	}
+
+	void ProfileSample::AddTime(uint64_t elapsedTime)
+	{
+		Calls++;
+		TotalTime += elapsedTime;
+		MinTime = std::min(MinTime, elapsedTime);
+		MaxTime = std::max(MaxTime, elapsedTime);
+		Histogram[GetBucket(elapsedTime)]++;
+	}
+
+	void ProfileSample::Merge(const ProfileSample& profileSample)
+	{
+		Calls += profileSample.Calls;
+		TotalTime += profileSample.TotalTime;
+		MinTime = std::min(MinTime, profileSample.MinTime);
+		MaxTime = std::max(MaxTime, profileSample.MaxTime);
+
+		for (size_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++)
+		{
+			Histogram[i] += profileSample.Histogram[i];
+		}
+	}
+
+	size_t ProfileSample::GetBucket(uint64_t elapsedTime)
+	{
+		size_t bucket = static_cast<size_t>(std::bit_width(elapsedTime >> 7)); // Zero for anything under 128 nanoseconds, then doubles with each bucket.
+		return std::min(bucket, (PROFILER_HISTOGRAM_BUCKETS - 1));
+	}
+
+	uint64_t ProfileSample::GetBucketLimit(size_t bucket)
+	{
+		if (bucket < (PROFILER_HISTOGRAM_BUCKETS - 1))
+		{
+			return (128ULL << bucket);
+		}
+
+		return UINT64_MAX;
+	}
+
+	ProfileSample& ProfileSample::operator=(const ProfileSample& profileSample)
+	{
+		Calls = profileSample.Calls;
+		TotalTime = profileSample.TotalTime;
+		MinTime = profileSample.MinTime;
+		MaxTime = profileSample.MaxTime;
+		Histogram = profileSample.Histogram;
+		return *this;
+	}
+
+	FunctionProfile::FunctionProfile() : FunctionIndex(0) {}
+
+	FunctionProfile::FunctionProfile(uint64_t functionIndex) : FunctionIndex(functionIndex) {}
+
+	FunctionProfile::FunctionProfile(const FunctionProfile& functionProfile) :
+		FunctionIndex(functionProfile.FunctionIndex),
+		PreHooks(functionProfile.PreHooks),
+		PostHooks(functionProfile.PostHooks)
+	{
+
+	}
+
+	FunctionProfile::~FunctionProfile() {}
+
+	uint64_t FunctionProfile::GetTotalTime() const
+	{
+		return (PreHooks.TotalTime + PostHooks.TotalTime);
+	}
+
+	FunctionProfile& FunctionProfile::operator=(const FunctionProfile& functionProfile)
+	{
+		FunctionIndex = functionProfile.FunctionIndex;
+		PreHooks = functionProfile.PreHooks;
+		PostHooks = functionProfile.PostHooks;
+		return *this;
+	}
+
+	HookProfile::HookProfile() : HookId(0), FunctionIndex(0), bPostHook(false) {}
+
+	HookProfile::HookProfile(uint32_t hookId, uint64_t functionIndex, bool bPost) : HookId(hookId), FunctionIndex(functionIndex), bPostHook(bPost) {}
+
+	HookProfile::HookProfile(const HookProfile& hookProfile) :
+		HookId(hookProfile.HookId),
+		FunctionIndex(hookProfile.FunctionIndex),
+		bPostHook(hookProfile.bPostHook),
+		Sample(hookProfile.Sample)
+	{
+
+	}
+
+	HookProfile::~HookProfile() {}
+
+	HookProfile& HookProfile::operator=(const HookProfile& hookProfile)
+	{
+		HookId = hookProfile.HookId;
+		FunctionIndex = hookProfile.FunctionIndex;
+		bPostHook = hookProfile.bPostHook;
+		Sample = hookProfile.Sample;
+		return *this;
+	}
+
+	ProfilerStore::ProfilerStore() {}
+
+	ProfilerStore::~ProfilerStore() {}
+
+	bool EventProfiler::IsEnabled()
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	void EventProfiler::SetEnabled(bool bEnabled)
+	{
+		m_enabled.store(bEnabled, std::memory_order_relaxed);
+	}
+
+	void EventProfiler::Reset()
+	{
+		std::lock_guard<std::mutex> storeLock(m_storeMutex);
+
+		for (const std::shared_ptr<ProfilerStore>& profilerStore : m_stores)
+		{
+			std::lock_guard<std::mutex> threadLock(profilerStore->Mutex);
+			profilerStore->Functions.clear();
+			profilerStore->Hooks.clear();
+		}
+	}
+
+	uint64_t EventProfiler::GetTimestamp()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	void EventProfiler::RecordFunction(uint64_t functionIndex, bool bPost, uint64_t elapsedTime)
+	{
+		ProfilerStore& profilerStore = GetThreadStore();
+		std::lock_guard<std::mutex> threadLock(profilerStore.Mutex);
+		auto functionIt = profilerStore.Functions.try_emplace(functionIndex, functionIndex).first;
+		(bPost ? functionIt->second.PostHooks : functionIt->second.PreHooks).AddTime(elapsedTime);
+	}
+
+	void EventProfiler::RecordHook(uint32_t hookId, uint64_t functionIndex, bool bPost, uint64_t elapsedTime)
+	{
+		ProfilerStore& profilerStore = GetThreadStore();
+		std::lock_guard<std::mutex> threadLock(profilerStore.Mutex);
+		profilerStore.Hooks.try_emplace(hookId, hookId, functionIndex, bPost).first->second.Sample.AddTime(elapsedTime);
+	}
+
+	std::vector<FunctionProfile> EventProfiler::GetFunctions()
+	{
+		std::unordered_map<uint64_t, FunctionProfile> mergedFunctions;
+
+		{
+			std::lock_guard<std::mutex> storeLock(m_storeMutex);
+
+			for (const std::shared_ptr<ProfilerStore>& profilerStore : m_stores)
+			{
+				std::lock_guard<std::mutex> threadLock(profilerStore->Mutex);
+
+				for (const auto& functionPair : profilerStore->Functions)
+				{
+					FunctionProfile& functionProfile = mergedFunctions.try_emplace(functionPair.first, functionPair.first).first->second;
+					functionProfile.PreHooks.Merge(functionPair.second.PreHooks);
+					functionProfile.PostHooks.Merge(functionPair.second.PostHooks);
+				}
+			}
+		}
+
+		std::vector<FunctionProfile> functionProfiles;
+		functionProfiles.reserve(mergedFunctions.size());
+
+		for (const auto& functionPair : mergedFunctions)
+		{
+			functionProfiles.push_back(functionPair.second);
+		}
+
+		std::sort(functionProfiles.begin(), functionProfiles.end(), [](const FunctionProfile& a, const FunctionProfile& b) { return (a.GetTotalTime() > b.GetTotalTime()); });
+		return functionProfiles;
+	}
+
+	std::vector<HookProfile> EventProfiler::GetHooks()
+	{
+		std::unordered_map<uint32_t, HookProfile> mergedHooks;
+
+		{
+			std::lock_guard<std::mutex> storeLock(m_storeMutex);
+
+			for (const std::shared_ptr<ProfilerStore>& profilerStore : m_stores)
+			{
+				std::lock_guard<std::mutex> threadLock(profilerStore->Mutex);
+
+				for (const auto& hookPair : profilerStore->Hooks)
+				{
+					const HookProfile& threadProfile = hookPair.second;
+					mergedHooks.try_emplace(hookPair.first, threadProfile.HookId, threadProfile.FunctionIndex, threadProfile.bPostHook).first->second.Sample.Merge(threadProfile.Sample);
+				}
+			}
+		}
+
+		std::vector<HookProfile> hookProfiles;
+		hookProfiles.reserve(mergedHooks.size());
+
+		for (const auto& hookPair : mergedHooks)
+		{
+			hookProfiles.push_back(hookPair.second);
+		}
+
+		std::sort(hookProfiles.begin(), hookProfiles.end(), [](const HookProfile& a, const HookProfile& b) { return (a.Sample.TotalTime > b.Sample.TotalTime); });
+		return hookProfiles;
+	}
+
+	ProfilerStore& EventProfiler::GetThreadStore()
+	{
+		// Kept alive by "m_stores" after the thread exits, so its samples still show up in the report.
+		static thread_local std::shared_ptr<ProfilerStore> threadStore;
+
+		if (!threadStore)
+		{
+			threadStore = std::make_shared<ProfilerStore>();
+			std::lock_guard<std::mutex> storeLock(m_storeMutex);
+			m_stores.push_back(threadStore);
+		}
+
+		return *threadStore;
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t PROFILER_HISTOGRAM_BUCKETS = 16; // Power of two latency buckets, the first one is everything under 128 nanoseconds and the last one is everything over 2 milliseconds.
+
+	// Timing information for a single function or hook, all times are in nanoseconds.
+	class ProfileSample
+	{
+	public:
+		uint64_t Calls;
+		uint64_t TotalTime;
+		uint64_t MinTime;
+		uint64_t MaxTime;
+		std::array<uint64_t, PROFILER_HISTOGRAM_BUCKETS> Histogram;
+
+	public:
+		ProfileSample();
+		ProfileSample(const ProfileSample& profileSample);
+		~ProfileSample();
+
+	public:
+		uint64_t GetAverageTime() const;
+		void AddTime(uint64_t elapsedTime);
+		void Merge(const ProfileSample& profileSample);
+		static size_t GetBucket(uint64_t elapsedTime);
+		static uint64_t GetBucketLimit(size_t bucket); // Upper bound of the given bucket in nanoseconds.
+
+	public:
+		ProfileSample& operator=(const ProfileSample& profileSample);
+	};
+
+	// Aggregated timing of every pre or post callback that ran for a hooked function.
+	class FunctionProfile
+	{
+	public:
+		uint64_t FunctionIndex;
+		ProfileSample PreHooks;
+		ProfileSample PostHooks;
+
+	public:
+		FunctionProfile();
+		FunctionProfile(uint64_t functionIndex);
+		FunctionProfile(const FunctionProfile& functionProfile);
+		~FunctionProfile();
+
+	public:
+		uint64_t GetTotalTime() const;
+
+	public:
+		FunctionProfile& operator=(const FunctionProfile& functionProfile);
+	};
+
+	// Timing of a single bound callback, identified by the id returned from "HookEventPre" or "HookEventPost".
+	class HookProfile
+	{
+	public:
+		uint32_t HookId;
+		uint64_t FunctionIndex;
+		bool bPostHook;
+		ProfileSample Sample;
+
+	public:
+		HookProfile();
+		HookProfile(uint32_t hookId, uint64_t functionIndex, bool bPost);
+		HookProfile(const HookProfile& hookProfile);
+		~HookProfile();
+
+	public:
+		HookProfile& operator=(const HookProfile& hookProfile);
+	};
+
+	// Used exclusively by the "EventProfiler" class, each thread records into its own store so game threads never wait on each other.
+	class ProfilerStore
+	{
+	public:
+		std::mutex Mutex; // Only contended while the profiler is aggregating or resetting.
+		std::unordered_map<uint64_t, FunctionProfile> Functions;
+		std::unordered_map<uint32_t, HookProfile> Hooks;
+
+	public:
+		ProfilerStore();
+		ProfilerStore(const ProfilerStore& profilerStore) = delete;
+		~ProfilerStore();
+
+	public:
+		ProfilerStore& operator=(const ProfilerStore& profilerStore) = delete;
+	};
+
+	// Opt in latency profiler for event hooks, when it's disabled the only cost is a single relaxed load in "ProcessBefore" and "ProcessAfter".
+	class EventProfiler
+	{
+	private:
+		static inline std::atomic<bool> m_enabled = false;
+		static inline std::mutex m_storeMutex;
+		static inline std::vector<std::shared_ptr<ProfilerStore>> m_stores; // Every thread that has recorded something, aggregated only when a report is requested.
+
+	public:
+		EventProfiler() = delete;
+		EventProfiler(const EventProfiler& eventProfiler) = delete;
+		~EventProfiler() = delete;
+
+	public:
+		static bool IsEnabled();
+		static void SetEnabled(bool bEnabled);
+		static void Reset();
+		static uint64_t GetTimestamp();
+		static void RecordFunction(uint64_t functionIndex, bool bPost, uint64_t elapsedTime);
+		static void RecordHook(uint32_t hookId, uint64_t functionIndex, bool bPost, uint64_t elapsedTime);
+		static std::vector<FunctionProfile> GetFunctions(); // Merged from every thread, sorted by the most total time spent.
+		static std::vector<HookProfile> GetHooks();
+
+	private:
+		static ProfilerStore& GetThreadStore();
+
+	public:
+		EventProfiler& operator=(const EventProfiler& eventProfiler) = delete;
+	};
+}
@@ -0,0 +1,271 @@
+#include "EventRecorder.hpp"
+
+namespace CodeRed
+{
+	RecorderRing::RecorderRing(uint32_t threadId) :
+		ThreadId(threadId),
+		Head(0),
+		Tail(0),
+		Dropped(0),
+		Records(std::make_unique<EventRecord[]>(RECORDER_RING_SIZE))
+	{
+
+	}
+
+	RecorderRing::~RecorderRing() {}
+
+	bool RecorderRing::Push(const EventRecord& eventRecord)
+	{
+		uint64_t head = Head.load(std::memory_order_relaxed);
+
+		if ((head - Tail.load(std::memory_order_acquire)) >= RECORDER_RING_SIZE)
+		{
+			Dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		Records[head & (RECORDER_RING_SIZE - 1)] = eventRecord;
+		Head.store((head + 1), std::memory_order_release); // Publishes the record to the drain thread.
+		return true;
+	}
+
+	size_t RecorderRing::Drain(std::vector<EventRecord>& eventRecords)
+	{
+		uint64_t tail = Tail.load(std::memory_order_relaxed);
+		uint64_t head = Head.load(std::memory_order_acquire);
+
+		for (uint64_t i = tail; i < head; i++)
+		{
+			eventRecords.push_back(Records[i & (RECORDER_RING_SIZE - 1)]);
+		}
+
+		Tail.store(head, std::memory_order_release); // Gives the slots back to the owning thread.
+		return static_cast<size_t>(head - tail);
+	}
+
+	TraceFilter::TraceFilter() : ThreadId(0), EventType(0), StartTime(0), EndTime(0) {}
+
+	TraceFilter::TraceFilter(const TraceFilter& traceFilter) :
+		FunctionIndexes(traceFilter.FunctionIndexes),
+		ThreadId(traceFilter.ThreadId),
+		EventType(traceFilter.EventType),
+		StartTime(traceFilter.StartTime),
+		EndTime(traceFilter.EndTime)
+	{
+
+	}
+
+	TraceFilter::~TraceFilter() {}
+
+	bool TraceFilter::Matches(const EventRecord& eventRecord) const
+	{
+		if (ThreadId && (eventRecord.ThreadId != ThreadId))
+		{
+			return false;
+		}
+		else if (EventType && (eventRecord.EventType != EventType))
+		{
+			return false;
+		}
+		else if ((eventRecord.Timestamp < StartTime) || (EndTime && (eventRecord.Timestamp > EndTime)))
+		{
+			return false;
+		}
+		else if (!FunctionIndexes.empty())
+		{
+			return (std::find(FunctionIndexes.begin(), FunctionIndexes.end(), eventRecord.FunctionIndex) != FunctionIndexes.end());
+		}
+
+		return true;
+	}
+
+	TraceFilter& TraceFilter::operator=(const TraceFilter& traceFilter)
+	{
+		FunctionIndexes = traceFilter.FunctionIndexes;
+		ThreadId = traceFilter.ThreadId;
+		EventType = traceFilter.EventType;
+		StartTime = traceFilter.StartTime;
+		EndTime = traceFilter.EndTime;
+		return *this;
+	}
+
+	bool EventRecorder::IsRecording()
+	{
+		return m_recording.load(std::memory_order_relaxed);
+	}
+
+	bool EventRecorder::Start(const std::filesystem::path& filePath)
+	{
+		std::lock_guard<std::mutex> controlLock(m_controlMutex);
+
+		if (!m_draining)
+		{
+			m_traceFile.open(filePath, std::ios::binary | std::ios::trunc);
+
+			if (m_traceFile.is_open())
+			{
+				{
+					std::lock_guard<std::mutex> ringLock(m_ringMutex);
+					m_rings.clear(); // Threads still holding a ring from the last recording register a new one when they see the generation change.
+				}
+
+				TraceHeader traceHeader{};
+				traceHeader.Magic = RECORDER_TRACE_MAGIC;
+				traceHeader.Version = RECORDER_TRACE_VERSION;
+				traceHeader.RecordSize = static_cast<uint32_t>(sizeof(EventRecord));
+				traceHeader.StartTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+				m_traceFile.write(reinterpret_cast<const char*>(&traceHeader), sizeof(TraceHeader));
+
+				m_recordsWritten = 0;
+				m_startTime.store(traceHeader.StartTime, std::memory_order_relaxed);
+				m_generation.fetch_add(1, std::memory_order_release);
+				m_draining = true;
+				m_drainThread = std::thread(&EventRecorder::DrainThread);
+				m_recording.store(true, std::memory_order_release);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	uint64_t EventRecorder::Stop()
+	{
+		std::lock_guard<std::mutex> controlLock(m_controlMutex);
+
+		if (m_draining)
+		{
+			m_recording.store(false, std::memory_order_release);
+			m_draining = false;
+
+			if (m_drainThread.joinable())
+			{
+				m_drainThread.join(); // Does one last drain before returning.
+			}
+
+			m_traceFile.close();
+		}
+
+		return m_recordsWritten;
+	}
+
+	uint64_t EventRecorder::GetDroppedCount()
+	{
+		uint64_t droppedRecords = 0;
+		std::lock_guard<std::mutex> ringLock(m_ringMutex);
+
+		for (const std::shared_ptr<RecorderRing>& recorderRing : m_rings)
+		{
+			droppedRecords += recorderRing->Dropped.load(std::memory_order_relaxed);
+		}
+
+		return droppedRecords;
+	}
+
+	void EventRecorder::Record(uint64_t caller, uint64_t functionIndex, uint8_t eventType, uint32_t paramsSize)
+	{
+		EventRecord eventRecord{};
+		RecorderRing& recorderRing = GetThreadRing();
+		eventRecord.Timestamp = (static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()) - m_startTime.load(std::memory_order_relaxed));
+		eventRecord.Caller = caller;
+		eventRecord.FunctionIndex = functionIndex;
+		eventRecord.ThreadId = recorderRing.ThreadId;
+		eventRecord.ParamsSize = paramsSize;
+		eventRecord.EventType = eventType;
+		recorderRing.Push(eventRecord);
+	}
+
+	bool EventRecorder::ReadTrace(const std::filesystem::path& filePath, std::vector<EventRecord>& eventRecords, const TraceFilter& traceFilter)
+	{
+		std::ifstream traceFile(filePath, std::ios::binary);
+
+		if (traceFile.is_open())
+		{
+			TraceHeader traceHeader{};
+
+			if (traceFile.read(reinterpret_cast<char*>(&traceHeader), sizeof(TraceHeader))
+				&& (traceHeader.Magic == RECORDER_TRACE_MAGIC)
+				&& (traceHeader.Version == RECORDER_TRACE_VERSION)
+				&& (traceHeader.RecordSize == sizeof(EventRecord)))
+			{
+				std::vector<EventRecord> readBuffer(RECORDER_RING_SIZE);
+
+				while (traceFile)
+				{
+					traceFile.read(reinterpret_cast<char*>(readBuffer.data()), (readBuffer.size() * sizeof(EventRecord)));
+					size_t recordsRead = (static_cast<size_t>(traceFile.gcount()) / sizeof(EventRecord)); // A truncated last record is ignored.
+
+					for (size_t i = 0; i < recordsRead; i++)
+					{
+						if (traceFilter.Matches(readBuffer[i]))
+						{
+							eventRecords.push_back(readBuffer[i]);
+						}
+					}
+				}
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	RecorderRing& EventRecorder::GetThreadRing()
+	{
+		static thread_local std::shared_ptr<RecorderRing> threadRing;
+		static thread_local uint64_t threadGeneration = 0;
+		uint64_t generation = m_generation.load(std::memory_order_acquire);
+
+		if (!threadRing || (threadGeneration != generation))
+		{
+			threadRing = std::make_shared<RecorderRing>(static_cast<uint32_t>(GetCurrentThreadId()));
+			threadGeneration = generation;
+			std::lock_guard<std::mutex> ringLock(m_ringMutex);
+			m_rings.push_back(threadRing);
+		}
+
+		return *threadRing;
+	}
+
+	size_t EventRecorder::DrainRings(std::vector<EventRecord>& eventRecords)
+	{
+		size_t recordsDrained = 0;
+		std::lock_guard<std::mutex> ringLock(m_ringMutex); // Only blocks threads registering a new ring, pushing never takes this lock.
+
+		for (const std::shared_ptr<RecorderRing>& recorderRing : m_rings)
+		{
+			recordsDrained += recorderRing->Drain(eventRecords);
+		}
+
+		return recordsDrained;
+	}
+
+	void EventRecorder::DrainThread()
+	{
+		std::vector<EventRecord> eventRecords;
+		eventRecords.reserve(RECORDER_RING_SIZE);
+
+		while (m_draining)
+		{
+			if (DrainRings(eventRecords) > 0)
+			{
+				m_traceFile.write(reinterpret_cast<const char*>(eventRecords.data()), (eventRecords.size() * sizeof(EventRecord)));
+				m_recordsWritten += eventRecords.size();
+				eventRecords.clear();
+			}
+			else
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			}
+		}
+
+		if (DrainRings(eventRecords) > 0)
+		{
+			m_traceFile.write(reinterpret_cast<const char*>(eventRecords.data()), (eventRecords.size() * sizeof(EventRecord)));
+			m_recordsWritten += eventRecords.size();
+		}
+
+		m_traceFile.flush();
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t RECORDER_RING_SIZE = 8192; // Records each thread can buffer before the drain thread catches up, must be a power of two.
+	static constexpr uint32_t RECORDER_TRACE_MAGIC = 0x52544352; // "CRTR" in little endian.
+	static constexpr uint32_t RECORDER_TRACE_VERSION = 1;
+
+	// Fixed size record written to the trace file as is, so the layout must never change without bumping "RECORDER_TRACE_VERSION".
+	struct EventRecord
+	{
+		uint64_t Timestamp;		// Nanoseconds since the recording started.
+		uint64_t Caller;		// Address of the calling object, only useful for grouping calls from the same object.
+		uint64_t FunctionIndex;	// The functions "ObjectInternalInteger".
+		uint32_t ThreadId;
+		uint32_t ParamsSize;
+		uint8_t EventType;		// Same value as the "EventTypes" enum.
+		uint8_t Reserved[7];
+	};
+
+	struct TraceHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t RecordSize;
+		uint32_t Reserved;
+		uint64_t StartTime; // Steady clock time in nanoseconds when the recording started.
+	};
+
+	static_assert(sizeof(EventRecord) == 40, "EventRecord size has changed, update \"RECORDER_TRACE_VERSION\"!");
+	static_assert(sizeof(TraceHeader) == 24, "TraceHeader size has changed, update \"RECORDER_TRACE_VERSION\"!");
+
+	// Single producer single consumer ring, the owning thread pushes records and only the drain thread pops them.
+	class RecorderRing
+	{
+	public:
+		uint32_t ThreadId;
+		alignas(64) std::atomic<uint64_t> Head;		// Next slot the owning thread writes to.
+		alignas(64) std::atomic<uint64_t> Tail;		// Next slot the drain thread reads from.
+		std::atomic<uint64_t> Dropped;				// Records lost because the ring was full.
+		std::unique_ptr<EventRecord[]> Records;
+
+	public:
+		RecorderRing(uint32_t threadId);
+		RecorderRing(const RecorderRing& recorderRing) = delete;
+		~RecorderRing();
+
+	public:
+		bool Push(const EventRecord& eventRecord);
+		size_t Drain(std::vector<EventRecord>& eventRecords); // Moves every pending record into the given vector, returns the amount moved.
+
+	public:
+		RecorderRing& operator=(const RecorderRing& recorderRing) = delete;
+	};
+
+	// Filters used when decoding a trace file, zero or empty values are ignored.
+	class TraceFilter
+	{
+	public:
+		std::vector<uint64_t> FunctionIndexes;
+		uint32_t ThreadId;
+		uint8_t EventType;
+		uint64_t StartTime;
+		uint64_t EndTime;
+
+	public:
+		TraceFilter();
+		TraceFilter(const TraceFilter& traceFilter);
+		~TraceFilter();
+
+	public:
+		bool Matches(const EventRecord& eventRecord) const;
+
+	public:
+		TraceFilter& operator=(const TraceFilter& traceFilter);
+	};
+
+	// Low overhead recorder for process event traffic, records are buffered per thread and written to a binary file by a background thread.
+	class EventRecorder
+	{
+	private:
+		static inline std::atomic<bool> m_recording = false;
+		static inline std::atomic<uint64_t> m_startTime = 0;
+		static inline std::atomic<uint64_t> m_generation = 0; // Bumped on every start, so threads know to register a fresh ring.
+		static inline std::mutex m_ringMutex;
+		static inline std::vector<std::shared_ptr<RecorderRing>> m_rings;
+		static inline std::mutex m_controlMutex;
+		static inline std::thread m_drainThread;
+		static inline std::atomic<bool> m_draining = false;
+		static inline std::ofstream m_traceFile;
+		static inline uint64_t m_recordsWritten = 0;
+
+	public:
+		EventRecorder() = delete;
+		EventRecorder(const EventRecorder& eventRecorder) = delete;
+		~EventRecorder() = delete;
+
+	public:
+		static bool IsRecording();
+		static bool Start(const std::filesystem::path& filePath);
+		static uint64_t Stop(); // Flushes every pending record and closes the file, returns the amount of records written.
+		static uint64_t GetDroppedCount();
+		static void Record(uint64_t caller, uint64_t functionIndex, uint8_t eventType, uint32_t paramsSize);
+		static bool ReadTrace(const std::filesystem::path& filePath, std::vector<EventRecord>& eventRecords, const TraceFilter& traceFilter = TraceFilter());
+
+	private:
+		static RecorderRing& GetThreadRing();
+		static size_t DrainRings(std::vector<EventRecord>& eventRecords);
+		static void DrainThread();
+
+	public:
+		EventRecorder& operator=(const EventRecorder& eventRecorder) = delete;
+	};
+}
@@ -1,18 +1,251 @@
 #include "FunctionHook.hpp"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace CodeRed
 {
-	FunctionHook::FunctionHook() : m_targetFunction(nullptr), m_hookedFunction(nullptr), m_overrideFunction(nullptr) {}
+	static uint64_t GetHookTimestamp()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+#ifndef _WIN32
+	// There's no "VirtualQuery" equivalent, the only place the current protection of a page can be read from is the maps file.
+	static bool GetPageProtection(const void* address, int32_t& protection)
+	{
+		bool bFound = false;
+		FILE* mapsFile = fopen("/proc/self/maps", "r");
+
+		if (mapsFile)
+		{
+			unsigned long long regionStart = 0;
+			unsigned long long regionEnd = 0;
+			char permissions[5] = {};
+			char mapsLine[512];
+
+			while (fgets(mapsLine, sizeof(mapsLine), mapsFile))
+			{
+				if ((sscanf(mapsLine, "%llx-%llx %4s", &regionStart, &regionEnd, permissions) == 3)
+					&& (reinterpret_cast<uintptr_t>(address) >= regionStart)
+					&& (reinterpret_cast<uintptr_t>(address) < regionEnd))
+				{
+					protection = PROT_NONE;
+					if (permissions[0] == 'r') { protection |= PROT_READ; }
+					if (permissions[1] == 'w') { protection |= PROT_WRITE; }
+					if (permissions[2] == 'x') { protection |= PROT_EXEC; }
+					bFound = true;
+					break;
+				}
+			}
+
+			fclose(mapsFile);
+		}
+
+		return bFound;
+	}
+#endif
+
+	TelemetryStore::TelemetryStore() : m_size(0) {}
+
+	TelemetryStore::~TelemetryStore() {}
+
+	uint64_t TelemetryStore::GetCount(size_t counterIndex) const
+	{
+		if (counterIndex < m_size)
+		{
+			return m_counts[counterIndex].load(std::memory_order_relaxed);
+		}
+
+		return 0;
+	}
+
+	void TelemetryStore::Increment(size_t counterIndex)
+	{
+		if (counterIndex >= m_size)
+		{
+			std::lock_guard<std::mutex> storeLock(Mutex);
+			size_t newSize = std::max(TELEMETRY_MIN_COUNTERS, std::bit_ceil(counterIndex + 1));
+			std::unique_ptr<std::atomic<uint64_t>[]> newCounts = std::make_unique<std::atomic<uint64_t>[]>(newSize);
+
+			for (size_t i = 0; i < newSize; i++)
+			{
+				newCounts[i].store(((i < m_size) ? m_counts[i].load(std::memory_order_relaxed) : 0), std::memory_order_relaxed);
+			}
 
-	FunctionHook::FunctionHook(const FunctionHook& functionHook) : m_targetFunction(functionHook.m_targetFunction), m_hookedFunction(functionHook.m_hookedFunction), m_overrideFunction(functionHook.m_overrideFunction) {}
+			m_counts = std::move(newCounts);
+			m_size = newSize;
+		}
+
+		std::atomic<uint64_t>& counter = m_counts[counterIndex];
+		counter.store((counter.load(std::memory_order_relaxed) + 1), std::memory_order_relaxed); // Single writer, so this doesn't need to be a locked add.
+	}
+
+	void TelemetryStore::Reset(size_t counterIndex)
+	{
+		if (counterIndex < m_size)
+		{
+			m_counts[counterIndex].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	HookTelemetry::HookTelemetry() : m_counterIndex(m_nextCounter.fetch_add(1)), AttachTime(0), EnableTime(0) {}
+
+	HookTelemetry::HookTelemetry(const HookTelemetry& hookTelemetry) :
+		m_counterIndex(m_nextCounter.fetch_add(1)),
+		AttachTime(hookTelemetry.AttachTime.load()),
+		EnableTime(hookTelemetry.EnableTime.load())
+	{
+
+	}
 
-	FunctionHook::~FunctionHook() { Detach(); }
+	HookTelemetry::~HookTelemetry() {}
+
+	uint64_t HookTelemetry::GetHits() const
+	{
+		return SumCounts(m_counterIndex * 2);
+	}
+
+	uint64_t HookTelemetry::GetOriginalCalls() const
+	{
+		return SumCounts((m_counterIndex * 2) + 1);
+	}
+
+	void HookTelemetry::ResetCalls()
+	{
+		std::lock_guard<std::mutex> storesLock(GetStoreMutex());
+
+		for (const std::shared_ptr<TelemetryStore>& telemetryStore : GetStores())
+		{
+			std::lock_guard<std::mutex> storeLock(telemetryStore->Mutex);
+			telemetryStore->Reset(m_counterIndex * 2);
+			telemetryStore->Reset((m_counterIndex * 2) + 1);
+		}
+	}
+
+	void HookTelemetry::Reset()
+	{
+		ResetCalls();
+		AttachTime = 0;
+		EnableTime = 0;
+	}
+
+	uint64_t HookTelemetry::SumCounts(size_t counterIndex) const
+	{
+		uint64_t totalCount = 0;
+		std::lock_guard<std::mutex> storesLock(GetStoreMutex());
+
+		for (const std::shared_ptr<TelemetryStore>& telemetryStore : GetStores())
+		{
+			std::lock_guard<std::mutex> storeLock(telemetryStore->Mutex);
+			totalCount += telemetryStore->GetCount(counterIndex);
+		}
+
+		return totalCount;
+	}
+
+	TelemetryStore& HookTelemetry::GetThreadStore()
+	{
+		static thread_local std::shared_ptr<TelemetryStore> threadStore;
+
+		if (!threadStore)
+		{
+			threadStore = std::make_shared<TelemetryStore>();
+			std::lock_guard<std::mutex> storesLock(GetStoreMutex());
+			GetStores().push_back(threadStore);
+		}
+
+		return *threadStore;
+	}
+
+	std::mutex& HookTelemetry::GetStoreMutex()
+	{
+		static std::mutex storeMutex;
+		return storeMutex;
+	}
+
+	std::vector<std::shared_ptr<TelemetryStore>>& HookTelemetry::GetStores()
+	{
+		static std::vector<std::shared_ptr<TelemetryStore>> telemetryStores;
+		return telemetryStores;
+	}
+
+	HookTelemetry& HookTelemetry::operator=(const HookTelemetry& hookTelemetry)
+	{
+		// Each hook keeps counting into its own counters, only the timings are copied.
+		AttachTime = hookTelemetry.AttachTime.load();
+		EnableTime = hookTelemetry.EnableTime.load();
+		return *this;
+	}
+
+	FunctionHook::FunctionHook() : m_targetFunction(nullptr), m_hookedFunction(nullptr), m_overrideFunction(nullptr), m_vtableSlot(nullptr), m_hookMode(HookModes::Inline), m_enabled(false), m_pendingEnabled(false)
+	{
+		Register();
+	}
+
+	FunctionHook::FunctionHook(const FunctionHook& functionHook) :
+		m_name(functionHook.m_name),
+		m_targetFunction(functionHook.m_targetFunction),
+		m_hookedFunction(functionHook.m_hookedFunction),
+		m_overrideFunction(functionHook.m_overrideFunction),
+		m_vtableSlot(functionHook.m_vtableSlot),
+		m_hookMode(functionHook.m_hookMode),
+		m_enabled(functionHook.m_enabled),
+		m_pendingEnabled(false),
+		m_telemetry(functionHook.m_telemetry)
+	{
+		Register();
+	}
+
+	FunctionHook::~FunctionHook()
+	{
+		Detach();
+		std::erase(m_pendingHooks, this); // Destroyed before the transaction it was part of was committed.
+		Unregister();
+	}
 
 	bool FunctionHook::IsAttached() const
 	{
 		return (GetTarget() && GetHooked());
 	}
 
+	bool FunctionHook::IsEnabled() const
+	{
+		if (IsAttached() && m_vtableSlot)
+		{
+			return (std::atomic_ref<void*>(*m_vtableSlot).load() == GetOverride());
+		}
+
+		return (IsAttached() && m_enabled);
+	}
+
+	HookModes FunctionHook::GetMode() const
+	{
+		return m_hookMode;
+	}
+
+	const std::string& FunctionHook::GetName() const
+	{
+		return m_name;
+	}
+
+	void FunctionHook::SetName(const std::string& name)
+	{
+		m_name = name;
+	}
+
+	const HookTelemetry& FunctionHook::GetTelemetry() const
+	{
+		return m_telemetry;
+	}
+
+	void FunctionHook::ResetTelemetry()
+	{
+		m_telemetry.Reset();
+	}
+
 	uintptr_t* FunctionHook::GetTarget() const
 	{
 		return m_targetFunction;
@@ -35,64 +268,332 @@ namespace CodeRed
 			m_targetFunction = targetFunction;
 			m_overrideFunction = overrideFunction;
 			m_hookedFunction = nullptr;
+			m_vtableSlot = nullptr;
+			m_hookMode = HookModes::Inline;
+			m_enabled = false;
+			uint64_t attachStart = GetHookTimestamp();
 
 #ifdef CR_MINHOOK
 			MinHook::MH_STATUS detourResult = MinHook::MH_CreateHook(GetTarget(), GetOverride(), reinterpret_cast<LPVOID*>(&m_hookedFunction));
+			m_telemetry.AttachTime = (GetHookTimestamp() - attachStart);
 			return (detourResult == MinHook::MH_STATUS::MH_OK);
 #elif defined(CR_DETOURS)
+			if (IsInTransaction())
+			{
+				int32_t detourResult = DetourAttach(&reinterpret_cast<PVOID&>(m_targetFunction), reinterpret_cast<PVOID>(GetOverride()));
+				m_telemetry.AttachTime = (GetHookTimestamp() - attachStart);
+
+				if (detourResult == NO_ERROR)
+				{
+					m_pendingHooks.push_back(this); // Our trampoline isn't written to "m_targetFunction" until the transaction is committed.
+				}
+
+				return (detourResult == NO_ERROR);
+			}
+
 			DetourTransactionBegin();
 			DetourUpdateThread(GetCurrentThread());
 			int32_t detourResult = DetourAttach(&reinterpret_cast<PVOID&>(m_targetFunction), reinterpret_cast<PVOID>(GetOverride()));
-			DetourTransactionCommit();
-			return (detourResult == NO_ERROR);
+			bool bCommitted = (DetourTransactionCommit() == NO_ERROR);
+			m_telemetry.AttachTime = (GetHookTimestamp() - attachStart);
+
+			if (bCommitted && (detourResult == NO_ERROR))
+			{
+				m_hookedFunction = m_targetFunction; // Detours replaces the target with the trampoline, which is what calls the original function.
+				m_enabled = true; // Detours hooks are live as soon as they're attached.
+				return true;
+			}
 #endif
 		}
 
 		return false;
 	}
 
+	bool FunctionHook::AttachVTable(void** vfTable, size_t index, void* overrideFunction)
+	{
+		if (!IsAttached() && vfTable && vfTable[index] && overrideFunction)
+		{
+			m_vtableSlot = &vfTable[index];
+			m_targetFunction = reinterpret_cast<uintptr_t*>(vfTable[index]);
+			m_hookedFunction = m_targetFunction; // The original code is never modified, so it can be called directly.
+			m_overrideFunction = overrideFunction;
+			m_hookMode = HookModes::VTable;
+			m_enabled = false;
+			m_telemetry.AttachTime = 0; // Nothing is patched until "Enable", so there's nothing worth timing here.
+			return true;
+		}
+
+		return false;
+	}
+
 	void FunctionHook::Detach()
 	{
-		if (IsAttached() && GetOverride())
+		if (IsAttached() && (m_hookMode == HookModes::VTable))
+		{
+			Disable();
+			m_vtableSlot = nullptr;
+			m_hookedFunction = nullptr;
+		}
+		else if (IsAttached() && GetOverride())
 		{
 #ifdef CR_MINHOOK
 			Disable();
 			MinHook::MH_RemoveHook(GetTarget());
+			std::erase(m_pendingHooks, this); // Removing is applied right away, there's nothing left for the transaction to finalize.
 #elif defined(CR_DETOURS)
+			if (IsInTransaction())
+			{
+				DetourDetach(&reinterpret_cast<PVOID&>(m_targetFunction), reinterpret_cast<PVOID>(GetOverride()));
+				m_pendingHooks.push_back(this);
+				return; // Still attached until the transaction is committed.
+			}
+
 			DetourTransactionBegin();
 			DetourUpdateThread(GetCurrentThread());
 			DetourDetach(&reinterpret_cast<PVOID&>(m_targetFunction), reinterpret_cast<PVOID>(GetOverride()));
 			DetourTransactionCommit();
 #endif
 			m_hookedFunction = nullptr;
+			m_enabled = false;
 		}
 	}
 
 	void FunctionHook::Enable()
 	{
+		uint64_t enableStart = GetHookTimestamp();
+
+		if (IsAttached() && (m_hookMode == HookModes::VTable))
+		{
+			SwapVTableSlot(GetOverride());
+			m_telemetry.EnableTime = (GetHookTimestamp() - enableStart);
+			return;
+		}
+
 #ifdef CR_MINHOOK
 		if (IsAttached())
 		{
-			MinHook::MH_EnableHook(GetTarget());
+			if (IsInTransaction())
+			{
+				// Nothing is patched until the transaction is committed, and if applying it fails the hook was never enabled.
+				if (MinHook::MH_QueueEnableHook(GetTarget()) == MinHook::MH_STATUS::MH_OK)
+				{
+					QueueState(true);
+				}
+			}
+			else
+			{
+				m_enabled = (MinHook::MH_EnableHook(GetTarget()) == MinHook::MH_STATUS::MH_OK);
+			}
+
+			m_telemetry.EnableTime = (GetHookTimestamp() - enableStart);
 		}
 #endif
 	}
 
 	void FunctionHook::Disable()
 	{
+		if (IsAttached() && (m_hookMode == HookModes::VTable))
+		{
+			SwapVTableSlot(GetTarget());
+			return;
+		}
+
 #ifdef CR_MINHOOK
 		if (IsAttached())
 		{
-			MinHook::MH_DisableHook(GetTarget());
+			if (IsInTransaction())
+			{
+				if (MinHook::MH_QueueDisableHook(GetTarget()) == MinHook::MH_STATUS::MH_OK)
+				{
+					QueueState(false);
+				}
+			}
+			else
+			{
+				MinHook::MH_DisableHook(GetTarget());
+				m_enabled = false;
+			}
+		}
+#endif
+	}
+
+	bool FunctionHook::BeginTransaction()
+	{
+		if (!m_inTransaction)
+		{
+#ifdef CR_DETOURS
+			if ((DetourTransactionBegin() != NO_ERROR) || (DetourUpdateThread(GetCurrentThread()) != NO_ERROR))
+			{
+				return false;
+			}
+#endif
+			m_pendingHooks.clear();
+			m_inTransaction = true;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool FunctionHook::CommitTransaction()
+	{
+		bool bCommitted = false;
+
+		if (m_inTransaction)
+		{
+			m_inTransaction = false;
+
+#ifdef CR_MINHOOK
+			bCommitted = (MinHook::MH_ApplyQueued() == MinHook::MH_STATUS::MH_OK);
+
+			if (bCommitted)
+			{
+				for (FunctionHook* functionHook : m_pendingHooks)
+				{
+					functionHook->m_enabled = functionHook->m_pendingEnabled;
+				}
+			}
+#elif defined(CR_DETOURS)
+			bCommitted = (DetourTransactionCommit() == NO_ERROR);
+
+			if (bCommitted)
+			{
+				for (FunctionHook* functionHook : m_pendingHooks)
+				{
+					// Attached hooks now have their trampoline, detached ones have their original target back.
+					functionHook->m_hookedFunction = (functionHook->m_hookedFunction ? nullptr : functionHook->m_targetFunction);
+					functionHook->m_enabled = (functionHook->m_hookedFunction != nullptr);
+				}
+			}
+#else
+			bCommitted = true;
+#endif
+
+			m_pendingHooks.clear();
+		}
+
+		return bCommitted;
+	}
+
+	bool FunctionHook::IsInTransaction()
+	{
+		return m_inTransaction;
+	}
+
+	void FunctionHook::ForEachHook(const Delegate<void(const FunctionHook&)>& callback)
+	{
+		if (callback)
+		{
+			std::lock_guard<std::mutex> registryLock(GetRegistryMutex());
+
+			for (FunctionHook* functionHook : GetRegistry())
+			{
+				callback(*functionHook);
+			}
+		}
+	}
+
+	void FunctionHook::ResetAllTelemetry()
+	{
+		std::lock_guard<std::mutex> registryLock(GetRegistryMutex());
+
+		for (FunctionHook* functionHook : GetRegistry())
+		{
+			functionHook->m_telemetry.ResetCalls(); // Attach and enable times are kept, they only change when the hook is reinstalled.
 		}
+	}
+
+	std::mutex& FunctionHook::GetRegistryMutex()
+	{
+		static std::mutex registryMutex;
+		return registryMutex;
+	}
+
+	std::vector<FunctionHook*>& FunctionHook::GetRegistry()
+	{
+		static std::vector<FunctionHook*> registry;
+		return registry;
+	}
+
+	void FunctionHook::Register()
+	{
+		std::lock_guard<std::mutex> registryLock(GetRegistryMutex());
+		GetRegistry().push_back(this);
+	}
+
+	void FunctionHook::Unregister()
+	{
+		std::lock_guard<std::mutex> registryLock(GetRegistryMutex());
+		std::vector<FunctionHook*>& registry = GetRegistry();
+		std::vector<FunctionHook*>::iterator hookIt = std::find(registry.begin(), registry.end(), this);
+
+		if (hookIt != registry.end())
+		{
+			*hookIt = registry.back(); // Order doesn't matter, swap and pop.
+			registry.pop_back();
+		}
+	}
+
+	void FunctionHook::QueueState(bool bEnabled)
+	{
+		m_pendingEnabled = bEnabled;
+
+		if (std::find(m_pendingHooks.begin(), m_pendingHooks.end(), this) == m_pendingHooks.end())
+		{
+			m_pendingHooks.push_back(this);
+		}
+	}
+
+	bool FunctionHook::SwapVTableSlot(void* newFunction)
+	{
+		if (m_vtableSlot)
+		{
+			// VTables are normally in read only memory, so the page has to be made writable just for the swap.
+#ifdef _WIN32
+			DWORD oldProtection = 0;
+
+			if (VirtualProtect(m_vtableSlot, sizeof(void*), PAGE_READWRITE, &oldProtection))
+			{
+				std::atomic_ref<void*>(*m_vtableSlot).exchange(newFunction);
+				VirtualProtect(m_vtableSlot, sizeof(void*), oldProtection, &oldProtection);
+				return true;
+			}
+#else
+			uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+			void* slotPage = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_vtableSlot) & ~(pageSize - 1));
+
+			int32_t oldProtection = PROT_NONE;
+
+			if (GetPageProtection(m_vtableSlot, oldProtection))
+			{
+				if ((oldProtection & PROT_WRITE) || (mprotect(slotPage, pageSize, (oldProtection | PROT_WRITE)) == 0))
+				{
+					std::atomic_ref<void*>(*m_vtableSlot).exchange(newFunction);
+
+					if (!(oldProtection & PROT_WRITE))
+					{
+						mprotect(slotPage, pageSize, oldProtection);
+					}
+
+					return true;
+				}
+			}
 #endif
+		}
+
+		return false;
 	}
 
 	FunctionHook& FunctionHook::operator=(const FunctionHook& functionHook)
 	{
+		m_name = functionHook.m_name;
 		m_targetFunction = functionHook.m_targetFunction;
 		m_hookedFunction = functionHook.m_hookedFunction;
 		m_overrideFunction = functionHook.m_overrideFunction;
+		m_vtableSlot = functionHook.m_vtableSlot;
+		m_hookMode = functionHook.m_hookMode;
+		m_enabled = functionHook.m_enabled;
+		m_telemetry = functionHook.m_telemetry;
 		return *this;
 	}
 }
\ No newline at end of file
@@ -11,12 +11,86 @@ namespace CodeRed::HookTypes
 
 namespace CodeRed
 {
+	static constexpr size_t TELEMETRY_MIN_COUNTERS = 64; // Initial amount of counters per thread, two for every hook, grows to the next power of two when more hooks are created.
+
+	enum class HookModes : uint8_t
+	{
+		Inline,		// The target functions code is patched with Detours or MinHook, catches every call no matter where it comes from.
+		VTable		// A single vtable entry is swapped, only catches virtual calls made through that exact vtable.
+	};
+
+	// Used exclusively by the "HookTelemetry" class, each thread counts into its own store so hooked calls never write to a cache line another thread uses.
+	class TelemetryStore
+	{
+	private:
+		std::unique_ptr<std::atomic<uint64_t>[]> m_counts; // Atomic only so other threads can read them without tearing, increments are a plain load and store.
+		size_t m_size;
+
+	public:
+		std::mutex Mutex; // Only taken when growing, reading, or clearing the counters.
+
+	public:
+		TelemetryStore();
+		TelemetryStore(const TelemetryStore& telemetryStore) = delete;
+		~TelemetryStore();
+
+	public:
+		uint64_t GetCount(size_t counterIndex) const; // Must be holding "Mutex" if called from another thread.
+		void Increment(size_t counterIndex); // Only called by the owning thread, grows the counters first if needed.
+		void Reset(size_t counterIndex); // Must be holding "Mutex".
+
+	public:
+		TelemetryStore& operator=(const TelemetryStore& telemetryStore) = delete;
+	};
+
+	// Per hook counters, hits and original calls are counted per thread and only summed when read so they're cheap enough to leave on in release builds.
+	class HookTelemetry
+	{
+	private:
+		size_t m_counterIndex; // Hits are counted at twice this index in every threads store, original calls right after it. Never reused, so copies start from zero.
+		static inline std::atomic<size_t> m_nextCounter = 0;
+
+	public:
+		std::atomic<uint64_t> AttachTime;		// Nanoseconds spent in the last "Attach" call.
+		std::atomic<uint64_t> EnableTime;		// Nanoseconds spent in the last "Enable" call, inside a transaction this is only the time to queue it.
+
+	public:
+		HookTelemetry();
+		HookTelemetry(const HookTelemetry& hookTelemetry);
+		~HookTelemetry();
+
+	public:
+		uint64_t GetHits() const; // Calls that went through the override function, only counted if it calls "FunctionHook::RecordHit".
+		uint64_t GetOriginalCalls() const; // Calls to the original function through "FunctionHook::Call".
+		void RecordHit() { GetThreadStore().Increment(m_counterIndex * 2); }
+		void RecordOriginalCall() { GetThreadStore().Increment((m_counterIndex * 2) + 1); }
+		void ResetCalls(); // Only clears the hit and original call counts, attach and enable times are kept.
+		void Reset();
+
+	private:
+		uint64_t SumCounts(size_t counterIndex) const;
+		static TelemetryStore& GetThreadStore();
+		static std::mutex& GetStoreMutex();
+		static std::vector<std::shared_ptr<TelemetryStore>>& GetStores(); // Every thread that has counted something, kept after the thread exits so its counts still show up.
+
+	public:
+		HookTelemetry& operator=(const HookTelemetry& hookTelemetry);
+	};
+
 	class FunctionHook
 	{
 	private:
+		std::string m_name; // Only used for displaying, set with "SetName".
 		uintptr_t* m_targetFunction; // Address of the actual function we want to detour.
 		uintptr_t* m_hookedFunction; // The callback for the original function created AFTER hooking, to call from the override function.
 		void* m_overrideFunction;
+		void** m_vtableSlot; // The vtable entry that gets swapped, only used in vtable mode.
+		HookModes m_hookMode;
+		bool m_enabled;
+		bool m_pendingEnabled; // What "m_enabled" becomes once the current transaction is committed, only used with MinHook.
+		HookTelemetry m_telemetry;
+		static inline bool m_inTransaction = false;
+		static inline std::vector<FunctionHook*> m_pendingHooks; // Hooks attached, detached, enabled, or disabled during the current transaction, finalized when it's committed.
 
 	public:
 		FunctionHook();
@@ -25,19 +99,54 @@ namespace CodeRed
 
 	public:
 		bool IsAttached() const;
+		bool IsEnabled() const; // In vtable mode this checks if the slot currently points to the override function.
+		HookModes GetMode() const;
+		const std::string& GetName() const;
+		void SetName(const std::string& name);
+		const HookTelemetry& GetTelemetry() const;
+		void ResetTelemetry();
 		uintptr_t* GetTarget() const;
 		uintptr_t* GetHooked() const;
 		void* GetOverride() const;
 
 	public:
 		bool Attach(uintptr_t* targetFunction, void* overrideFunction);
+		bool AttachVTable(void** vfTable, size_t index, void* overrideFunction); // Doesn't touch any code or freeze threads, the slot is only swapped when calling "Enable".
+		template <typename T> bool AttachVTable(T* polymorphicObject, size_t index, void* overrideFunction)
+		{
+			static_assert(std::is_polymorphic_v<T>, "Object must have a vtable to hook!");
+			return (polymorphicObject && AttachVTable(*reinterpret_cast<void***>(polymorphicObject), index, overrideFunction));
+		}
 		template <typename T> T Call()
 		{
+			m_telemetry.RecordOriginalCall();
 			return reinterpret_cast<T>(GetHooked());
 		}
+		void RecordHit() { m_telemetry.RecordHit(); } // Call this at the top of your override function.
 		void Detach();
-		void Enable(); // Only works with MinHook, not Detours.
-		void Disable(); // Only works with MinHook, not Detours.
+		void Enable(); // Only works with MinHook or vtable mode, not Detours.
+		void Disable(); // Only works with MinHook or vtable mode, not Detours.
+
+	public:
+		// Batches every attach, enable, and disable until "CommitTransaction", so any amount of hooks are installed with a single thread freeze.
+		// Maps to "MH_QueueEnableHook" and "MH_ApplyQueued" with MinHook, or a single Detours transaction. Only use these from one thread at a time.
+		// With MinHook "Detach" is still applied right away, vtable hooks never need a transaction and are always applied right away.
+		static bool BeginTransaction();
+		static bool CommitTransaction();
+		static bool IsInTransaction();
+
+	public:
+		// Every constructed hook registers itself here, the callback is run while the registry is locked so don't create or destroy hooks from it.
+		static void ForEachHook(const Delegate<void(const FunctionHook&)>& callback);
+		static void ResetAllTelemetry();
+
+	private:
+		static std::mutex& GetRegistryMutex();
+		static std::vector<FunctionHook*>& GetRegistry(); // Function local statics, so they outlive any static hooks that unregister in their destructor.
+		void Register();
+		void Unregister();
+		void QueueState(bool bEnabled); // Remembers the state a queued MinHook enable or disable gives this hook, applied once the transaction is committed.
+		bool SwapVTableSlot(void* newFunction); // Atomically replaces the vtable entry, other threads see either the old or new function and never a partial write.
 
 	public:
 		FunctionHook& operator=(const FunctionHook& functionHook);
@@ -28,12 +28,24 @@
 
 #include "Buffer.hpp"
 
-// Size of each memory block. (= page size of VirtualAlloc)
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <stdio.h>
+#endif
+
+// Size of each commit inside a region. (= page size)
 #define MEMORY_BLOCK_SIZE 0x1000
 
-// Max range for seeking a memory block. (= 1024MB)
+// Size of each reserved region, slots are carved out of it one page at a time. (= allocation granularity of VirtualAlloc)
+#define MEMORY_REGION_SIZE 0x10000
+
+// Max range for seeking a memory region. (= 1024MB)
 #define MAX_MEMORY_RANGE 0x40000000
 
+// Amount of entries in the region cache, must be a power of two.
+#define REGION_CACHE_SIZE 16
+
 // Memory protection flags to check the executable address.
 #define PAGE_EXECUTE_FLAGS \
     (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)
@@ -48,13 +60,24 @@ typedef struct _MEMORY_SLOT
     };
 } MEMORY_SLOT, *PMEMORY_SLOT;
 
-// Memory block info. Placed at the head of each block.
-typedef struct _MEMORY_BLOCK
+// Memory region info. Placed in the first slot of each region.
+typedef struct _MEMORY_REGION
 {
-    struct _MEMORY_BLOCK* pNext;
-    PMEMORY_SLOT pFree;         // First element of the free slot list.
+    struct _MEMORY_REGION* pNext;
+    PMEMORY_SLOT pFree;         // First element of the free slot list, slots are only added here once released.
+    PMEMORY_SLOT pUnused;       // Next slot that has never been handed out.
+    PMEMORY_SLOT pCommitEnd;    // End of the committed pages, the rest of the region is only reserved.
     UINT usedCount;
-} MEMORY_BLOCK, *PMEMORY_BLOCK;
+} MEMORY_REGION, *PMEMORY_REGION;
+
+static_assert(sizeof(MEMORY_REGION) <= sizeof(MEMORY_SLOT), "Region header must fit in a single slot!");
+
+// Last region used for each 2GB window, so nearby targets skip the region list entirely.
+typedef struct _REGION_CACHE_ENTRY
+{
+    ULONG_PTR window;           // Target address divided by 2GB, plus one so zero means empty.
+    PMEMORY_REGION pRegion;
+} REGION_CACHE_ENTRY, *PREGION_CACHE_ENTRY;
 
 namespace MinHook::Buffer
 {
@@ -62,40 +85,55 @@ namespace MinHook::Buffer
     // Global Variables:
     //-------------------------------------------------------------------------
 
-    // First element of the memory block list.
-    PMEMORY_BLOCK g_pMemoryBlocks;
+    // First element of the memory region list.
+    PMEMORY_REGION g_pMemoryRegions;
+
+    // Nearest region with free slots for recently hooked windows.
+    REGION_CACHE_ENTRY g_regionCache[REGION_CACHE_SIZE];
 
     //-------------------------------------------------------------------------
-    void InitializeBuffer(void)
+    // OS abstraction, everything below this section only reserves, commits, and releases through these.
+    //-------------------------------------------------------------------------
+
+#ifdef _WIN32
+    //-------------------------------------------------------------------------
+    static VOID OsGetAddressRange(ULONG_PTR* pMinAddr, ULONG_PTR* pMaxAddr)
     {
-        // Nothing to do for now.
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        *pMinAddr = (ULONG_PTR)si.lpMinimumApplicationAddress;
+        *pMaxAddr = (ULONG_PTR)si.lpMaximumApplicationAddress;
     }
 
     //-------------------------------------------------------------------------
-    void UninitializeBuffer(void)
+    static LPVOID OsReserve(LPVOID pAddress)
     {
-        PMEMORY_BLOCK pBlock = g_pMemoryBlocks;
-        g_pMemoryBlocks = nullptr;
+        return VirtualAlloc(pAddress, MEMORY_REGION_SIZE, MEM_RESERVE, PAGE_NOACCESS);
+    }
 
-        while (pBlock)
-        {
-            PMEMORY_BLOCK pNext = pBlock->pNext;
-            VirtualFree(pBlock, 0, MEM_RELEASE);
-            pBlock = pNext;
-        }
+    //-------------------------------------------------------------------------
+    static BOOL OsCommit(LPVOID pAddress)
+    {
+        return (VirtualAlloc(pAddress, MEMORY_BLOCK_SIZE, MEM_COMMIT, PAGE_EXECUTE_READWRITE) != NULL);
+    }
+
+    //-------------------------------------------------------------------------
+    static VOID OsRelease(LPVOID pAddress)
+    {
+        VirtualFree(pAddress, 0, MEM_RELEASE);
     }
 
     //-------------------------------------------------------------------------
 #if defined(_M_X64) || defined(__x86_64__)
-    static LPVOID FindPrevFreeRegion(LPVOID pAddress, LPVOID pMinAddr, DWORD dwAllocationGranularity)
+    static LPVOID OsFindPrevFreeRegion(LPVOID pAddress, LPVOID pMinAddr)
     {
         ULONG_PTR tryAddr = (ULONG_PTR)pAddress;
 
-        // Round down to the allocation granularity.
-        tryAddr -= (tryAddr % dwAllocationGranularity);
+        // Round down to the region size.
+        tryAddr -= (tryAddr % MEMORY_REGION_SIZE);
 
-        // Start from the previous allocation granularity multiply.
-        tryAddr -= dwAllocationGranularity;
+        // Start from the previous region size multiply.
+        tryAddr -= MEMORY_REGION_SIZE;
 
         while (tryAddr >= (ULONG_PTR)pMinAddr)
         {
@@ -111,29 +149,27 @@ namespace MinHook::Buffer
                 return (LPVOID)tryAddr;
             }
 
-            if ((ULONG_PTR)mbi.AllocationBase < dwAllocationGranularity)
+            if ((ULONG_PTR)mbi.AllocationBase < MEMORY_REGION_SIZE)
             {
                 break;
             }
 
-            tryAddr = ((ULONG_PTR)mbi.AllocationBase - dwAllocationGranularity);
+            tryAddr = ((ULONG_PTR)mbi.AllocationBase - MEMORY_REGION_SIZE);
         }
 
         return NULL;
     }
-#endif
 
     //-------------------------------------------------------------------------
-#if defined(_M_X64) || defined(__x86_64__)
-    static LPVOID FindNextFreeRegion(LPVOID pAddress, LPVOID pMaxAddr, DWORD dwAllocationGranularity)
+    static LPVOID OsFindNextFreeRegion(LPVOID pAddress, LPVOID pMaxAddr)
     {
         ULONG_PTR tryAddr = (ULONG_PTR)pAddress;
 
-        // Round down to the allocation granularity.
-        tryAddr -= (tryAddr % dwAllocationGranularity);
+        // Round down to the region size.
+        tryAddr -= (tryAddr % MEMORY_REGION_SIZE);
 
-        // Start from the next allocation granularity multiply.
-        tryAddr += dwAllocationGranularity;
+        // Start from the next region size multiply.
+        tryAddr += MEMORY_REGION_SIZE;
 
         while (tryAddr <= (ULONG_PTR)pMaxAddr)
         {
@@ -151,9 +187,9 @@ namespace MinHook::Buffer
 
             tryAddr = ((ULONG_PTR)mbi.BaseAddress + mbi.RegionSize);
 
-            // Round up to the next allocation granularity.
-            tryAddr += (dwAllocationGranularity - 1);
-            tryAddr -= (tryAddr % dwAllocationGranularity);
+            // Round up to the next region size.
+            tryAddr += (MEMORY_REGION_SIZE - 1);
+            tryAddr -= (tryAddr % MEMORY_REGION_SIZE);
         }
 
         return NULL;
@@ -161,19 +197,274 @@ namespace MinHook::Buffer
 #endif
 
     //-------------------------------------------------------------------------
-    static PMEMORY_BLOCK GetMemoryBlock(LPVOID pOrigin)
+    bool IsExecutableAddress(LPVOID pAddress)
     {
-        PMEMORY_BLOCK pBlock;
+        MEMORY_BASIC_INFORMATION mi;
+        VirtualQuery(pAddress, &mi, sizeof(mi));
+        return ((mi.State == MEM_COMMIT) && (mi.Protect & PAGE_EXECUTE_FLAGS));
+    }
+#else
+    //-------------------------------------------------------------------------
+    static VOID OsGetAddressRange(ULONG_PTR* pMinAddr, ULONG_PTR* pMaxAddr)
+    {
+        *pMinAddr = (ULONG_PTR)MEMORY_REGION_SIZE;
+        *pMaxAddr = (ULONG_PTR)0x7FFFFFFEFFFF;
+    }
+
+    //-------------------------------------------------------------------------
+    static LPVOID OsReserve(LPVOID pAddress)
+    {
+        if (pAddress == NULL)
+        {
+            // mmap only aligns to the page size, so reserve twice as much and trim it down to a region boundary.
+            LPBYTE pAlloc = (LPBYTE)mmap(NULL, (MEMORY_REGION_SIZE * 2), PROT_NONE, (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE), -1, 0);
+
+            if (pAlloc == MAP_FAILED)
+            {
+                return NULL;
+            }
+
+            LPBYTE pRegion = (LPBYTE)((((ULONG_PTR)pAlloc + (MEMORY_REGION_SIZE - 1)) / MEMORY_REGION_SIZE) * MEMORY_REGION_SIZE);
+
+            if (pRegion > pAlloc)
+            {
+                munmap(pAlloc, (pRegion - pAlloc));
+            }
+
+            munmap((pRegion + MEMORY_REGION_SIZE), ((pAlloc + (MEMORY_REGION_SIZE * 2)) - (pRegion + MEMORY_REGION_SIZE)));
+            return pRegion;
+        }
+
+        // Without MAP_FIXED_NOREPLACE the address is only a hint, so anything else is given back and treated as taken.
+        LPVOID pRegion = mmap(pAddress, MEMORY_REGION_SIZE, PROT_NONE, (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE), -1, 0);
+
+        if (pRegion == MAP_FAILED)
+        {
+            return NULL;
+        }
+        else if (pRegion != pAddress)
+        {
+            munmap(pRegion, MEMORY_REGION_SIZE);
+            return NULL;
+        }
+
+        return pRegion;
+    }
+
+    //-------------------------------------------------------------------------
+    static BOOL OsCommit(LPVOID pAddress)
+    {
+        return (mprotect(pAddress, MEMORY_BLOCK_SIZE, (PROT_READ | PROT_WRITE | PROT_EXEC)) == 0);
+    }
+
+    //-------------------------------------------------------------------------
+    static VOID OsRelease(LPVOID pAddress)
+    {
+        munmap(pAddress, MEMORY_REGION_SIZE);
+    }
+
+    //-------------------------------------------------------------------------
 #if defined(_M_X64) || defined(__x86_64__)
+    static LPVOID OsFindFreeRegion(ULONG_PTR minAddr, ULONG_PTR maxAddr, BOOL bHighest)
+    {
+        // There's no "VirtualQuery" here, so the maps file is read once and every gap between two mappings is checked for an aligned region.
+        // Mappings are listed in ascending order, the lowest fit is returned right away and the highest fit is whatever matched last.
+        LPVOID pFound = NULL;
+        FILE* pMaps = fopen("/proc/self/maps", "r");
+
+        if (pMaps)
+        {
+            ULONG_PTR gapStart = 0;
+
+            while (true)
+            {
+                unsigned long long start, end;
+                BOOL bLastGap = (fscanf(pMaps, "%llx-%llx%*[^\n]\n", &start, &end) != 2);
+                ULONG_PTR gapEnd = (bLastGap ? (maxAddr + MEMORY_REGION_SIZE) : (ULONG_PTR)start);
+
+                if (gapEnd >= MEMORY_REGION_SIZE)
+                {
+                    ULONG_PTR firstAddr = ((gapStart > minAddr) ? gapStart : minAddr);
+                    ULONG_PTR lastAddr = (((gapEnd - MEMORY_REGION_SIZE) < maxAddr) ? (gapEnd - MEMORY_REGION_SIZE) : maxAddr);
+
+                    // Round the first candidate up and the last one down to the region size.
+                    firstAddr += (MEMORY_REGION_SIZE - 1);
+                    firstAddr -= (firstAddr % MEMORY_REGION_SIZE);
+                    lastAddr -= (lastAddr % MEMORY_REGION_SIZE);
+
+                    if (firstAddr <= lastAddr)
+                    {
+                        pFound = (LPVOID)(bHighest ? lastAddr : firstAddr);
+
+                        if (!bHighest)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                if (bLastGap || (gapEnd > maxAddr))
+                {
+                    break;
+                }
+
+                gapStart = (((ULONG_PTR)end > gapStart) ? (ULONG_PTR)end : gapStart);
+            }
+
+            fclose(pMaps);
+        }
+
+        return pFound;
+    }
+
+    //-------------------------------------------------------------------------
+    static LPVOID OsFindPrevFreeRegion(LPVOID pAddress, LPVOID pMinAddr)
+    {
+        ULONG_PTR tryAddr = (ULONG_PTR)pAddress;
+
+        // Round down to the region size, the search starts from the previous region size multiply.
+        tryAddr -= (tryAddr % MEMORY_REGION_SIZE);
+
+        if (tryAddr < ((ULONG_PTR)pMinAddr + MEMORY_REGION_SIZE))
+        {
+            return NULL;
+        }
+
+        return OsFindFreeRegion((ULONG_PTR)pMinAddr, (tryAddr - MEMORY_REGION_SIZE), TRUE);
+    }
+
+    //-------------------------------------------------------------------------
+    static LPVOID OsFindNextFreeRegion(LPVOID pAddress, LPVOID pMaxAddr)
+    {
+        ULONG_PTR tryAddr = (ULONG_PTR)pAddress;
+
+        // Round down to the region size, the search starts from the next region size multiply.
+        tryAddr -= (tryAddr % MEMORY_REGION_SIZE);
+        tryAddr += MEMORY_REGION_SIZE;
+
+        if (tryAddr > (ULONG_PTR)pMaxAddr)
+        {
+            return NULL;
+        }
+
+        return OsFindFreeRegion(tryAddr, (ULONG_PTR)pMaxAddr, FALSE);
+    }
+#endif
+
+    //-------------------------------------------------------------------------
+    bool IsExecutableAddress(LPVOID pAddress)
+    {
+        bool bExecutable = false;
+        FILE* pMaps = fopen("/proc/self/maps", "r");
+
+        if (pMaps)
+        {
+            unsigned long long start, end;
+            char perms[5];
+            char line[512];
+
+            while (fgets(line, sizeof(line), pMaps))
+            {
+                if ((sscanf(line, "%llx-%llx %4s", &start, &end, perms) == 3) && ((ULONG_PTR)pAddress >= start) && ((ULONG_PTR)pAddress < end))
+                {
+                    bExecutable = (perms[2] == 'x');
+                    break;
+                }
+            }
+
+            fclose(pMaps);
+        }
+
+        return bExecutable;
+    }
+#endif
+
+    //-------------------------------------------------------------------------
+    // Region allocator:
+    //-------------------------------------------------------------------------
+
+    //-------------------------------------------------------------------------
+    void InitializeBuffer(void)
+    {
+        // Nothing to do for now.
+    }
+
+    //-------------------------------------------------------------------------
+    void UninitializeBuffer(void)
+    {
+        PMEMORY_REGION pRegion = g_pMemoryRegions;
+        g_pMemoryRegions = nullptr;
+        memset(g_regionCache, 0, sizeof(g_regionCache));
+
+        while (pRegion)
+        {
+            PMEMORY_REGION pNext = pRegion->pNext;
+            OsRelease(pRegion);
+            pRegion = pNext;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    static BOOL HasFreeSlot(PMEMORY_REGION pRegion)
+    {
+        return (pRegion->pFree || ((ULONG_PTR)pRegion->pUnused < ((ULONG_PTR)pRegion + MEMORY_REGION_SIZE)));
+    }
+
+    //-------------------------------------------------------------------------
+    static BOOL IsRegionInRange(PMEMORY_REGION pRegion, ULONG_PTR minAddr, ULONG_PTR maxAddr)
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        return (((ULONG_PTR)pRegion >= minAddr) && ((ULONG_PTR)pRegion < maxAddr));
+#else
+        return TRUE;
+#endif
+    }
+
+    //-------------------------------------------------------------------------
+    static PREGION_CACHE_ENTRY GetCacheEntry(LPVOID pOrigin)
+    {
+        // Every target in the same 2GB window shares an entry, which in practice means one per module.
+        ULONG_PTR window = ((ULONG_PTR)pOrigin >> 31) + 1;
+        return &g_regionCache[window & (REGION_CACHE_SIZE - 1)];
+    }
+
+    //-------------------------------------------------------------------------
+    static PMEMORY_REGION CreateMemoryRegion(LPVOID pAddress)
+    {
+        PMEMORY_REGION pRegion = (PMEMORY_REGION)OsReserve(pAddress);
+
+        if (pRegion)
+        {
+            if (!OsCommit(pRegion))
+            {
+                OsRelease(pRegion);
+                return NULL;
+            }
+
+            // The header takes up the first slot, the rest are handed out in order and committed a page at a time.
+            pRegion->pFree = NULL;
+            pRegion->pUnused = (PMEMORY_SLOT)pRegion + 1;
+            pRegion->pCommitEnd = (PMEMORY_SLOT)((ULONG_PTR)pRegion + MEMORY_BLOCK_SIZE);
+            pRegion->usedCount = 0;
+            pRegion->pNext = g_pMemoryRegions;
+            g_pMemoryRegions = pRegion;
+        }
+
+        return pRegion;
+    }
+
+    //-------------------------------------------------------------------------
+    static PMEMORY_REGION GetMemoryRegion(LPVOID pOrigin)
+    {
+        PMEMORY_REGION pRegion;
+        PREGION_CACHE_ENTRY pCache = GetCacheEntry(pOrigin);
+        ULONG_PTR window = ((ULONG_PTR)pOrigin >> 31) + 1;
         ULONG_PTR minAddr;
         ULONG_PTR maxAddr;
+        OsGetAddressRange(&minAddr, &maxAddr);
 
-        SYSTEM_INFO si;
-        GetSystemInfo(&si);
-        minAddr = (ULONG_PTR)si.lpMinimumApplicationAddress;
-        maxAddr = (ULONG_PTR)si.lpMaximumApplicationAddress;
-
-        // pOrigin ± 512MB
+#if defined(_M_X64) || defined(__x86_64__)
+        // pOrigin ± 1024MB
         if (((ULONG_PTR)pOrigin > MAX_MEMORY_RANGE) && (minAddr < ((ULONG_PTR)pOrigin - MAX_MEMORY_RANGE)))
         {
             minAddr = ((ULONG_PTR)pOrigin - MAX_MEMORY_RANGE);
@@ -184,113 +475,140 @@ namespace MinHook::Buffer
             maxAddr = ((ULONG_PTR)pOrigin + MAX_MEMORY_RANGE);
         }
 
-        // Make room for MEMORY_BLOCK_SIZE bytes.
-        maxAddr -= (MEMORY_BLOCK_SIZE - 1);
+        // Make room for MEMORY_REGION_SIZE bytes.
+        maxAddr -= (MEMORY_REGION_SIZE - 1);
 #endif
 
-        // Look the registered blocks for a reachable one.
-        for (pBlock = g_pMemoryBlocks; pBlock; pBlock = pBlock->pNext)
+        // The last region used for this window is almost always still reachable and has room.
+        if ((pCache->window == window) && pCache->pRegion && IsRegionInRange(pCache->pRegion, minAddr, maxAddr) && HasFreeSlot(pCache->pRegion))
         {
-#if defined(_M_X64) || defined(__x86_64__)
-            // Ignore the blocks too far.
-            if (((ULONG_PTR)pBlock < minAddr) || ((ULONG_PTR)pBlock >= maxAddr))
-            {
-                continue;
-            }
-#endif
-            // The block has at least one unused slot.
-            if (pBlock->pFree)
+            return pCache->pRegion;
+        }
+
+        // Look the registered regions for a reachable one.
+        for (pRegion = g_pMemoryRegions; pRegion; pRegion = pRegion->pNext)
+        {
+            if (IsRegionInRange(pRegion, minAddr, maxAddr) && HasFreeSlot(pRegion))
             {
-                return pBlock;
+                break;
             }
         }
 
 #if defined(_M_X64) || defined(__x86_64__)
-        // Alloc a new block above if not found.
+        // Reserve a new region above if not found.
+        if (!pRegion)
         {
             LPVOID pAlloc = pOrigin;
 
             while ((ULONG_PTR)pAlloc >= minAddr)
             {
-                pAlloc = FindPrevFreeRegion(pAlloc, (LPVOID)minAddr, si.dwAllocationGranularity);
+                pAlloc = OsFindPrevFreeRegion(pAlloc, (LPVOID)minAddr);
 
                 if (!pAlloc)
                 {
                     break;
                 }
 
-                pBlock = (PMEMORY_BLOCK)VirtualAlloc(pAlloc, MEMORY_BLOCK_SIZE, (MEM_COMMIT | MEM_RESERVE), PAGE_EXECUTE_READWRITE);
+                pRegion = CreateMemoryRegion(pAlloc);
 
-                if (pBlock)
+                if (pRegion)
                 {
                     break;
                 }
             }
         }
 
-        // Alloc a new block below if not found.
-        if (!pBlock)
+        // Reserve a new region below if not found.
+        if (!pRegion)
         {
             LPVOID pAlloc = pOrigin;
 
             while ((ULONG_PTR)pAlloc <= maxAddr)
             {
-                pAlloc = FindNextFreeRegion(pAlloc, (LPVOID)maxAddr, si.dwAllocationGranularity);
+                pAlloc = OsFindNextFreeRegion(pAlloc, (LPVOID)maxAddr);
 
                 if (!pAlloc)
                 {
                     break;
                 }
 
-                pBlock = (PMEMORY_BLOCK)VirtualAlloc(pAlloc, MEMORY_BLOCK_SIZE, (MEM_COMMIT | MEM_RESERVE), PAGE_EXECUTE_READWRITE);
+                pRegion = CreateMemoryRegion(pAlloc);
 
-                if (pBlock)
+                if (pRegion)
                 {
                     break;
                 }
             }
         }
 #else
-        // In x86 mode, a memory block can be placed anywhere.
-        pBlock = (PMEMORY_BLOCK)VirtualAlloc(NULL, MEMORY_BLOCK_SIZE, (MEM_COMMIT | MEM_RESERVE), PAGE_EXECUTE_READWRITE);
+        // In x86 mode, a memory region can be placed anywhere.
+        if (!pRegion)
+        {
+            pRegion = CreateMemoryRegion(NULL);
+        }
 #endif
 
-        if (pBlock)
+        if (pRegion)
         {
-            // Build a linked list of all the slots.
-            PMEMORY_SLOT pSlot = (PMEMORY_SLOT)pBlock + 1;
-            pBlock->pFree = NULL;
-            pBlock->usedCount = 0;
+            pCache->window = window;
+            pCache->pRegion = pRegion;
+        }
 
-            do
-            {
-                pSlot->pNext = pBlock->pFree;
-                pBlock->pFree = pSlot;
-                pSlot++;
-            } while ((ULONG_PTR)pSlot - (ULONG_PTR)pBlock <= MEMORY_BLOCK_SIZE - MEMORY_SLOT_SIZE);
+        return pRegion;
+    }
+
+    //-------------------------------------------------------------------------
+    static PMEMORY_REGION FindOwningRegion(LPVOID pBuffer)
+    {
+        // Regions are always reserved on a MEMORY_REGION_SIZE boundary, so the owner is found by rounding down.
+        PMEMORY_REGION pRegion;
+        ULONG_PTR pTargetRegion = (((ULONG_PTR)pBuffer / MEMORY_REGION_SIZE) * MEMORY_REGION_SIZE);
 
-            pBlock->pNext = g_pMemoryBlocks;
-            g_pMemoryBlocks = pBlock;
+        for (pRegion = g_pMemoryRegions; pRegion; pRegion = pRegion->pNext)
+        {
+            if ((ULONG_PTR)pRegion == pTargetRegion)
+            {
+                return pRegion;
+            }
         }
 
-        return pBlock;
+        return NULL;
     }
 
     //-------------------------------------------------------------------------
     LPVOID AllocateBuffer(LPVOID pOrigin)
     {
-        PMEMORY_SLOT  pSlot;
-        PMEMORY_BLOCK pBlock = GetMemoryBlock(pOrigin);
+        PMEMORY_SLOT   pSlot;
+        PMEMORY_REGION pRegion = GetMemoryRegion(pOrigin);
 
-        if (!pBlock)
+        if (!pRegion)
         {
             return NULL;
         }
 
-        // Remove an unused slot from the list.
-        pSlot = pBlock->pFree;
-        pBlock->pFree = pSlot->pNext;
-        pBlock->usedCount++;
+        if (pRegion->pFree)
+        {
+            // Reuse a released slot.
+            pSlot = pRegion->pFree;
+            pRegion->pFree = pSlot->pNext;
+        }
+        else
+        {
+            // Carve a new slot, committing the next page first if needed.
+            if (pRegion->pUnused >= pRegion->pCommitEnd)
+            {
+                if (!OsCommit(pRegion->pCommitEnd))
+                {
+                    return NULL;
+                }
+
+                pRegion->pCommitEnd = (PMEMORY_SLOT)((ULONG_PTR)pRegion->pCommitEnd + MEMORY_BLOCK_SIZE);
+            }
+
+            pSlot = pRegion->pUnused++;
+        }
+
+        pRegion->usedCount++;
 #ifdef _DEBUG
         // Fill the slot with INT3 for debugging.
         memset(pSlot, 0xCC, sizeof(MEMORY_SLOT));
@@ -301,52 +619,43 @@ namespace MinHook::Buffer
     //-------------------------------------------------------------------------
     VOID FreeBuffer(LPVOID pBuffer)
     {
-        PMEMORY_BLOCK pBlock = g_pMemoryBlocks;
-        PMEMORY_BLOCK pPrev = NULL;
-        ULONG_PTR pTargetBlock = (((ULONG_PTR)pBuffer / MEMORY_BLOCK_SIZE) * MEMORY_BLOCK_SIZE);
+        PMEMORY_REGION pRegion = FindOwningRegion(pBuffer);
 
-        while (pBlock)
+        if (pRegion)
         {
-            if ((ULONG_PTR)pBlock == pTargetBlock)
-            {
-                PMEMORY_SLOT pSlot = (PMEMORY_SLOT)pBuffer;
+            PMEMORY_SLOT pSlot = (PMEMORY_SLOT)pBuffer;
 #ifdef _DEBUG
-                // Clear the released slot for debugging.
-                memset(pSlot, 0x00, sizeof(MEMORY_SLOT));
+            // Clear the released slot for debugging.
+            memset(pSlot, 0x00, sizeof(MEMORY_SLOT));
 #endif
-                // Restore the released slot to the list.
-                pSlot->pNext = pBlock->pFree;
-                pBlock->pFree = pSlot;
-                pBlock->usedCount--;
+            // Restore the released slot to the list.
+            pSlot->pNext = pRegion->pFree;
+            pRegion->pFree = pSlot;
+            pRegion->usedCount--;
+
+            // Release the region once its last slot is gone, it's unlinked and dropped from the cache first so nothing can hand it out again.
+            if (pRegion->usedCount == 0)
+            {
+                PMEMORY_REGION* ppLink = &g_pMemoryRegions;
 
-                // Free if unused.
-                if (pBlock->usedCount == 0)
+                while (*ppLink != pRegion)
                 {
-                    if (pPrev)
-                    {
-                        pPrev->pNext = pBlock->pNext;
-                    }
-                    else
+                    ppLink = &(*ppLink)->pNext;
+                }
+
+                *ppLink = pRegion->pNext;
+
+                for (UINT i = 0; i < REGION_CACHE_SIZE; ++i)
+                {
+                    if (g_regionCache[i].pRegion == pRegion)
                     {
-                        g_pMemoryBlocks = pBlock->pNext;
+                        g_regionCache[i].window = 0;
+                        g_regionCache[i].pRegion = NULL;
                     }
-
-                    VirtualFree(pBlock, 0, MEM_RELEASE);
                 }
 
-                break;
+                OsRelease(pRegion);
             }
-
-            pPrev = pBlock;
-            pBlock = pBlock->pNext;
         }
     }
-
-    //-------------------------------------------------------------------------
-    bool IsExecutableAddress(LPVOID pAddress)
-    {
-        MEMORY_BASIC_INFORMATION mi;
-        VirtualQuery(pAddress, &mi, sizeof(mi));
-        return ((mi.State == MEM_COMMIT) && (mi.Protect & PAGE_EXECUTE_FLAGS));
-    }
-}
\ No newline at end of file
+}
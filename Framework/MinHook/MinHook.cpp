@@ -89,6 +89,13 @@ struct
     UINT size;              // Actual number of data items
 } g_hooks;
 
+// Hash index from a target address to its position in g_hooks, so lookups don't scan every hook.
+struct
+{
+    LPUINT pSlots;          // Entry position plus one, zero if the slot is empty
+    UINT capacity;          // Number of slots, always a power of two
+} g_hookIndex;
+
 namespace MinHook
 {
     //-------------------------------------------------------------------------
@@ -102,16 +109,87 @@ namespace MinHook
     HANDLE g_hHeap = nullptr;
 
     //-------------------------------------------------------------------------
-    // Returns INVALID_HOOK_POS if not found.
-    static UINT FindHookEntry(LPVOID pTarget)
+    static UINT HashTarget(LPVOID pTarget)
+    {
+        // Fibonacci hashing, the high bits are well mixed even though function addresses are aligned.
+        return (UINT)(((UINT64)(ULONG_PTR)pTarget * 0x9E3779B97F4A7C15ULL) >> 32) & (g_hookIndex.capacity - 1);
+    }
+
+    //-------------------------------------------------------------------------
+    // Returns the slot holding the target, or the empty slot it would be placed in.
+    static UINT FindIndexSlot(LPVOID pTarget)
+    {
+        UINT slot = HashTarget(pTarget);
+
+        while ((g_hookIndex.pSlots[slot] != 0) && ((ULONG_PTR)g_hooks.pItems[g_hookIndex.pSlots[slot] - 1].pTarget != (ULONG_PTR)pTarget))
+        {
+            slot = (slot + 1) & (g_hookIndex.capacity - 1);
+        }
+
+        return slot;
+    }
+
+    //-------------------------------------------------------------------------
+    // Rebuilds the index from every hook entry, the load factor is kept at or below one half.
+    static BOOL RebuildHookIndex(UINT capacity)
     {
         UINT i;
+        LPUINT pSlots = (LPUINT)HeapAlloc(g_hHeap, HEAP_ZERO_MEMORY, capacity * sizeof(UINT));
+
+        if (pSlots == NULL)
+        {
+            return FALSE;
+        }
+
+        if (g_hookIndex.pSlots != NULL)
+        {
+            HeapFree(g_hHeap, 0, g_hookIndex.pSlots);
+        }
+
+        g_hookIndex.pSlots = pSlots;
+        g_hookIndex.capacity = capacity;
 
         for (i = 0; i < g_hooks.size; ++i)
         {
-            if ((ULONG_PTR)pTarget == (ULONG_PTR)g_hooks.pItems[i].pTarget)
+            g_hookIndex.pSlots[FindIndexSlot(g_hooks.pItems[i].pTarget)] = i + 1;
+        }
+
+        return TRUE;
+    }
+
+    //-------------------------------------------------------------------------
+    static VOID RemoveIndexSlot(UINT slot)
+    {
+        // Backward shift deletion, moves every following entry that would be unreachable back into the gap.
+        UINT next = (slot + 1) & (g_hookIndex.capacity - 1);
+
+        while (g_hookIndex.pSlots[next] != 0)
+        {
+            UINT home = HashTarget(g_hooks.pItems[g_hookIndex.pSlots[next] - 1].pTarget);
+
+            if (((next - home) & (g_hookIndex.capacity - 1)) >= ((next - slot) & (g_hookIndex.capacity - 1)))
+            {
+                g_hookIndex.pSlots[slot] = g_hookIndex.pSlots[next];
+                slot = next;
+            }
+
+            next = (next + 1) & (g_hookIndex.capacity - 1);
+        }
+
+        g_hookIndex.pSlots[slot] = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    // Returns INVALID_HOOK_POS if not found.
+    static UINT FindHookEntry(LPVOID pTarget)
+    {
+        if (g_hookIndex.pSlots != NULL)
+        {
+            UINT slot = FindIndexSlot(pTarget);
+
+            if (g_hookIndex.pSlots[slot] != 0)
             {
-                return i;
+                return g_hookIndex.pSlots[slot] - 1;
             }
         }
 
@@ -119,8 +197,10 @@ namespace MinHook
     }
 
     //-------------------------------------------------------------------------
-    static PHOOK_ENTRY AddHookEntry()
+    static PHOOK_ENTRY AddHookEntry(LPVOID pTarget)
     {
+        PHOOK_ENTRY pHook;
+
         if (g_hooks.pItems == NULL)
         {
             g_hooks.capacity = INITIAL_HOOK_CAPACITY;
@@ -144,15 +224,34 @@ namespace MinHook
             g_hooks.pItems = p;
         }
 
-        return &g_hooks.pItems[g_hooks.size++];
+        pHook = &g_hooks.pItems[g_hooks.size++];
+        pHook->pTarget = pTarget;
+
+        if ((g_hooks.size * 2) > g_hookIndex.capacity)
+        {
+            if (!RebuildHookIndex((g_hookIndex.capacity != 0) ? (g_hookIndex.capacity * 2) : (INITIAL_HOOK_CAPACITY * 2)))
+            {
+                g_hooks.size--;
+                return NULL;
+            }
+        }
+        else
+        {
+            g_hookIndex.pSlots[FindIndexSlot(pTarget)] = g_hooks.size;
+        }
+
+        return pHook;
     }
 
     //-------------------------------------------------------------------------
     static VOID DeleteHookEntry(UINT pos)
     {
+        RemoveIndexSlot(FindIndexSlot(g_hooks.pItems[pos].pTarget));
+
         if (pos < g_hooks.size - 1)
         {
             g_hooks.pItems[pos] = g_hooks.pItems[g_hooks.size - 1];
+            g_hookIndex.pSlots[FindIndexSlot(g_hooks.pItems[pos].pTarget)] = pos + 1; // The last entry was moved into the gap.
         }
 
         g_hooks.size--;
@@ -433,7 +532,7 @@ namespace MinHook
     }
 
     //-------------------------------------------------------------------------
-    static MH_STATUS EnableHookLL(UINT pos, BOOL enable)
+    static MH_STATUS EnableHookLL(UINT pos, BOOL enable, BOOL flush)
     {
         PHOOK_ENTRY pHook = &g_hooks.pItems[pos];
         DWORD oldProtect;
@@ -478,8 +577,11 @@ namespace MinHook
 
         VirtualProtect(pPatchTarget, patchSize, oldProtect, &oldProtect);
 
-        // Just-in-case measure.
-        FlushInstructionCache(GetCurrentProcess(), pPatchTarget, patchSize);
+        // Just-in-case measure, batched callers flush once after every patch is written instead.
+        if (flush)
+        {
+            FlushInstructionCache(GetCurrentProcess(), pPatchTarget, patchSize);
+        }
 
         pHook->isEnabled = enable;
         pHook->queueEnable = enable;
@@ -512,7 +614,7 @@ namespace MinHook
                 {
                     if (g_hooks.pItems[i].isEnabled != enable)
                     {
-                        status = EnableHookLL(i, enable);
+                        status = EnableHookLL(i, enable, FALSE);
 
                         if (status != MH_STATUS::MH_OK)
                         {
@@ -521,6 +623,7 @@ namespace MinHook
                     }
                 }
 
+                FlushInstructionCache(GetCurrentProcess(), NULL, 0); // One flush for every patch, before any thread is resumed.
                 Unfreeze(&threads);
             }
         }
@@ -610,12 +713,19 @@ namespace MinHook
                 Buffer::UninitializeBuffer();
 
                 HeapFree(g_hHeap, 0, g_hooks.pItems);
+                if (g_hookIndex.pSlots != NULL)
+                {
+                    HeapFree(g_hHeap, 0, g_hookIndex.pSlots);
+                }
+
                 HeapDestroy(g_hHeap);
 
                 g_hHeap = NULL;
                 g_hooks.pItems = NULL;
                 g_hooks.capacity = 0;
                 g_hooks.size = 0;
+                g_hookIndex.pSlots = NULL;
+                g_hookIndex.capacity = 0;
             }
         }
         else
@@ -654,11 +764,10 @@ namespace MinHook
 
                         if (status == MH_STATUS::MH_OK)
                         {
-                            PHOOK_ENTRY pHook = AddHookEntry();
+                            PHOOK_ENTRY pHook = AddHookEntry(ct.pTarget);
 
                             if (pHook != NULL)
                             {
-                                pHook->pTarget = ct.pTarget;
 #if defined(_M_X64) || defined(__x86_64__)
                                 pHook->pDetour = ct.pRelay;
 #else
@@ -742,7 +851,7 @@ namespace MinHook
 
                     if (status == MH_STATUS::MH_OK)
                     {
-                        status = EnableHookLL(pos, FALSE);
+                        status = EnableHookLL(pos, FALSE, TRUE);
 
                         Unfreeze(&threads);
                     }
@@ -793,7 +902,7 @@ namespace MinHook
 
                         if (status == MH_STATUS::MH_OK)
                         {
-                            status = EnableHookLL(pos, enable);
+                            status = EnableHookLL(pos, enable, TRUE);
                             Unfreeze(&threads);
                         }
                     }
@@ -912,7 +1021,7 @@ namespace MinHook
 
                         if (pHook->isEnabled != pHook->queueEnable)
                         {
-                            status = EnableHookLL(i, pHook->queueEnable);
+                            status = EnableHookLL(i, pHook->queueEnable, FALSE);
 
                             if (status != MH_STATUS::MH_OK)
                             {
@@ -921,6 +1030,7 @@ namespace MinHook
                         }
                     }
 
+                    FlushInstructionCache(GetCurrentProcess(), NULL, 0); // One flush for every patch, before any thread is resumed.
                     Unfreeze(&threads);
                 }
             }
@@ -0,0 +1,126 @@
+/*
+ * Batch decoding and decoded instruction cache for the Hacker Disassembler Engine.
+ *
+ */
+#include <string.h>
+#include "hdebatch.hpp"
+
+namespace hde
+{
+    static uint32_t hde_raw_disasm(const void* code, hde_raw* hs)
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        return hde64_disasm(code, hs);
+#else
+        return hde32_disasm(code, hs);
+#endif
+    }
+
+    static uint8_t hde_imm_size(const hde_raw* hs)
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        if (hs->flags & F_IMM64)
+            return 8;
+#endif
+        if (hs->flags & F_IMM32)
+            return 4;
+        if (hs->flags & F_IMM16)
+            return 2;
+        if (hs->flags & F_IMM8)
+            return 1;
+        return 0;
+    }
+
+    static void hde_compact(const hde_raw* hs, uint32_t offset, hde_insn* insn)
+    {
+        uint8_t imm_size = hde_imm_size(hs);
+
+        insn->offset = offset;
+        insn->len = hs->len;
+        insn->opcode = hs->opcode;
+        insn->opcode2 = hs->opcode2;
+        insn->modrm = hs->modrm;
+        insn->flags = hs->flags;
+        insn->rel_kind = HDE_REL_NONE;
+        insn->rel_offset = 0;
+        insn->rel_size = 0;
+
+        if (hs->flags & F_ERROR)
+            return;
+
+        if (hs->flags & F_RELATIVE) {
+            // The relative immediate is always the last operand.
+            insn->rel_kind = HDE_REL_BRANCH;
+            insn->rel_size = imm_size;
+            insn->rel_offset = (uint8_t)(hs->len - imm_size);
+        }
+#if defined(_M_X64) || defined(__x86_64__)
+        else if ((hs->flags & F_MODRM) && (hs->flags & F_DISP32) && (hs->modrm_mod == 0) && (hs->modrm_rm == 5)) {
+            // The displacement comes right before any immediate.
+            insn->rel_kind = HDE_REL_RIP;
+            insn->rel_size = 4;
+            insn->rel_offset = (uint8_t)(hs->len - imm_size - 4);
+        }
+#endif
+    }
+
+    uint32_t hde_decode(const void* code, hde_insn* insn)
+    {
+        hde_raw hs;
+        hde_raw_disasm(code, &hs);
+        hde_compact(&hs, 0, insn);
+        return hs.len;
+    }
+
+    uint32_t hde_decode_range(const void* code, size_t size, hde_insn* insns, uint32_t max_count)
+    {
+        const uint8_t* p = (const uint8_t*)code;
+        size_t offset = 0;
+        uint32_t count = 0;
+        hde_raw hs;
+
+        while ((count < max_count) && (offset < size)) {
+            hde_raw_disasm(p + offset, &hs);
+
+            if ((hs.len == 0) || ((offset + hs.len) > size))
+                break;
+
+            hde_compact(&hs, (uint32_t)offset, &insns[count++]);
+
+            if (hs.flags & F_ERROR)
+                break;
+
+            offset += hs.len;
+        }
+
+        return count;
+    }
+
+    void hde_cache_init(hde_cache* cache)
+    {
+        memset(cache, 0, sizeof(hde_cache));
+    }
+
+    uint32_t hde_decode_cached(hde_cache* cache, const void* code, hde_insn* insn)
+    {
+        uintptr_t address = (uintptr_t)code;
+        uint32_t slot = (uint32_t)((address * 0x9E3779B1u) >> 8) & (HDE_CACHE_SIZE - 1);
+
+        if ((cache->address[slot] == address) && (memcmp(cache->bytes[slot], code, cache->insn[slot].len) == 0)) {
+            cache->hits++;
+            *insn = cache->insn[slot];
+            return insn->len;
+        }
+
+        cache->misses++;
+        hde_decode(code, insn);
+
+        if (insn->len <= sizeof(cache->bytes[slot])) {
+            cache->address[slot] = address;
+            memcpy(cache->bytes[slot], code, insn->len);
+            cache->insn[slot] = *insn;
+        }
+
+        return insn->len;
+    }
+}
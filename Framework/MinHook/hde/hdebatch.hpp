@@ -0,0 +1,66 @@
+/*
+ * Batch decoding and decoded instruction cache for the Hacker Disassembler Engine.
+ *
+ * hdebatch.h: C/C++ header file
+ *
+ */
+#pragma once
+
+#include "pstdint.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #include "hde64.hpp"
+    typedef hde64s hde_raw;
+#else
+    #include "hde32.hpp"
+    typedef hde32s hde_raw;
+#endif
+
+// Kind of relative operand in a decoded instruction.
+#define HDE_REL_NONE    0   // No relative operand.
+#define HDE_REL_BRANCH  1   // Relative immediate of a jmp, jcc, call, loop, or jrcxz.
+#define HDE_REL_RIP     2   // RIP relative memory displacement, x64 only.
+
+// Amount of instructions kept in a decode cache, must be a power of two.
+#define HDE_CACHE_SIZE 256
+
+#pragma pack(push,1)
+
+// Compact result of decoding a single instruction, only what's needed to walk instruction boundaries and fix up relative operands.
+typedef struct {
+    uint32_t offset;        // Offset of the instruction from the start of the decoded range.
+    uint8_t len;
+    uint8_t opcode;
+    uint8_t opcode2;
+    uint8_t modrm;
+    uint8_t rel_kind;       // One of the HDE_REL_* values.
+    uint8_t rel_offset;     // Offset of the relative operand inside the instruction.
+    uint8_t rel_size;       // Size of the relative operand in bytes.
+    uint32_t flags;         // Same flags as the full hde struct, check F_ERROR before trusting anything else.
+} hde_insn;
+
+#pragma pack(pop)
+
+// Cache of decoded instructions keyed by address, each entry keeps a copy of the bytes it decoded so patched code is never served stale.
+typedef struct {
+    uintptr_t address[HDE_CACHE_SIZE];      // Zero if the entry is empty.
+    uint8_t bytes[HDE_CACHE_SIZE][16];
+    hde_insn insn[HDE_CACHE_SIZE];
+    uint32_t hits;
+    uint32_t misses;
+} hde_cache;
+
+namespace hde
+{
+    // Decodes a single instruction into the compact form, returns its length.
+    uint32_t hde_decode(const void* code, hde_insn* insn);
+
+    // Decodes instructions back to back from the start of the range, stopping at the end of the range, after an invalid instruction, or once max_count are decoded.
+    // Instructions that would run past the end of the range aren't returned, but up to 15 bytes past the end may still be read while decoding them.
+    // Returns the amount of instructions written.
+    uint32_t hde_decode_range(const void* code, size_t size, hde_insn* insns, uint32_t max_count);
+
+    // Same as "hde_decode", but looks the address up in the cache first.
+    void hde_cache_init(hde_cache* cache);
+    uint32_t hde_decode_cached(hde_cache* cache, const void* code, hde_insn* insn);
+}
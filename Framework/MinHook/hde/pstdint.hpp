@@ -25,10 +25,12 @@
  */
 
 #pragma once
-#include <windows.h>
 #include <cstdint>
 
-// Integer types for HDE.
+// Integer types for HDE, only taken from "windows.h" on Windows so the disassembler itself builds elsewhere. The "CodeRedTests" fuzz tests still need Windows, "pch.hpp" includes "Windows.h" unconditionally.
+#ifdef _WIN32
+#include <windows.h>
+
 typedef INT8   int8_t;
 typedef INT16  int16_t;
 typedef INT32  int32_t;
@@ -36,4 +38,5 @@ typedef INT64  int64_t;
 typedef UINT8  uint8_t;
 typedef UINT16 uint16_t;
 typedef UINT32 uint32_t;
-typedef UINT64 uint64_t;
\ No newline at end of file
+typedef UINT64 uint64_t;
+#endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "ThreadPool.hpp"
+
+namespace CodeRed
+{
+	ThreadPool::ThreadPool() : m_queueHead(0), m_queueCount(0), m_running(false) {}
+
+	ThreadPool::~ThreadPool() { Stop(); }
+
+	bool ThreadPool::IsRunning()
+	{
+		std::lock_guard<std::mutex> queueLock(m_queueMutex);
+		return m_running;
+	}
+
+	size_t ThreadPool::GetThreadCount() const
+	{
+		return m_workers.size();
+	}
+
+	size_t ThreadPool::GetQueuedCount()
+	{
+		std::lock_guard<std::mutex> queueLock(m_queueMutex);
+		return m_queueCount;
+	}
+
+	bool ThreadPool::Start(size_t threadCount, size_t queueCapacity)
+	{
+		std::lock_guard<std::mutex> queueLock(m_queueMutex);
+
+		if (!m_running && (threadCount > 0) && (queueCapacity > 0))
+		{
+			m_queue.assign(queueCapacity, nullptr);
+			m_queueHead = 0;
+			m_queueCount = 0;
+			m_running = true;
+
+			for (size_t i = 0; i < threadCount; i++)
+			{
+				m_workers.emplace_back(&ThreadPool::WorkerThread, this);
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void ThreadPool::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> queueLock(m_queueMutex);
+			m_running = false;
+		}
+
+		m_queueSignal.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+
+		m_workers.clear();
+	}
+
+	bool ThreadPool::TryEnqueue(const Delegate<void()>& task)
+	{
+		{
+			std::lock_guard<std::mutex> queueLock(m_queueMutex);
+
+			if (!m_running || (m_queueCount >= m_queue.size()))
+			{
+				return false;
+			}
+
+			m_queue[(m_queueHead + m_queueCount) % m_queue.size()] = task;
+			m_queueCount++;
+		}
+
+		m_queueSignal.notify_one();
+		return true;
+	}
+
+	void ThreadPool::ParallelFor(size_t itemCount, size_t chunkCount, const Delegate<void(size_t, size_t, size_t)>& body)
+	{
+		chunkCount = std::max<size_t>(1, std::min(chunkCount, itemCount));
+		size_t chunkSize = ((itemCount + chunkCount - 1) / chunkCount);
+
+		// Everything the chunks share lives on this stack frame, which outlives them as we don't return until the last one has signaled.
+		size_t chunksRemaining = chunkCount;
+		std::mutex doneMutex;
+		std::condition_variable doneSignal;
+
+		auto runChunk = [&](size_t chunkIndex) {
+			body(std::min(itemCount, (chunkIndex * chunkSize)), std::min(itemCount, ((chunkIndex + 1) * chunkSize)), chunkIndex);
+
+			// Counted down under the lock, otherwise we could return and destroy the mutex before this chunk is done signaling.
+			std::lock_guard<std::mutex> doneLock(doneMutex);
+
+			if (--chunksRemaining == 0)
+			{
+				doneSignal.notify_all();
+			}
+		};
+
+		for (size_t chunkIndex = 1; chunkIndex < chunkCount; chunkIndex++)
+		{
+			if (!TryEnqueue([&runChunk, chunkIndex]() { runChunk(chunkIndex); }))
+			{
+				runChunk(chunkIndex);
+			}
+		}
+
+		runChunk(0);
+
+		std::unique_lock<std::mutex> doneLock(doneMutex);
+		doneSignal.wait(doneLock, [&]() { return (chunksRemaining == 0); });
+	}
+
+	void ThreadPool::WorkerThread()
+	{
+		while (true)
+		{
+			Delegate<void()> task;
+
+			{
+				std::unique_lock<std::mutex> queueLock(m_queueMutex);
+				m_queueSignal.wait(queueLock, [&]() { return (!m_running || (m_queueCount > 0)); });
+
+				if (m_queueCount == 0) // Only reached once stopped, and everything queued has already been run.
+				{
+					return;
+				}
+
+				task = m_queue[m_queueHead];
+				m_queue[m_queueHead] = nullptr;
+				m_queueHead = ((m_queueHead + 1) % m_queue.size());
+				m_queueCount--;
+			}
+
+			task();
+		}
+	}
+}
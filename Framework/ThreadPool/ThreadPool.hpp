@@ -0,0 +1,40 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	// Fixed amount of worker threads pulling from a bounded queue, tasks are stored in a "Delegate" so queueing never allocates.
+	class ThreadPool
+	{
+	private:
+		std::vector<std::thread> m_workers;
+		std::vector<Delegate<void()>> m_queue;	// Ring buffer of queued tasks, sized once when started.
+		size_t m_queueHead;						// Next task to run.
+		size_t m_queueCount;					// Tasks currently queued.
+		std::mutex m_queueMutex;
+		std::condition_variable m_queueSignal;
+		bool m_running;
+
+	public:
+		ThreadPool();
+		ThreadPool(const ThreadPool& threadPool) = delete;
+		~ThreadPool();
+
+	public:
+		bool IsRunning();
+		size_t GetThreadCount() const;
+		size_t GetQueuedCount();
+		bool Start(size_t threadCount, size_t queueCapacity);
+		void Stop(); // Runs every task still queued, then joins the workers.
+		bool TryEnqueue(const Delegate<void()>& task); // Returns false without queueing if the queue is full or the pool isn't running, the caller decides what to do instead.
+		// Splits "itemCount" into "chunkCount" ranges and runs the body for each as "body(begin, end, chunkIndex)", returning once every chunk is done.
+		// The calling thread runs the first chunk itself and any chunk that didn't fit in the queue, so never call this from a task running on the same pool.
+		void ParallelFor(size_t itemCount, size_t chunkCount, const Delegate<void(size_t, size_t, size_t)>& body);
+
+	private:
+		void WorkerThread();
+
+	public:
+		ThreadPool& operator=(const ThreadPool& threadPool) = delete;
+	};
+}
@@ -0,0 +1,179 @@
+#include "TrigramIndex.hpp"
+
+namespace CodeRed
+{
+	TrigramIndex::TrigramIndex() : m_nameCount(0), m_lastId(0) {}
+
+	TrigramIndex::TrigramIndex(TrigramIndex&& trigramIndex) noexcept :
+		m_postings(std::move(trigramIndex.m_postings)),
+		m_nameCount(trigramIndex.m_nameCount),
+		m_lastId(trigramIndex.m_lastId)
+	{
+		trigramIndex.Clear();
+	}
+
+	TrigramIndex::~TrigramIndex() {}
+
+	bool TrigramIndex::IsEmpty() const
+	{
+		return (m_nameCount == 0);
+	}
+
+	size_t TrigramIndex::GetNameCount() const
+	{
+		return m_nameCount;
+	}
+
+	size_t TrigramIndex::GetTrigramCount() const
+	{
+		return m_postings.size();
+	}
+
+	size_t TrigramIndex::GetMemoryUsage() const
+	{
+		size_t memoryUsage = (m_postings.bucket_count() * sizeof(void*));
+
+		for (const auto& [trigram, trigramPostings] : m_postings)
+		{
+			memoryUsage += (sizeof(trigram) + sizeof(trigramPostings) + sizeof(void*) + trigramPostings.Deltas.capacity()); // Each map node also has a next pointer.
+		}
+
+		return memoryUsage;
+	}
+
+	bool TrigramIndex::Add(uint32_t nameId, std::string_view name)
+	{
+		if ((m_nameCount > 0) && (nameId <= m_lastId))
+		{
+			return false;
+		}
+
+		for (size_t i = 0; (i + TRIGRAM_LENGTH) <= name.size(); i++)
+		{
+			TrigramPostings& trigramPostings = m_postings[PackTrigram(name, i)];
+
+			if ((trigramPostings.Count == 0) || (trigramPostings.LastId != nameId)) // The same trigram can show up more than once in a single name.
+			{
+				AppendDelta(trigramPostings, nameId);
+			}
+		}
+
+		m_lastId = nameId;
+		m_nameCount++;
+		return true;
+	}
+
+	bool TrigramIndex::Query(std::string_view substring, std::vector<uint32_t>& candidates) const
+	{
+		candidates.clear();
+
+		if (substring.size() < TRIGRAM_LENGTH)
+		{
+			return false;
+		}
+
+		std::vector<const TrigramPostings*> queryPostings;
+
+		for (size_t i = 0; (i + TRIGRAM_LENGTH) <= substring.size(); i++)
+		{
+			auto postingsIt = m_postings.find(PackTrigram(substring, i));
+
+			if (postingsIt == m_postings.end())
+			{
+				return true; // No name has this trigram, so nothing can contain the substring.
+			}
+
+			queryPostings.push_back(&postingsIt->second);
+		}
+
+		// Starting from the rarest trigram keeps the candidate list as short as possible the whole way through.
+		std::sort(queryPostings.begin(), queryPostings.end(), [](const TrigramPostings* a, const TrigramPostings* b) { return (a->Count < b->Count); });
+		queryPostings.erase(std::unique(queryPostings.begin(), queryPostings.end()), queryPostings.end());
+		DecodePostings(*queryPostings[0], candidates);
+
+		std::vector<uint32_t> nameIds;
+		std::vector<uint32_t> intersection;
+
+		for (size_t i = 1; (i < queryPostings.size()) && !candidates.empty(); i++)
+		{
+			if (queryPostings[i]->Count > (candidates.size() * TRIGRAM_SKIP_RATIO))
+			{
+				break; // Decoding a list this much longer costs more than verifying the extra candidates it would remove.
+			}
+
+			DecodePostings(*queryPostings[i], nameIds);
+			intersection.clear();
+			std::set_intersection(candidates.begin(), candidates.end(), nameIds.begin(), nameIds.end(), std::back_inserter(intersection));
+			candidates.swap(intersection);
+		}
+
+		return true;
+	}
+
+	void TrigramIndex::Clear()
+	{
+		m_postings.clear();
+		m_nameCount = 0;
+		m_lastId = 0;
+	}
+
+	uint32_t TrigramIndex::PackTrigram(std::string_view text, size_t position)
+	{
+		return ((static_cast<uint32_t>(static_cast<uint8_t>(text[position])) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(text[position + 1])) << 8) | static_cast<uint32_t>(static_cast<uint8_t>(text[position + 2])));
+	}
+
+	void TrigramIndex::AppendDelta(TrigramPostings& trigramPostings, uint32_t nameId)
+	{
+		// Seven bits per byte, the high bit is set on every byte except the last one.
+		uint32_t delta = ((trigramPostings.Count > 0) ? (nameId - trigramPostings.LastId) : nameId);
+
+		while (delta >= 0x80)
+		{
+			trigramPostings.Deltas.push_back(static_cast<uint8_t>(delta | 0x80));
+			delta >>= 7;
+		}
+
+		trigramPostings.Deltas.push_back(static_cast<uint8_t>(delta));
+		trigramPostings.LastId = nameId;
+		trigramPostings.Count++;
+	}
+
+	void TrigramIndex::DecodePostings(const TrigramPostings& trigramPostings, std::vector<uint32_t>& nameIds)
+	{
+		nameIds.clear();
+		nameIds.reserve(trigramPostings.Count);
+		uint32_t nameId = 0;
+		uint32_t delta = 0;
+		uint32_t shift = 0;
+
+		for (uint8_t deltaByte : trigramPostings.Deltas)
+		{
+			delta |= (static_cast<uint32_t>(deltaByte & 0x7F) << shift);
+
+			if (deltaByte & 0x80)
+			{
+				shift += 7;
+			}
+			else
+			{
+				nameId += delta;
+				nameIds.push_back(nameId);
+				delta = 0;
+				shift = 0;
+			}
+		}
+	}
+
+	TrigramIndex& TrigramIndex::operator=(TrigramIndex&& trigramIndex) noexcept
+	{
+		if (this != &trigramIndex)
+		{
+			m_postings = std::move(trigramIndex.m_postings);
+			m_nameCount = trigramIndex.m_nameCount;
+			m_lastId = trigramIndex.m_lastId;
+			trigramIndex.Clear();
+		}
+
+		return *this;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "../../pch.hpp"
+
+namespace CodeRed
+{
+	static constexpr size_t TRIGRAM_LENGTH = 3; // Substrings shorter than this can't use the index.
+	static constexpr size_t TRIGRAM_SKIP_RATIO = 16; // Remaining trigrams are skipped once their list is this many times longer than the candidate list.
+
+	// Every name id a single trigram appears in, stored as variable length deltas since most lists are long runs of close together ids.
+	struct TrigramPostings
+	{
+		std::vector<uint8_t> Deltas;
+		uint32_t LastId;
+		uint32_t Count;
+	};
+
+	// Inverted index from every three character sequence to the names that contain it, used to narrow down substring searches.
+	// Queries only return candidates, a name containing every trigram of a substring doesn't always contain the substring itself.
+	class TrigramIndex
+	{
+	private:
+		std::unordered_map<uint32_t, TrigramPostings> m_postings;
+		size_t m_nameCount;
+		uint32_t m_lastId;
+
+	public:
+		TrigramIndex();
+		TrigramIndex(const TrigramIndex& trigramIndex) = delete;
+		TrigramIndex(TrigramIndex&& trigramIndex) noexcept;
+		~TrigramIndex();
+
+	public:
+		bool IsEmpty() const;
+		size_t GetNameCount() const;
+		size_t GetTrigramCount() const;
+		size_t GetMemoryUsage() const; // Approximate bytes used by the postings and the map itself.
+		bool Add(uint32_t nameId, std::string_view name); // Ids must be added in ascending order, returns false if they aren't.
+		bool Query(std::string_view substring, std::vector<uint32_t>& candidates) const; // Returns false if the substring is too short, candidates are sorted by id.
+		void Clear();
+
+	private:
+		static uint32_t PackTrigram(std::string_view text, size_t position);
+		static void AppendDelta(TrigramPostings& trigramPostings, uint32_t nameId);
+		static void DecodePostings(const TrigramPostings& trigramPostings, std::vector<uint32_t>& nameIds);
+
+	public:
+		TrigramIndex& operator=(const TrigramIndex& trigramIndex) = delete;
+		TrigramIndex& operator=(TrigramIndex&& trigramIndex) noexcept;
+	};
+}
@@ -50,6 +50,8 @@ public:
 	struct FPointer VfTableObject;
 	int32_t ObjectInternalInteger;
 	uint64_t ObjectFlags;
+	class UObject* Outer;
+	class UClass* Class;
 
 public:
 	static TArray<class UObject*>* GObjObjects() { return GObjects; };
@@ -102,6 +104,7 @@ class UFunction : public UStruct
 {
 public:
 	uint64_t FunctionFlags;
+	uint16_t ParamsSize;
 	FPointer Func;
 
 public:
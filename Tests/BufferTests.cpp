@@ -0,0 +1,132 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+#include "../Framework/MinHook/Buffer.hpp"
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace CodeRed::Tests
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	static constexpr uintptr_t BUFFER_REGION_SIZE = 0x10000; // Same as "MEMORY_REGION_SIZE" in "Buffer.cpp".
+	static constexpr uintptr_t BUFFER_MAX_RANGE = 0x40000000; // Same as "MAX_MEMORY_RANGE" in "Buffer.cpp".
+	static constexpr size_t BUFFER_SLOTS_PER_REGION = ((BUFFER_REGION_SIZE / MEMORY_SLOT_SIZE) - 1); // The first slot holds the region header.
+	static constexpr size_t BUFFER_BLOCKED_REGIONS = 256;
+	static constexpr size_t BUFFER_BENCHMARK_ROUNDS = 2000;
+
+	static void BufferOrigin() {}
+
+	static bool IsInReach(void* slot, void* origin)
+	{
+		uintptr_t slotAddress = reinterpret_cast<uintptr_t>(slot);
+		uintptr_t originAddress = reinterpret_cast<uintptr_t>(origin);
+		return ((slotAddress > originAddress) ? (slotAddress - originAddress) : (originAddress - slotAddress)) < BUFFER_MAX_RANGE;
+	}
+
+	static uintptr_t GetRegionBase(void* slot)
+	{
+		return (reinterpret_cast<uintptr_t>(slot) & ~(BUFFER_REGION_SIZE - 1));
+	}
+
+	TEST_CASE(BufferSlotsAreReachableAndExecutable)
+	{
+		void* origin = reinterpret_cast<void*>(&BufferOrigin);
+		std::array<void*, 3> slots = {};
+
+		for (void*& slot : slots)
+		{
+			slot = MinHook::Buffer::AllocateBuffer(origin);
+			TEST_CHECK(slot != nullptr);
+			TEST_CHECK(IsInReach(slot, origin));
+			TEST_CHECK(MinHook::Buffer::IsExecutableAddress(slot));
+			std::memset(slot, 0xCC, MEMORY_SLOT_SIZE);
+		}
+
+		TEST_CHECK((slots[0] != slots[1]) && (slots[1] != slots[2]) && (slots[0] != slots[2]));
+		TEST_CHECK(GetRegionBase(slots[0]) == GetRegionBase(slots[2]));
+
+		for (void* slot : slots)
+		{
+			MinHook::Buffer::FreeBuffer(slot);
+		}
+
+		TEST_CHECK(!MinHook::Buffer::IsExecutableAddress(slots[0])); // The last free gives the whole region back.
+	}
+
+	TEST_CASE(BufferFullRegionsMoveToANewOne)
+	{
+		void* origin = reinterpret_cast<void*>(&BufferOrigin);
+		std::vector<void*> slots;
+
+		for (size_t i = 0; i <= BUFFER_SLOTS_PER_REGION; i++)
+		{
+			slots.push_back(MinHook::Buffer::AllocateBuffer(origin));
+			TEST_CHECK(slots.back() != nullptr);
+		}
+
+		TEST_CHECK(GetRegionBase(slots.front()) == GetRegionBase(slots[BUFFER_SLOTS_PER_REGION - 1]));
+		TEST_CHECK(GetRegionBase(slots.front()) != GetRegionBase(slots.back()));
+		TEST_CHECK(IsInReach(slots.back(), origin));
+
+		for (void* slot : slots)
+		{
+			MinHook::Buffer::FreeBuffer(slot);
+		}
+
+		TEST_CHECK(!MinHook::Buffer::IsExecutableAddress(slots.front()));
+		TEST_CHECK(!MinHook::Buffer::IsExecutableAddress(slots.back()));
+	}
+
+#ifndef _WIN32
+	// Reserves address space around the origin so the nearest free gaps are a known distance away, returns the base of the reservation.
+	static uint8_t* ReserveAround(size_t regionCount)
+	{
+		uint8_t* reservation = static_cast<uint8_t*>(mmap(nullptr, ((regionCount + 1) * BUFFER_REGION_SIZE), PROT_NONE, (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE), -1, 0));
+		return ((reservation != MAP_FAILED) ? reservation : nullptr);
+	}
+
+	TEST_CASE(BufferSkipsMappedAddressSpace)
+	{
+		uint8_t* reservation = ReserveAround(BUFFER_BLOCKED_REGIONS);
+		TEST_CHECK(reservation != nullptr);
+
+		if (reservation)
+		{
+			uint8_t* reservationEnd = (reservation + ((BUFFER_BLOCKED_REGIONS + 1) * BUFFER_REGION_SIZE));
+			void* origin = (reservation + ((BUFFER_BLOCKED_REGIONS / 2) * BUFFER_REGION_SIZE));
+			void* slot = MinHook::Buffer::AllocateBuffer(origin);
+			TEST_CHECK(slot != nullptr);
+			TEST_CHECK((static_cast<uint8_t*>(slot) < reservation) || (static_cast<uint8_t*>(slot) >= reservationEnd));
+			TEST_CHECK(IsInReach(slot, origin));
+			TEST_CHECK(MinHook::Buffer::IsExecutableAddress(slot));
+			MinHook::Buffer::FreeBuffer(slot);
+			munmap(reservation, ((BUFFER_BLOCKED_REGIONS + 1) * BUFFER_REGION_SIZE));
+		}
+	}
+
+	// Every round frees its only slot, so each allocation has to search for and reserve a fresh region.
+	// The blocked case puts the origin inside a large mapping, probing one region per "mmap" would have to walk past all of it.
+	BENCHMARK_CASE(BufferRegionSearch)
+	{
+		void* origin = reinterpret_cast<void*>(&BufferOrigin);
+		double openTime = MeasureNanoseconds(BUFFER_BENCHMARK_ROUNDS, [&]() { MinHook::Buffer::FreeBuffer(MinHook::Buffer::AllocateBuffer(origin)); });
+
+		uint8_t* reservation = ReserveAround(BUFFER_BLOCKED_REGIONS);
+
+		if (reservation)
+		{
+			void* blockedOrigin = (reservation + ((BUFFER_BLOCKED_REGIONS / 2) * BUFFER_REGION_SIZE));
+			double blockedTime = MeasureNanoseconds(BUFFER_BENCHMARK_ROUNDS, [&]() { MinHook::Buffer::FreeBuffer(MinHook::Buffer::AllocateBuffer(blockedOrigin)); });
+			munmap(reservation, ((BUFFER_BLOCKED_REGIONS + 1) * BUFFER_REGION_SIZE));
+			TestRunner::Report("new region " + std::to_string(openTime / 1000.0) + "us, " + std::to_string(BUFFER_BLOCKED_REGIONS / 2) + " mapped regions in the way " + std::to_string(blockedTime / 1000.0) + "us");
+		}
+
+		// With one slot kept alive the region stays cached and allocations never search.
+		void* heldSlot = MinHook::Buffer::AllocateBuffer(origin);
+		double cachedTime = MeasureNanoseconds(BUFFER_BENCHMARK_ROUNDS * 100, [&]() { MinHook::Buffer::FreeBuffer(MinHook::Buffer::AllocateBuffer(origin)); });
+		MinHook::Buffer::FreeBuffer(heldSlot);
+		TestRunner::Report("cached region " + std::to_string(cachedTime) + "ns");
+	}
+#endif
+#endif
+}
@@ -0,0 +1,49 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static uint64_t GetCensusCount(const std::vector<CensusEntry>& censusEntries, uint64_t objectIndex)
+	{
+		for (const CensusEntry& censusEntry : censusEntries)
+		{
+			if (censusEntry.ObjectIndex == objectIndex)
+			{
+				return censusEntry.Count;
+			}
+		}
+
+		return 0;
+	}
+
+	// Script functions called through "ProcessEvent" also reach "ProcessInternal" once the original runs, the census should still only count them once.
+	TEST_CASE(CensusCountsLogicalCallsOnce)
+	{
+		ObjectTable objectTable;
+		UClass* actorClass = objectTable.CreateClass("Class Engine.Actor", UObject::StaticClass());
+		UFunction* unhookedFunction = objectTable.CreateFunction("Function Engine.Actor.Touch");
+		UFunction* hookedFunction = objectTable.CreateFunction("Function Engine.Actor.Tick");
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", actorClass);
+		TEST_CHECK(EventsComponent::HookEventPre(hookedFunction->ObjectInternalInteger, [](PreEvent& event) {}) != 0);
+
+		EventCensus::Reset();
+		EventCensus::Start(1);
+
+		for (UFunction* function : { unhookedFunction, hookedFunction })
+		{
+			EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, [&]() {
+				EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessInternal, []() {});
+			});
+		}
+
+		// Reached only through "ProcessInternal", still counted.
+		EventsComponent::DispatchEvent(caller, unhookedFunction, nullptr, nullptr, EventTypes::ProcessInternal, []() {});
+
+		EventCensus::Stop();
+		std::vector<CensusEntry> functionCounts = EventCensus::GetFunctions();
+		TEST_CHECK(GetCensusCount(functionCounts, unhookedFunction->ObjectInternalInteger) == 2);
+		TEST_CHECK(GetCensusCount(functionCounts, hookedFunction->ObjectInternalInteger) == 1);
+		TEST_CHECK(GetCensusCount(EventCensus::GetClasses(), actorClass->ObjectInternalInteger) == 3);
+		EventCensus::Reset();
+	}
+}
@@ -0,0 +1,92 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t DELEGATE_CALLS = 10000000;
+
+	class DelegateCounter
+	{
+	public:
+		int32_t Total = 0;
+
+	public:
+		int32_t Add(int32_t value) { Total += value; return Total; }
+	};
+
+	// "Bind" static asserts on the same condition, so anything "Fits" rejects can't be bound without a compile error.
+	TEST_CASE(DelegateRejectsOversizedCallables)
+	{
+		std::array<uint8_t, DELEGATE_STORAGE_SIZE> fullCapture{};
+		std::array<uint8_t, DELEGATE_STORAGE_SIZE + 1> oversizedCapture{};
+		auto fullLambda = [fullCapture]() { return fullCapture[0]; };
+		auto oversizedLambda = [oversizedCapture]() { return oversizedCapture[0]; };
+		struct alignas(alignof(std::max_align_t) * 2) OverAligned { void operator()() const {} };
+
+		static_assert(Delegate<uint8_t()>::Fits<decltype(fullLambda)>);
+		static_assert(!Delegate<uint8_t()>::Fits<decltype(oversizedLambda)>);
+		static_assert(!Delegate<void()>::Fits<OverAligned>);
+		static_assert(Delegate<void()>::Fits<std::function<void()>>); // Anything too large can still be wrapped in a "std::function" first.
+		TEST_CHECK(Delegate<uint8_t()>(fullLambda)() == 0);
+	}
+
+	TEST_CASE(DelegateInvokesBoundCallables)
+	{
+		int32_t captured = 5;
+		Delegate<int32_t(int32_t)> addDelegate = [captured](int32_t value) { return (value + captured); };
+		TEST_CHECK(addDelegate.IsBound());
+		TEST_CHECK(addDelegate(2) == 7);
+
+		Delegate<int32_t(int32_t)> copiedDelegate = addDelegate;
+		addDelegate = nullptr;
+		TEST_CHECK(!addDelegate);
+		TEST_CHECK(copiedDelegate(3) == 8);
+
+		DelegateCounter counter;
+		Delegate<int32_t(int32_t)> methodDelegate = Delegate<int32_t(int32_t)>::FromMethod<&DelegateCounter::Add>(&counter);
+		methodDelegate(4);
+		TEST_CHECK(methodDelegate(6) == 10);
+		TEST_CHECK(counter.Total == 10);
+
+		// Captures that aren't trivially copyable are copied and destroyed through the manager.
+		std::shared_ptr<int32_t> sharedValue = std::make_shared<int32_t>(9);
+
+		{
+			Delegate<int32_t()> sharedDelegate = [sharedValue]() { return *sharedValue; };
+			Delegate<int32_t()> sharedCopy = sharedDelegate;
+			TEST_CHECK(sharedValue.use_count() == 3);
+			TEST_CHECK(sharedCopy() == 9);
+			sharedDelegate.Reset();
+			TEST_CHECK(sharedValue.use_count() == 2);
+		}
+
+		TEST_CHECK(sharedValue.use_count() == 1);
+
+		std::array<void*, 4> pointers = { &captured, &counter, &sharedValue, nullptr };
+		TEST_CHECK(CountAllocations([&]() {
+			Delegate<size_t()> pointerDelegate = [pointers]() { return pointers.size(); };
+			Delegate<size_t()> pointerCopy = pointerDelegate;
+			pointerCopy();
+		}) == 0);
+	}
+
+	// Binds and calls a callable with four pointers captured, which is past the small buffer "std::function" has in every standard library.
+	BENCHMARK_CASE(DelegateVersusStdFunction)
+	{
+		std::array<int32_t*, 4> captures = {};
+		int32_t total = 0;
+		captures.fill(&total);
+		auto callable = [captures](int32_t value) { *captures[0] += value; };
+
+		std::function<void(int32_t)> standardFunction = callable;
+		Delegate<void(int32_t)> delegate = callable;
+		double standardCall = MeasureNanoseconds(DELEGATE_CALLS, [&]() { standardFunction(1); });
+		double delegateCall = MeasureNanoseconds(DELEGATE_CALLS, [&]() { delegate(1); });
+		TestRunner::Report("call, std::function " + std::to_string(standardCall) + "ns, delegate " + std::to_string(delegateCall) + "ns");
+
+		double standardBind = MeasureNanoseconds(DELEGATE_CALLS / 10, [&]() { std::function<void(int32_t)> boundFunction = callable; boundFunction(1); });
+		double delegateBind = MeasureNanoseconds(DELEGATE_CALLS / 10, [&]() { Delegate<void(int32_t)> boundDelegate = callable; boundDelegate(1); });
+		TestRunner::Report("bind and call, std::function " + std::to_string(standardBind) + "ns, delegate " + std::to_string(delegateBind) + "ns");
+		TEST_CHECK(total > 0);
+	}
+}
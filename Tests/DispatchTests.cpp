@@ -0,0 +1,350 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	TEST_CASE(DispatchFrameOnlyFirstPerPair)
+	{
+		UObject caller{};
+		UObject otherCaller{};
+		UFunction function{};
+		size_t startDepth = DispatchFrame::GetDepth();
+
+		{
+			DispatchFrame outerFrame(&caller, &function);
+			TEST_CHECK(outerFrame.IsFirst());
+			TEST_CHECK(DispatchFrame::GetDepth() == (startDepth + 1));
+
+			{
+				DispatchFrame sameFrame(&caller, &function);
+				TEST_CHECK(!sameFrame.IsFirst());
+
+				DispatchFrame otherFrame(&otherCaller, &function);
+				TEST_CHECK(otherFrame.IsFirst());
+			}
+
+			TEST_CHECK(DispatchFrame::GetDepth() == (startDepth + 1));
+		}
+
+		TEST_CHECK(DispatchFrame::GetDepth() == startDepth);
+
+		DispatchFrame laterFrame(&caller, &function);
+		TEST_CHECK(laterFrame.IsFirst());
+	}
+
+	// A script function called through "ProcessEvent" also runs through "ProcessInternal" when the original is called, the hooks must only see it once.
+	TEST_CASE(DispatchEventOncePerLogicalCall)
+	{
+		ObjectTable objectTable;
+		UFunction* function = objectTable.CreateFunction("Function Engine.Actor.Tick");
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		UObject* otherCaller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_1", AActor::StaticClass());
+		uint32_t preCalls = 0;
+		uint32_t postCalls = 0;
+		uint32_t originalCalls = 0;
+		uint32_t nestedCalls = 0;
+
+		TEST_CHECK(EventsComponent::HookEventPre(function->ObjectInternalInteger, [&](PreEvent& event) { preCalls++; }) != 0);
+		TEST_CHECK(EventsComponent::HookEventPost(function->ObjectInternalInteger, [&](const PostEvent& event) { postCalls++; }) != 0);
+
+		auto processInternal = [&](UObject* internalCaller) {
+			EventsComponent::DispatchEvent(internalCaller, function, nullptr, nullptr, EventTypes::ProcessInternal, [&]() { originalCalls++; });
+		};
+
+		EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, [&]() { processInternal(caller); });
+		TEST_CHECK(preCalls == 1);
+		TEST_CHECK(postCalls == 1);
+		TEST_CHECK(originalCalls == 1);
+
+		// The same function on a different caller further down the stack is a real call, and is dispatched again.
+		EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, [&]() {
+			processInternal(caller);
+			nestedCalls++;
+			EventsComponent::DispatchEvent(otherCaller, function, nullptr, nullptr, EventTypes::ProcessEvent, [&]() { processInternal(otherCaller); });
+		});
+
+		TEST_CHECK(nestedCalls == 1);
+		TEST_CHECK(preCalls == 3);
+		TEST_CHECK(postCalls == 3);
+		TEST_CHECK(originalCalls == 3);
+
+		// Only reached through "ProcessInternal", like a script function that never goes through "ProcessEvent".
+		processInternal(caller);
+		TEST_CHECK(preCalls == 4);
+		TEST_CHECK(originalCalls == 4);
+		TEST_CHECK(DispatchFrame::GetDepth() == 0);
+	}
+
+	// "EventGuard" only wraps "DispatchFrame" now, both have to agree on what the first call is.
+	TEST_CASE(EventGuardMatchesDispatchFrame)
+	{
+		UObject caller{};
+		UFunction function{};
+		size_t startDepth = DispatchFrame::GetDepth();
+
+		{
+			EventGuard outerGuard(&caller, &function);
+			TEST_CHECK(outerGuard.IsFirst());
+			TEST_CHECK(outerGuard.GetRefs() == 1);
+
+			{
+				DispatchFrame sameFrame(&caller, &function);
+				TEST_CHECK(!sameFrame.IsFirst());
+
+				EventGuard sameGuard;
+				sameGuard.Store(&caller, &function);
+				TEST_CHECK(!sameGuard.IsFirst());
+				TEST_CHECK(sameGuard.GetRefs() == 3);
+
+				EventGuard copiedGuard(sameGuard); // Copies never push a frame of their own.
+				TEST_CHECK(copiedGuard.GetRefs() == 3);
+				TEST_CHECK(DispatchFrame::GetDepth() == (startDepth + 3));
+			}
+
+			TEST_CHECK(outerGuard.GetRefs() == 1);
+		}
+
+		TEST_CHECK(DispatchFrame::GetDepth() == startDepth);
+
+		// Other threads have their own frames, so they never see this threads guard.
+		EventGuard threadGuard(&caller, &function);
+		bool bThreadFirst = false;
+		std::thread([&]() { EventGuard otherGuard(&caller, &function); bThreadFirst = otherGuard.IsFirst(); }).join();
+		TEST_CHECK(bThreadFirst);
+	}
+
+	// "DispatchEvent<false>" is what every call compiles to without "EVENT_PROFILER", it must not record anything even while profiling is on.
+	TEST_CASE(DispatchWithoutProfilerRecordsNothing)
+	{
+		ObjectTable objectTable;
+		UFunction* function = objectTable.CreateFunction("Function Engine.Actor.Tick");
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		size_t preCalls = 0;
+		EventsComponent::HookEventPre(function->ObjectInternalInteger, [&](PreEvent& event) { preCalls++; });
+
+		EventProfiler::Reset();
+		EventProfiler::SetEnabled(true);
+		EventsComponent::DispatchEvent<false>(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, []() {});
+		TEST_CHECK(preCalls == 1);
+		TEST_CHECK(EventProfiler::GetFunctions().empty());
+
+		EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, []() {});
+		std::vector<FunctionProfile> functionProfiles = EventProfiler::GetFunctions();
+		TEST_CHECK(preCalls == 2);
+		TEST_CHECK((functionProfiles.size() == 1) && (functionProfiles[0].PreHooks.Calls == 1));
+		EventProfiler::SetEnabled(false);
+		EventProfiler::Reset();
+	}
+
+	// Cost of a hooked dispatch with the profiler compiled out, built in but disabled, and recording.
+	BENCHMARK_CASE(ProfilerDispatchOverhead)
+	{
+		static constexpr size_t PROFILER_ITERATIONS = 2000000;
+		ObjectTable objectTable;
+		UFunction* function = objectTable.CreateFunction("Function Engine.Actor.Tick");
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		size_t hookCalls = 0;
+		EventsComponent::HookEventPre(function->ObjectInternalInteger, [&](PreEvent& event) { hookCalls++; });
+		EventsComponent::HookEventPost(function->ObjectInternalInteger, [&](const PostEvent& event) { hookCalls++; });
+
+		double compiledOutTime = MeasureNanoseconds(PROFILER_ITERATIONS, [&]() { EventsComponent::DispatchEvent<false>(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, []() {}); });
+		double disabledTime = MeasureNanoseconds(PROFILER_ITERATIONS, [&]() { EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, []() {}); });
+		EventProfiler::SetEnabled(true);
+		double enabledTime = MeasureNanoseconds(PROFILER_ITERATIONS, [&]() { EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, []() {}); });
+		EventProfiler::SetEnabled(false);
+		EventProfiler::Reset();
+
+		TEST_CHECK(hookCalls == (PROFILER_ITERATIONS * 6));
+		TestRunner::Report("compiled out " + std::to_string(compiledOutTime) + "ns, disabled " + std::to_string(disabledTime) + "ns, enabled " + std::to_string(enabledTime) + "ns per hooked call.");
+	}
+
+	// Compares a guarded nested call through "DispatchFrame", the "EventGuard" wrapper, and the global hash map "EventGuard" used to be.
+	BENCHMARK_CASE(DispatchGuardBenchmark)
+	{
+		static constexpr size_t GUARD_ITERATIONS = 1000000;
+		UObject callers[4]{};
+		UFunction functions[4]{};
+		size_t firstCalls = 0;
+
+		double frameTime = MeasureNanoseconds(GUARD_ITERATIONS, [&]() {
+			DispatchFrame outerFrame(&callers[firstCalls & 3], &functions[firstCalls & 3]);
+			DispatchFrame innerFrame(&callers[firstCalls & 3], &functions[firstCalls & 3]);
+			firstCalls += (outerFrame.IsFirst() && !innerFrame.IsFirst());
+		});
+
+		double guardTime = MeasureNanoseconds(GUARD_ITERATIONS, [&]() {
+			EventGuard outerGuard(&callers[firstCalls & 3], &functions[firstCalls & 3]);
+			EventGuard innerGuard(&callers[firstCalls & 3], &functions[firstCalls & 3]);
+			firstCalls += (outerGuard.IsFirst() && !innerGuard.IsFirst());
+		});
+
+		std::unordered_map<uint64_t, uint8_t> refStore;
+
+		double mapTime = MeasureNanoseconds(GUARD_ITERATIONS, [&]() {
+			uint64_t eventKey = ((reinterpret_cast<uintptr_t>(&callers[firstCalls & 3]) * GOLDEN_RATIO_MAGIC) ^ reinterpret_cast<uintptr_t>(&functions[firstCalls & 3]));
+			bool bFirst = (refStore[eventKey]++ == 0);
+			bool bInnerFirst = (refStore[eventKey]++ == 0);
+			refStore[eventKey] -= 2;
+
+			if (refStore[eventKey] == 0)
+			{
+				refStore.erase(eventKey);
+			}
+
+			firstCalls += (bFirst && !bInnerFirst);
+		});
+
+		TEST_CHECK(firstCalls == (GUARD_ITERATIONS * 3));
+		TestRunner::Report("DispatchFrame " + std::to_string(frameTime) + "ns, EventGuard " + std::to_string(guardTime) + "ns, unordered_map " + std::to_string(mapTime) + "ns per nested call.");
+	}
+
+	static constexpr size_t ASYNC_REUSE_ROUNDS = 64;
+	static constexpr size_t ASYNC_WORK_STEPS = 4096;
+	static constexpr size_t ASYNC_BENCHMARK_CALLS = (ASYNC_HOOK_QUEUE_SIZE / 2); // Few enough that the workers never fall behind enough to fill the queue.
+
+	// Spins until the condition is true, or gives up after a few seconds so a broken worker fails the test instead of hanging it.
+	static bool WaitUntil(const Delegate<bool()>& condition)
+	{
+		std::chrono::steady_clock::time_point deadline = (std::chrono::steady_clock::now() + std::chrono::seconds(10));
+
+		while (!condition())
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+			{
+				return false;
+			}
+
+			std::this_thread::yield();
+		}
+
+		return true;
+	}
+
+	TEST_CASE(BufferPoolReusesSizeClasses)
+	{
+		BufferPool bufferPool;
+		PooledBuffer firstBuffer = bufferPool.Acquire(100);
+		TEST_CHECK((firstBuffer.Data != nullptr) && (firstBuffer.Size == 100));
+		bufferPool.Release(firstBuffer);
+
+		PooledBuffer secondBuffer = bufferPool.Acquire(120); // Same 128 byte size class.
+		TEST_CHECK(secondBuffer.Data == firstBuffer.Data);
+		TEST_CHECK(bufferPool.GetAllocations() == 1);
+		TEST_CHECK(bufferPool.GetReuses() == 1);
+
+		PooledBuffer largeBuffer = bufferPool.Acquire((BUFFER_POOL_MIN_SIZE << BUFFER_POOL_CLASSES) + 1);
+		TEST_CHECK(largeBuffer.SizeClass == BUFFER_POOL_UNPOOLED);
+		bufferPool.Release(largeBuffer);
+		bufferPool.Release(secondBuffer);
+		TEST_CHECK(bufferPool.GetReuses() == 1);
+	}
+
+	// With the workers stuck the queue fills up, every callback after that has to run on the calling thread with its own params copy.
+	TEST_CASE(AsyncHooksFallBackWhenTheQueueIsFull)
+	{
+		ObjectTable objectTable;
+		UFunction* function = objectTable.CreateFunction("Function Engine.Actor.Tick", sizeof(int32_t));
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		std::thread::id callingThread = std::this_thread::get_id();
+		std::atomic<bool> bReleased = false;
+		std::atomic<size_t> workerCalls = 0;
+		std::atomic<size_t> callingCalls = 0;
+		std::atomic<int64_t> paramsTotal = 0;
+
+		TEST_CHECK(EventsComponent::HookEventAsync(function->ObjectInternalInteger, [&](const AsyncEvent& event) {
+			const int32_t* params = event.GetParams<int32_t>();
+			paramsTotal += (params ? *params : 0);
+
+			if (std::this_thread::get_id() == callingThread)
+			{
+				callingCalls++;
+			}
+			else
+			{
+				while (!bReleased)
+				{
+					std::this_thread::yield();
+				}
+
+				workerCalls++;
+			}
+		}) != 0);
+
+		size_t totalCalls = (ASYNC_HOOK_QUEUE_SIZE + ASYNC_HOOK_THREADS + 64);
+
+		for (size_t i = 0; i < totalCalls; i++)
+		{
+			int32_t params = static_cast<int32_t>(i);
+			EventsComponent::DispatchEvent(caller, function, &params, nullptr, EventTypes::ProcessEvent, []() {});
+		}
+
+		TEST_CHECK(callingCalls >= 64);
+		TEST_CHECK(EventsComponent::GetAsyncFallbacks() == callingCalls);
+		TEST_CHECK((EventsComponent::GetAsyncQueued() + EventsComponent::GetAsyncFallbacks()) == totalCalls);
+
+		bReleased = true;
+		TEST_CHECK(WaitUntil([&]() { return (workerCalls == EventsComponent::GetAsyncQueued()); }));
+		TEST_CHECK(paramsTotal == static_cast<int64_t>((totalCalls * (totalCalls - 1)) / 2));
+	}
+
+	// Each call waits for the previous callback, so only a buffer a worker hasn't released yet can force a new allocation.
+	TEST_CASE(AsyncHooksReuseParamsBuffers)
+	{
+		ObjectTable objectTable;
+		UFunction* function = objectTable.CreateFunction("Function Engine.Actor.Tick", 48);
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		std::array<uint8_t, 48> params{};
+		std::atomic<size_t> completedCalls = 0;
+		TEST_CHECK(EventsComponent::HookEventAsync(function->ObjectInternalInteger, [&](const AsyncEvent& event) { completedCalls++; }) != 0);
+
+		const BufferPool& asyncBuffers = EventsComponent::GetAsyncBuffers();
+		uint64_t startAllocations = asyncBuffers.GetAllocations();
+		uint64_t startReuses = asyncBuffers.GetReuses();
+
+		for (size_t i = 0; i < ASYNC_REUSE_ROUNDS; i++)
+		{
+			EventsComponent::DispatchEvent(caller, function, params.data(), nullptr, EventTypes::ProcessEvent, []() {});
+			TEST_CHECK(WaitUntil([&]() { return (completedCalls == (i + 1)); }));
+		}
+
+		TEST_CHECK((asyncBuffers.GetAllocations() - startAllocations) <= (ASYNC_HOOK_THREADS + 1));
+		TEST_CHECK((asyncBuffers.GetReuses() - startReuses) >= (ASYNC_REUSE_ROUNDS - (ASYNC_HOOK_THREADS + 1)));
+	}
+
+	// Time the calling thread spends dispatching a post hook that does some work, synchronously versus handed to the async workers.
+	BENCHMARK_CASE(AsyncHookGameThreadCost)
+	{
+		ObjectTable objectTable;
+		UFunction* unhookedFunction = objectTable.CreateFunction("Function Engine.Actor.Tick", 64);
+		UFunction* syncFunction = objectTable.CreateFunction("Function Engine.Actor.PostBeginPlay", 64);
+		UFunction* asyncFunction = objectTable.CreateFunction("Function Engine.Actor.Destroyed", 64);
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		std::array<uint8_t, 64> params{};
+		std::atomic<size_t> asyncCalls = 0;
+
+		auto hookWork = [](const void* hookParams) {
+			uint64_t paramsHash = 0;
+
+			for (size_t i = 0; i < ASYNC_WORK_STEPS; i++)
+			{
+				paramsHash = ((paramsHash * 31) + static_cast<const uint8_t*>(hookParams)[i % 64]);
+			}
+
+			return paramsHash;
+		};
+
+		volatile uint64_t hashSink = 0;
+		EventsComponent::HookEventPost(syncFunction->ObjectInternalInteger, [&](const PostEvent& event) { hashSink = hookWork(event.Params()); });
+		EventsComponent::HookEventAsync(asyncFunction->ObjectInternalInteger, [&](const AsyncEvent& event) { hashSink = hookWork(event.Params()); asyncCalls++; });
+
+		auto measureDispatch = [&](UFunction* function) {
+			return MeasureNanoseconds(ASYNC_BENCHMARK_CALLS, [&]() { EventsComponent::DispatchEvent(caller, function, params.data(), nullptr, EventTypes::ProcessEvent, []() {}); });
+		};
+
+		double unhookedTime = measureDispatch(unhookedFunction);
+		double syncTime = measureDispatch(syncFunction);
+		double asyncTime = measureDispatch(asyncFunction);
+		TEST_CHECK(WaitUntil([&]() { return (asyncCalls == ASYNC_BENCHMARK_CALLS); }));
+		TestRunner::Report("calling thread, unhooked " + std::to_string(unhookedTime) + "ns, synchronous hook " + std::to_string(syncTime) + "ns, async hook " + std::to_string(asyncTime) + "ns, " + std::to_string(EventsComponent::GetAsyncFallbacks()) + " fell back");
+	}
+}
@@ -0,0 +1,69 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t RECORDED_TICKS = 3;
+	static constexpr size_t RECORDED_DESTROYS = 2;
+
+	// Records real dispatches to a file, then replays it and checks the hooks run again for exactly the events the filter lets through.
+	TEST_CASE(TraceReplayCallsHooks)
+	{
+		ObjectTable objectTable;
+		UFunction* tickFunction = objectTable.CreateFunction("Function Engine.Actor.Tick", 16);
+		UFunction* destroyFunction = objectTable.CreateFunction("Function Engine.Actor.Destroyed");
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		std::filesystem::path tracePath = (std::filesystem::temp_directory_path() / "CodeRedReplayTest.trace");
+		std::array<uint8_t, 16> params{};
+		size_t tickCalls = 0;
+		size_t destroyCalls = 0;
+		bool bParamsCleared = true;
+
+		EventsComponent::HookEventPre(tickFunction->ObjectInternalInteger, [&](PreEvent& event) {
+			tickCalls++;
+			bParamsCleared &= (!event.Params() || (static_cast<uint8_t*>(event.Params())[0] == 0));
+
+			if (event.Params())
+			{
+				static_cast<uint8_t*>(event.Params())[0] = 1; // The next replayed event must not see this.
+			}
+		});
+
+		EventsComponent::HookEventPost(destroyFunction->ObjectInternalInteger, [&](const PostEvent& event) { destroyCalls++; });
+		TEST_CHECK(EventRecorder::Start(tracePath));
+
+		for (size_t i = 0; i < RECORDED_TICKS; i++)
+		{
+			EventsComponent::DispatchEvent(caller, tickFunction, params.data(), nullptr, EventTypes::ProcessEvent, []() {});
+		}
+
+		for (size_t i = 0; i < RECORDED_DESTROYS; i++)
+		{
+			EventsComponent::DispatchEvent(caller, destroyFunction, nullptr, nullptr, EventTypes::ProcessEvent, []() {});
+		}
+
+		TEST_CHECK(EventRecorder::Stop() == (RECORDED_TICKS + RECORDED_DESTROYS));
+		tickCalls = 0;
+		destroyCalls = 0;
+		bParamsCleared = true;
+
+		Events.ReplayTrace(tracePath);
+		TEST_CHECK(tickCalls == RECORDED_TICKS);
+		TEST_CHECK(destroyCalls == RECORDED_DESTROYS);
+		TEST_CHECK(bParamsCleared);
+
+		TraceFilter functionFilter;
+		functionFilter.FunctionIndexes.push_back(destroyFunction->ObjectInternalInteger);
+		Events.ReplayTrace(tracePath, functionFilter);
+		TEST_CHECK(tickCalls == RECORDED_TICKS);
+		TEST_CHECK(destroyCalls == (RECORDED_DESTROYS * 2));
+
+		TraceFilter typeFilter;
+		typeFilter.EventType = static_cast<uint8_t>(EventTypes::ProcessInternal);
+		Events.ReplayTrace(tracePath, typeFilter);
+		TEST_CHECK(tickCalls == RECORDED_TICKS);
+		TEST_CHECK(destroyCalls == (RECORDED_DESTROYS * 2));
+
+		std::filesystem::remove(tracePath);
+	}
+}
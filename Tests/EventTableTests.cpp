@@ -0,0 +1,97 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t DISPATCH_FUNCTIONS = 4096;
+	static constexpr size_t DISPATCH_HOOK_STRIDE = 16; // Every 16th function is hooked, the rest are only in "GObjects".
+	static constexpr size_t DISPATCH_CALLS = 1000000;
+
+	TEST_CASE(EventTableTracksHookedFunctions)
+	{
+		EventTable eventTable;
+		std::shared_ptr<HookStats> hookStats = std::make_shared<HookStats>();
+		TEST_CHECK(!eventTable.IsHooked(5));
+		TEST_CHECK(eventTable.GetSize() == 0);
+
+		eventTable.AddPreHook(5, PreHook(1, [](PreEvent& event) {}, HookOptions(), hookStats));
+		TEST_CHECK(eventTable.IsHooked(5));
+		TEST_CHECK(eventTable.IsPreHooked(5));
+		TEST_CHECK(!eventTable.IsPostHooked(5));
+		TEST_CHECK(!eventTable.IsHooked(4));
+		TEST_CHECK(!eventTable.IsHooked(100000)); // Past the end of the table is never hooked.
+		TEST_CHECK(eventTable.GetSize() == 6);
+		TEST_CHECK(eventTable.GetPreHookedCount() == 1);
+
+		eventTable.AddPostHook(5, PostHook(2, [](const PostEvent& event) {}, HookOptions(), hookStats));
+		eventTable.AddPostHook(200, PostHook(2, [](const PostEvent& event) {}, HookOptions(), hookStats));
+		TEST_CHECK(eventTable.GetPostHookedCount() == 2);
+		TEST_CHECK(eventTable.GetHooks(5) && (eventTable.GetHooks(5)->PreHooks.size() == 1) && (eventTable.GetHooks(5)->PostHooks.size() == 1));
+		TEST_CHECK(eventTable.GetHooks(6) == nullptr);
+
+		// Published tables are copied before they're changed, the copy must not share anything with the original.
+		EventTable copiedTable(eventTable);
+		TEST_CHECK(eventTable.RemoveHook(1));
+		TEST_CHECK(!eventTable.IsPreHooked(5));
+		TEST_CHECK(eventTable.IsPostHooked(5));
+		TEST_CHECK(eventTable.GetPreHookedCount() == 0);
+		TEST_CHECK(copiedTable.IsPreHooked(5));
+
+		TEST_CHECK(eventTable.RemoveHook(2)); // One id can be bound to several functions, like pattern hooks.
+		TEST_CHECK(!eventTable.IsHooked(5));
+		TEST_CHECK(!eventTable.IsHooked(200));
+		TEST_CHECK(!eventTable.RemoveHook(2));
+		TEST_CHECK(copiedTable.RemoveHooks(5) == 2);
+		TEST_CHECK(copiedTable.IsPostHooked(200));
+		copiedTable.Clear();
+		TEST_CHECK(!copiedTable.IsHooked(200));
+	}
+
+	// Per call overhead of "DispatchEvent" against a synthetic "GObjects", along with the "std::map" lookup dispatch used to do.
+	BENCHMARK_CASE(EventDispatchBenchmark)
+	{
+		ObjectTable objectTable;
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		std::vector<UFunction*> functions;
+		std::map<uint64_t, uint32_t> hookMap;
+		uint64_t hookCalls = 0;
+		uint64_t originalCalls = 0;
+
+		for (size_t i = 0; i < DISPATCH_FUNCTIONS; i++)
+		{
+			functions.push_back(objectTable.CreateFunction("Function Engine.Actor.Function_" + std::to_string(i)));
+
+			if ((i % DISPATCH_HOOK_STRIDE) == 0)
+			{
+				EventsComponent::HookEventPre(functions.back()->ObjectInternalInteger, [&](PreEvent& event) { hookCalls++; });
+				hookMap[functions.back()->ObjectInternalInteger] = static_cast<uint32_t>(i);
+			}
+		}
+
+		size_t callIndex = 0;
+		Delegate<void()> callOriginal = [&]() { originalCalls++; };
+
+		double hookedTime = MeasureNanoseconds(DISPATCH_CALLS, [&]() {
+			UFunction* function = functions[((callIndex++ * DISPATCH_HOOK_STRIDE) % DISPATCH_FUNCTIONS)];
+			EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, callOriginal);
+		});
+
+		double unhookedTime = MeasureNanoseconds(DISPATCH_CALLS, [&]() {
+			UFunction* function = functions[((callIndex++ * DISPATCH_HOOK_STRIDE) + 1) % DISPATCH_FUNCTIONS];
+			EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, callOriginal);
+		});
+
+		double mapTime = MeasureNanoseconds(DISPATCH_CALLS, [&]() {
+			UFunction* function = functions[(callIndex++ % DISPATCH_FUNCTIONS)];
+
+			if (hookMap.contains(function->ObjectInternalInteger))
+			{
+				hookCalls += (hookMap[function->ObjectInternalInteger] != UINT32_MAX);
+			}
+		});
+
+		TEST_CHECK(originalCalls == (DISPATCH_CALLS * 2));
+		TEST_CHECK(hookCalls >= DISPATCH_CALLS);
+		TestRunner::Report("Hooked " + std::to_string(hookedTime) + "ns, unhooked " + std::to_string(unhookedTime) + "ns per call, map lookup alone " + std::to_string(mapTime) + "ns, " + std::to_string(DISPATCH_FUNCTIONS / DISPATCH_HOOK_STRIDE) + " of " + std::to_string(DISPATCH_FUNCTIONS) + " functions hooked.");
+	}
+}
@@ -0,0 +1,346 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+#ifdef _WIN32
+#include "../Framework/MinHook/MinHook.hpp"
+#endif
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t TELEMETRY_THREADS = 4;
+	static constexpr size_t TELEMETRY_CALLS = 100000;
+	static constexpr size_t TRANSACTION_HOOKS = 64;
+	static constexpr size_t LOOKUP_HOOKS = 256;
+	static constexpr size_t LOOKUP_CALLS = 100000;
+
+	TEST_CASE(HookTelemetrySumsEveryThread)
+	{
+		FunctionHook functionHook;
+		std::vector<std::thread> threads;
+
+		for (size_t i = 0; i < TELEMETRY_THREADS; i++)
+		{
+			threads.emplace_back([&]() {
+				for (size_t j = 0; j < TELEMETRY_CALLS; j++)
+				{
+					functionHook.RecordHit();
+					functionHook.Call<HookTypes::ProcessEvent>();
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		functionHook.RecordHit(); // From a thread that hasn't counted anything yet.
+		TEST_CHECK(functionHook.GetTelemetry().GetHits() == ((TELEMETRY_THREADS * TELEMETRY_CALLS) + 1));
+		TEST_CHECK(functionHook.GetTelemetry().GetOriginalCalls() == (TELEMETRY_THREADS * TELEMETRY_CALLS));
+
+		FunctionHook copiedHook(functionHook);
+		TEST_CHECK(copiedHook.GetTelemetry().GetHits() == 0);
+		copiedHook.RecordHit();
+		TEST_CHECK(copiedHook.GetTelemetry().GetHits() == 1);
+
+		FunctionHook::ResetAllTelemetry();
+		TEST_CHECK(functionHook.GetTelemetry().GetHits() == 0);
+		TEST_CHECK(functionHook.GetTelemetry().GetOriginalCalls() == 0);
+		TEST_CHECK(copiedHook.GetTelemetry().GetHits() == 0);
+	}
+
+	TEST_CASE(ForEachHookVisitsRegisteredHooks)
+	{
+		FunctionHook functionHook;
+		functionHook.SetName("TestHook");
+		size_t hooksFound = 0;
+
+		FunctionHook::ForEachHook([&](const FunctionHook& registeredHook) {
+			if (&registeredHook == &functionHook)
+			{
+				hooksFound++;
+			}
+		});
+
+		TEST_CHECK(hooksFound == 1);
+	}
+
+	class VTableTarget
+	{
+	public:
+		virtual int32_t Compute(int32_t value) { return (value * 2); }
+	};
+
+	static int32_t VTableOverride(VTableTarget* object, int32_t value)
+	{
+		return -value;
+	}
+
+#ifndef _WIN32
+	// Permission column of the mapping that contains the address, read the same way "SwapVTableSlot" does.
+	static std::string GetMappingPermissions(const void* address)
+	{
+		std::ifstream mapsFile("/proc/self/maps");
+		std::string mapsLine;
+
+		while (std::getline(mapsFile, mapsLine))
+		{
+			unsigned long long regionStart = 0;
+			unsigned long long regionEnd = 0;
+			char permissions[5] = {};
+
+			if ((sscanf(mapsLine.c_str(), "%llx-%llx %4s", &regionStart, &regionEnd, permissions) == 3)
+				&& (reinterpret_cast<uintptr_t>(address) >= regionStart)
+				&& (reinterpret_cast<uintptr_t>(address) < regionEnd))
+			{
+				return permissions;
+			}
+		}
+
+		return "";
+	}
+#endif
+
+	TEST_CASE(VTableHookSwapsAndRestores)
+	{
+		VTableTarget targetObject;
+		VTableTarget* volatile virtualObject = &targetObject; // Volatile so the call below has to go through the vtable.
+		void** vfTable = *reinterpret_cast<void***>(&targetObject);
+#ifndef _WIN32
+		std::string originalPermissions = GetMappingPermissions(vfTable);
+		TEST_CHECK(!originalPermissions.empty());
+#endif
+
+		FunctionHook functionHook;
+		TEST_CHECK(functionHook.AttachVTable(&targetObject, 0, reinterpret_cast<void*>(&VTableOverride)));
+		TEST_CHECK(virtualObject->Compute(4) == 8);
+
+		functionHook.Enable();
+		TEST_CHECK(functionHook.IsEnabled());
+		TEST_CHECK(virtualObject->Compute(4) == -4);
+#ifndef _WIN32
+		TEST_CHECK(GetMappingPermissions(vfTable) == originalPermissions);
+#endif
+
+		functionHook.Disable();
+		TEST_CHECK(!functionHook.IsEnabled());
+		TEST_CHECK(virtualObject->Compute(4) == 8);
+#ifndef _WIN32
+		TEST_CHECK(GetMappingPermissions(vfTable) == originalPermissions);
+#endif
+		functionHook.Detach();
+	}
+
+	// A vtable built at runtime lives in writable memory, swapping a slot in it must leave it writable.
+	TEST_CASE(VTableHookKeepsWritableTables)
+	{
+		VTableTarget targetObject;
+		void** originalTable = *reinterpret_cast<void***>(&targetObject);
+		std::vector<void*> heapTable = { originalTable[0] };
+
+		FunctionHook functionHook;
+		TEST_CHECK(functionHook.AttachVTable(heapTable.data(), 0, reinterpret_cast<void*>(&VTableOverride)));
+		functionHook.Enable();
+		TEST_CHECK(heapTable[0] == reinterpret_cast<void*>(&VTableOverride));
+		functionHook.Disable();
+		TEST_CHECK(heapTable[0] == originalTable[0]);
+#ifndef _WIN32
+		TEST_CHECK(GetMappingPermissions(heapTable.data()).substr(0, 2) == "rw");
+#endif
+		heapTable[0] = nullptr; // Would fault if the swap had left the page read only.
+		functionHook.Detach();
+	}
+
+	// Compares the per thread counters against the single shared atomic they replaced, with every thread hammering the same hook.
+	BENCHMARK_CASE(HookTelemetryContention)
+	{
+		FunctionHook functionHook;
+		std::atomic<uint64_t> sharedCounter = 0;
+
+		for (size_t threadCount : { size_t(1), TELEMETRY_THREADS })
+		{
+			auto measureThreads = [&](const Delegate<void()>& body) {
+				std::vector<std::thread> threads;
+				std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+				for (size_t i = 0; i < threadCount; i++)
+				{
+					threads.emplace_back([&]() { MeasureNanoseconds(TELEMETRY_CALLS * 10, body); });
+				}
+
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+
+				return (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count()) / static_cast<double>(TELEMETRY_CALLS * 10));
+			};
+
+			double sharedTime = measureThreads([&]() { sharedCounter.fetch_add(1, std::memory_order_relaxed); });
+			double threadTime = measureThreads([&]() { functionHook.RecordHit(); });
+			TestRunner::Report(std::to_string(threadCount) + " thread(s), shared atomic " + std::to_string(sharedTime) + "ns, per thread " + std::to_string(threadTime) + "ns per call");
+		}
+	}
+
+#ifdef _WIN32
+	// Distinct functions for the transaction benchmark to patch, with enough code that the hooking library has room for its jump.
+	template <size_t N> __declspec(noinline) int32_t TransactionTarget(int32_t value)
+	{
+		volatile int32_t result = value;
+		result += static_cast<int32_t>(N);
+		result *= 3;
+		return result;
+	}
+
+	static int32_t TransactionOverride(int32_t value)
+	{
+		return -1;
+	}
+
+	template <size_t... N> static std::array<int32_t(*)(int32_t), sizeof...(N)> GetTransactionTargets(std::index_sequence<N...>)
+	{
+		return { &TransactionTarget<N>... };
+	}
+
+#ifdef CR_MINHOOK
+	// A queued enable isn't live until "MH_ApplyQueued" succeeds, so the hook can't report being enabled before then.
+	TEST_CASE(TransactionStateWaitsForCommit)
+	{
+		int32_t(*targetFunction)(int32_t) = &TransactionTarget<TRANSACTION_HOOKS>;
+		FunctionHook functionHook;
+		TEST_CHECK(functionHook.Attach(reinterpret_cast<uintptr_t*>(targetFunction), reinterpret_cast<void*>(&TransactionOverride)));
+
+		TEST_CHECK(FunctionHook::BeginTransaction());
+		functionHook.Enable();
+		TEST_CHECK(!functionHook.IsEnabled());
+		TEST_CHECK(targetFunction(1) != -1);
+		TEST_CHECK(FunctionHook::CommitTransaction());
+		TEST_CHECK(functionHook.IsEnabled());
+		TEST_CHECK(targetFunction(1) == -1);
+
+		TEST_CHECK(FunctionHook::BeginTransaction());
+		functionHook.Disable();
+		TEST_CHECK(functionHook.IsEnabled());
+		TEST_CHECK(FunctionHook::CommitTransaction());
+		TEST_CHECK(!functionHook.IsEnabled());
+		TEST_CHECK(targetFunction(1) != -1);
+
+		// Destroyed before its transaction is committed, the commit must not touch it.
+		TEST_CHECK(FunctionHook::BeginTransaction());
+		{
+			FunctionHook temporaryHook;
+			TEST_CHECK(temporaryHook.Attach(reinterpret_cast<uintptr_t*>(&TransactionTarget<TRANSACTION_HOOKS + 1>), reinterpret_cast<void*>(&TransactionOverride)));
+			temporaryHook.Enable();
+		}
+		TEST_CHECK(FunctionHook::CommitTransaction());
+		functionHook.Detach();
+	}
+#endif
+
+	// Installs the same hooks one at a time and in a single transaction, each separate install freezes every thread in the process again.
+	BENCHMARK_CASE(HookTransactionStartup)
+	{
+		std::array<int32_t(*)(int32_t), TRANSACTION_HOOKS> targetFunctions = GetTransactionTargets(std::make_index_sequence<TRANSACTION_HOOKS>());
+
+		auto installHooks = [&](bool bTransaction) {
+			std::vector<FunctionHook> functionHooks(TRANSACTION_HOOKS);
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			if (bTransaction)
+			{
+				TEST_CHECK(FunctionHook::BeginTransaction());
+				TEST_CHECK(!FunctionHook::BeginTransaction());
+			}
+
+			for (size_t i = 0; i < TRANSACTION_HOOKS; i++)
+			{
+				TEST_CHECK(functionHooks[i].Attach(reinterpret_cast<uintptr_t*>(targetFunctions[i]), reinterpret_cast<void*>(&TransactionOverride)));
+				functionHooks[i].Enable();
+			}
+
+			if (bTransaction)
+			{
+				TEST_CHECK(FunctionHook::CommitTransaction());
+			}
+
+			double installTime = (static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()) / 1000.0);
+			size_t hooksCalled = 0;
+
+			for (size_t i = 0; i < TRANSACTION_HOOKS; i++)
+			{
+				TEST_CHECK(functionHooks[i].IsEnabled());
+				TEST_CHECK(functionHooks[i].GetHooked() != nullptr);
+				hooksCalled += (targetFunctions[i](1) == -1);
+			}
+
+			TEST_CHECK(hooksCalled == TRANSACTION_HOOKS);
+
+			// Removing them in a transaction has to give every target its original code back.
+			TEST_CHECK(FunctionHook::BeginTransaction());
+
+			for (FunctionHook& functionHook : functionHooks)
+			{
+				functionHook.Detach();
+			}
+
+			TEST_CHECK(FunctionHook::CommitTransaction());
+			TEST_CHECK(targetFunctions[0](1) == 3);
+			TEST_CHECK(targetFunctions[TRANSACTION_HOOKS - 1](1) == static_cast<int32_t>(TRANSACTION_HOOKS * 3));
+			return installTime;
+		};
+
+		double separateTime = installHooks(false);
+		double transactionTime = installHooks(true);
+		TestRunner::Report(std::to_string(TRANSACTION_HOOKS) + " hooks, one at a time " + std::to_string(separateTime) + "ms, single transaction " + std::to_string(transactionTime) + "ms");
+	}
+
+	// Queuing doesn't freeze any threads, so it's only the hook entry lookup, which should cost the same no matter how many hooks there are.
+	BENCHMARK_CASE(MinHookEntryLookup)
+	{
+		std::array<int32_t(*)(int32_t), LOOKUP_HOOKS> targetFunctions = GetTransactionTargets(std::make_index_sequence<LOOKUP_HOOKS>());
+		bool bInitialized = (MinHook::MH_Initialize() == MinHook::MH_STATUS::MH_OK); // Already done if "CR_MINHOOK" is used and something was hooked.
+		size_t hookCount = 0;
+
+		for (size_t targetCount : { size_t(16), size_t(64), LOOKUP_HOOKS })
+		{
+			for (; hookCount < targetCount; hookCount++)
+			{
+				LPVOID originalFunction = nullptr;
+				TEST_CHECK(MinHook::MH_CreateHook(reinterpret_cast<LPVOID>(targetFunctions[hookCount]), reinterpret_cast<LPVOID>(&TransactionOverride), &originalFunction) == MinHook::MH_STATUS::MH_OK);
+			}
+
+			size_t lookupIndex = 0;
+
+			double lookupTime = MeasureNanoseconds(LOOKUP_CALLS, [&]() {
+				LPVOID targetFunction = reinterpret_cast<LPVOID>(targetFunctions[(lookupIndex++ * 7) % targetCount]);
+				MinHook::MH_QueueEnableHook(targetFunction);
+				MinHook::MH_QueueDisableHook(targetFunction);
+			});
+
+			TestRunner::Report(std::to_string(targetCount) + " hooks, " + std::to_string(lookupTime / 2.0) + "ns per lookup");
+		}
+
+		// Removing entries moves the last one into the gap, every remaining hook must still be found afterwards.
+		for (size_t i = 0; i < LOOKUP_HOOKS; i += 2)
+		{
+			TEST_CHECK(MinHook::MH_RemoveHook(reinterpret_cast<LPVOID>(targetFunctions[i])) == MinHook::MH_STATUS::MH_OK);
+		}
+
+		for (size_t i = 0; i < LOOKUP_HOOKS; i++)
+		{
+			MinHook::MH_STATUS expectedStatus = (((i % 2) == 0) ? MinHook::MH_STATUS::MH_ERROR_NOT_CREATED : MinHook::MH_STATUS::MH_OK);
+			TEST_CHECK(MinHook::MH_QueueEnableHook(reinterpret_cast<LPVOID>(targetFunctions[i])) == expectedStatus);
+			MinHook::MH_QueueDisableHook(reinterpret_cast<LPVOID>(targetFunctions[i]));
+
+			if ((i % 2) != 0)
+			{
+				TEST_CHECK(MinHook::MH_RemoveHook(reinterpret_cast<LPVOID>(targetFunctions[i])) == MinHook::MH_STATUS::MH_OK);
+			}
+		}
+
+		if (bInitialized)
+		{
+			MinHook::MH_Uninitialize();
+		}
+	}
+#endif
+}
@@ -0,0 +1,179 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+#include "../Framework/MinHook/hde/hdebatch.hpp"
+
+namespace CodeRed::Tests
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	static constexpr size_t HDE_FUZZ_ROUNDS = 2000;
+	static constexpr size_t HDE_STREAM_SIZE = 4096;
+	static constexpr size_t HDE_READ_PADDING = 16; // Decoding the last instruction in a range can read up to 15 bytes past it.
+
+	// Prologue, branches, and rip relative operands the trampoline has to fix up.
+	static constexpr std::array<uint8_t, 39> HDE_KNOWN_CODE = {
+		0x55,											// push rbp
+		0x48, 0x89, 0xE5,								// mov rbp, rsp
+		0x48, 0x83, 0xEC, 0x20,							// sub rsp, 0x20
+		0xE8, 0x78, 0x56, 0x34, 0x12,					// call rel32
+		0xEB, 0x05,										// jmp rel8
+		0x48, 0x8D, 0x05, 0x44, 0x33, 0x22, 0x11,		// lea rax, [rip + 0x11223344]
+		0xC7, 0x05, 0x10, 0x00, 0x00, 0x00, 0x2A, 0x00, 0x00, 0x00, // mov dword ptr [rip + 0x10], 0x2A
+		0x0F, 0x84, 0x00, 0x01, 0x00, 0x00,				// je rel32
+		0xC3											// ret
+	};
+
+	// Walks the range one instruction at a time with the same rules as "hde_decode_range", the batch results have to match it exactly.
+	static bool MatchesSingleDecode(const uint8_t* code, size_t size, const std::vector<hde_insn>& insns)
+	{
+		size_t offset = 0;
+		size_t insnIndex = 0;
+
+		while ((insnIndex < insns.size()) && (offset < size))
+		{
+			hde_insn singleInsn{};
+			hde64s rawInsn{};
+			uint32_t length = hde::hde_decode(code + offset, &singleInsn);
+			hde::hde64_disasm(code + offset, &rawInsn);
+			const hde_insn& batchInsn = insns[insnIndex++];
+
+			if ((length != rawInsn.len) || (batchInsn.offset != offset) || (batchInsn.len != singleInsn.len) || (batchInsn.flags != rawInsn.flags) || (batchInsn.opcode != rawInsn.opcode)
+				|| (batchInsn.rel_kind != singleInsn.rel_kind) || (batchInsn.rel_offset != singleInsn.rel_offset) || (batchInsn.rel_size != singleInsn.rel_size))
+			{
+				return false;
+			}
+
+			if (batchInsn.flags & F_ERROR)
+			{
+				return (insnIndex == insns.size());
+			}
+
+			offset += length;
+		}
+
+		// Anything left over has to be an instruction that didn't fit.
+		if ((insnIndex == insns.size()) && (offset < size))
+		{
+			hde_insn nextInsn{};
+			return ((offset + hde::hde_decode(code + offset, &nextInsn)) > size);
+		}
+
+		return (insnIndex == insns.size());
+	}
+
+	static std::vector<hde_insn> DecodeRange(const uint8_t* code, size_t size)
+	{
+		std::vector<hde_insn> insns(size);
+		insns.resize(hde::hde_decode_range(code, size, insns.data(), static_cast<uint32_t>(insns.size())));
+		return insns;
+	}
+
+	TEST_CASE(HdeDecodesKnownCode)
+	{
+		std::vector<hde_insn> insns = DecodeRange(HDE_KNOWN_CODE.data(), HDE_KNOWN_CODE.size());
+		TEST_CHECK(insns.size() == 9);
+		TEST_CHECK(MatchesSingleDecode(HDE_KNOWN_CODE.data(), HDE_KNOWN_CODE.size(), insns));
+
+		if (insns.size() == 9)
+		{
+			TEST_CHECK((insns[3].offset == 8) && (insns[3].rel_kind == HDE_REL_BRANCH) && (insns[3].rel_offset == 1) && (insns[3].rel_size == 4));
+			TEST_CHECK((insns[4].rel_kind == HDE_REL_BRANCH) && (insns[4].rel_size == 1));
+			TEST_CHECK((insns[5].rel_kind == HDE_REL_RIP) && (insns[5].rel_offset == 3) && (insns[5].rel_size == 4));
+			TEST_CHECK((insns[6].len == 10) && (insns[6].rel_kind == HDE_REL_RIP) && (insns[6].rel_offset == 2)); // The displacement comes before the immediate.
+			TEST_CHECK((insns[7].rel_kind == HDE_REL_BRANCH) && (insns[7].rel_offset == 2) && (insns[7].rel_size == 4));
+			TEST_CHECK((insns[8].offset == 38) && (insns[8].rel_kind == HDE_REL_NONE));
+		}
+
+		// Instructions that would run past the end of the range aren't returned.
+		TEST_CHECK(DecodeRange(HDE_KNOWN_CODE.data(), 37).size() == 7);
+		TEST_CHECK(DecodeRange(HDE_KNOWN_CODE.data(), 38).size() == 8);
+
+		hde_insn limitedInsns[3];
+		TEST_CHECK(hde::hde_decode_range(HDE_KNOWN_CODE.data(), HDE_KNOWN_CODE.size(), limitedInsns, 3) == 3);
+	}
+
+	TEST_CASE(HdeCacheNeverServesPatchedCode)
+	{
+		std::unique_ptr<hde_cache> decodeCache = std::make_unique<hde_cache>();
+		hde::hde_cache_init(decodeCache.get());
+		std::array<uint8_t, 32> code{};
+		std::copy(HDE_KNOWN_CODE.begin() + 8, HDE_KNOWN_CODE.begin() + 13, code.begin()); // call rel32
+		hde_insn firstInsn{};
+		hde_insn secondInsn{};
+
+		TEST_CHECK(hde::hde_decode_cached(decodeCache.get(), code.data(), &firstInsn) == 5);
+		TEST_CHECK(hde::hde_decode_cached(decodeCache.get(), code.data(), &secondInsn) == 5);
+		TEST_CHECK((decodeCache->hits == 1) && (decodeCache->misses == 1));
+
+		// Hooking writes a jump over the same address, the cached call must not be returned for it.
+		code[0] = 0xEB;
+		code[1] = 0x05;
+		TEST_CHECK(hde::hde_decode_cached(decodeCache.get(), code.data(), &secondInsn) == 2);
+		TEST_CHECK((secondInsn.rel_kind == HDE_REL_BRANCH) && (secondInsn.rel_size == 1));
+		TEST_CHECK(decodeCache->misses == 2);
+	}
+
+	// Random streams hit invalid and oddly prefixed instructions, copies of this binaries own code are real compiler output.
+	TEST_CASE(HdeFuzzBatchAgainstSingle)
+	{
+		std::mt19937 randomEngine(0xC0DE);
+		std::vector<uint8_t> code(HDE_STREAM_SIZE + HDE_READ_PADDING);
+		size_t mismatches = 0;
+
+		for (size_t round = 0; round < HDE_FUZZ_ROUNDS; round++)
+		{
+			for (uint8_t& codeByte : code)
+			{
+				codeByte = static_cast<uint8_t>(randomEngine());
+			}
+
+			size_t rangeSize = (1 + (randomEngine() % HDE_STREAM_SIZE));
+			mismatches += !MatchesSingleDecode(code.data(), rangeSize, DecodeRange(code.data(), rangeSize));
+		}
+
+		for (const void* function : { reinterpret_cast<const void*>(&MeasureNanoseconds), reinterpret_cast<const void*>(&TestRunner::Run), reinterpret_cast<const void*>(&hde::hde_decode_range) })
+		{
+			std::memcpy(code.data(), function, 1024);
+			mismatches += !MatchesSingleDecode(code.data(), 1024, DecodeRange(code.data(), 1024));
+		}
+
+		TEST_CHECK(mismatches == 0);
+	}
+
+	BENCHMARK_CASE(HdeDecodeThroughput)
+	{
+		std::mt19937 randomEngine(0xC0DE);
+		std::vector<uint8_t> code(HDE_STREAM_SIZE + HDE_READ_PADDING);
+		std::memcpy(code.data(), reinterpret_cast<const void*>(&TestRunner::Run), HDE_STREAM_SIZE);
+		std::vector<hde_insn> insns(HDE_STREAM_SIZE);
+		std::unique_ptr<hde_cache> decodeCache = std::make_unique<hde_cache>();
+		hde::hde_cache_init(decodeCache.get());
+		size_t insnCount = 0;
+
+		double singleTime = MeasureNanoseconds(1000, [&]() {
+			hde64s rawInsn{};
+
+			for (size_t offset = 0; offset < HDE_STREAM_SIZE; offset += std::max<uint8_t>(rawInsn.len, 1))
+			{
+				hde::hde64_disasm(code.data() + offset, &rawInsn);
+				insnCount++;
+			}
+		});
+
+		size_t singleCount = (insnCount / 1000);
+		double batchTime = MeasureNanoseconds(1000, [&]() { insnCount = hde::hde_decode_range(code.data(), HDE_STREAM_SIZE, insns.data(), static_cast<uint32_t>(insns.size())); });
+		size_t cachedCount = std::min<size_t>(insnCount, 64); // Small enough to fit the cache, like the trampoline decoding the same prologues again.
+
+		double cachedTime = MeasureNanoseconds(1000, [&]() {
+			hde_insn cachedInsn{};
+
+			for (size_t i = 0; i < cachedCount; i++)
+			{
+				hde::hde_decode_cached(decodeCache.get(), code.data() + insns[i].offset, &cachedInsn);
+			}
+		});
+
+		auto perSecond = [](size_t instructions, double nanoseconds) { return std::to_string(static_cast<uint64_t>(static_cast<double>(instructions) / (nanoseconds / 1000000000.0))); };
+		TestRunner::Report("Single " + perSecond(singleCount, singleTime) + ", batch " + perSecond(insnCount, batchTime) + ", cached " + perSecond(cachedCount, cachedTime) + " instructions per second.");
+	}
+#endif
+}
@@ -0,0 +1,111 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t REGISTRATION_THREADS = 4;
+	static constexpr size_t REGISTRATION_FUNCTIONS = 64;
+	static constexpr size_t REGISTRATION_DISPATCHES = 1000000;
+
+	TEST_CASE(EpochGuardReclaimsOnceReadersLeave)
+	{
+		std::atomic<bool> bDeleted = false;
+		std::atomic<bool> bReading = false;
+		std::atomic<bool> bRelease = false;
+
+		// A reader on another thread that started before the object was retired keeps it alive.
+		std::thread readerThread([&]() {
+			EpochGuard epochGuard;
+			bReading = true;
+
+			while (!bRelease)
+			{
+				std::this_thread::yield();
+			}
+		});
+
+		while (!bReading)
+		{
+			std::this_thread::yield();
+		}
+
+		EpochGuard::Retire([&]() { bDeleted = true; });
+		EpochGuard::Reclaim();
+		TEST_CHECK(!bDeleted);
+
+		{
+			EpochGuard epochGuard; // Readers that start after it was retired can't see it, so they don't hold it back.
+			bRelease = true;
+			readerThread.join();
+			EpochGuard::Reclaim();
+			TEST_CHECK(bDeleted);
+		}
+
+		TEST_CHECK(EpochGuard::GetRetiredCount() == 0);
+	}
+
+	// Hooks are added and removed from several threads while another one dispatches, a hook that's never removed must see every call.
+	TEST_CASE(HookRegistrationStress)
+	{
+		ObjectTable objectTable;
+		UObject* caller = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		std::vector<UFunction*> functions;
+
+		for (size_t i = 0; i < REGISTRATION_FUNCTIONS; i++)
+		{
+			functions.push_back(objectTable.CreateFunction("Function Engine.Actor.Function_" + std::to_string(i)));
+		}
+
+		std::atomic<uint64_t> stableCalls = 0;
+		std::atomic<bool> bDispatching = true;
+		std::atomic<bool> bFailed = false;
+		TEST_CHECK(EventsComponent::HookEventPre(functions[0]->ObjectInternalInteger, [&](PreEvent& event) { stableCalls++; }) != 0);
+
+		std::vector<std::thread> registerThreads;
+
+		for (size_t t = 0; t < REGISTRATION_THREADS; t++)
+		{
+			registerThreads.emplace_back([&, t]() {
+				for (size_t i = 0; bDispatching; i++)
+				{
+					uint64_t functionIndex = functions[1 + ((i * REGISTRATION_THREADS + t) % (REGISTRATION_FUNCTIONS - 1))]->ObjectInternalInteger;
+					uint32_t hookId = EventsComponent::HookEventPre(functionIndex, [](PreEvent& event) {});
+
+					if (!hookId || !EventsComponent::UnhookEvent(hookId))
+					{
+						bFailed = true;
+					}
+				}
+			});
+		}
+
+		std::thread dispatchThread([&]() {
+			Delegate<void()> callOriginal = []() {};
+
+			for (size_t i = 0; i < REGISTRATION_DISPATCHES; i++)
+			{
+				EventsComponent::DispatchEvent(caller, functions[i % REGISTRATION_FUNCTIONS], nullptr, nullptr, EventTypes::ProcessEvent, callOriginal);
+			}
+
+			bDispatching = false;
+		});
+
+		dispatchThread.join();
+
+		for (std::thread& registerThread : registerThreads)
+		{
+			registerThread.join();
+		}
+
+		TEST_CHECK(!bFailed);
+		TEST_CHECK(stableCalls == ((REGISTRATION_DISPATCHES + REGISTRATION_FUNCTIONS - 1) / REGISTRATION_FUNCTIONS));
+
+		for (size_t i = 1; i < REGISTRATION_FUNCTIONS; i++)
+		{
+			TEST_CHECK(!EventsComponent::IsPreHooked(functions[i]));
+		}
+
+		EpochGuard::Reclaim();
+		TEST_CHECK(EpochGuard::GetRetiredCount() == 0); // Every replaced snapshot is freed once nothing is reading anymore.
+	}
+}
@@ -0,0 +1,252 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t INDEX_BENCHMARK_OBJECTS = 1000000;
+	static constexpr size_t INDEX_BENCHMARK_CLASSES = 3000;
+	static constexpr size_t INDEX_BENCHMARK_QUERIES = 100;
+
+	// The first name a query reads starts another thread that uses the class index, which can only finish if the query isn't holding the index lock.
+	struct IndexProbe
+	{
+		static inline std::atomic<bool> bStarted;
+		static inline std::atomic<bool> bQueried;
+		static inline bool bBlocked;
+
+		static void OnGetFullName(UObject* uObject)
+		{
+			if (!bStarted.exchange(true))
+			{
+				std::thread([]() { Instances.GetObjectsOf(AActor::StaticClass()); bQueried = true; }).detach();
+				std::chrono::steady_clock::time_point timeout = (std::chrono::steady_clock::now() + std::chrono::seconds(2));
+
+				while (!bQueried && (std::chrono::steady_clock::now() < timeout))
+				{
+					std::this_thread::yield();
+				}
+
+				bBlocked = !bQueried;
+			}
+		}
+
+		static bool IsIndexFreeDuring(const Delegate<void()>& query)
+		{
+			bStarted = false;
+			bQueried = false;
+			bBlocked = false;
+			UObject::OnGetFullName = OnGetFullName;
+			query();
+			UObject::OnGetFullName = nullptr;
+
+			if (!bStarted)
+			{
+				return false;
+			}
+
+			while (!bQueried) // A blocked thread still finishes once the lock is released, it's waited for so it doesn't outlive the object table.
+			{
+				std::this_thread::yield();
+			}
+
+			return !bBlocked;
+		}
+	};
+
+	TEST_CASE(DefaultQueriesSkipArchetypes)
+	{
+		ObjectTable objectTable;
+		UObject* archetype = objectTable.Create("Actor Engine.Default__Actor.ArchetypeComponent", AActor::StaticClass(), EObjectFlags::RF_ArchetypeObject);
+		UObject* defaultObject = objectTable.Create("Actor Engine.Default__Actor", AActor::StaticClass(), EObjectFlags::RF_ClassDefaultObject);
+		UObject* instance = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+
+		TEST_CHECK(InstancesComponent::GetObjectType(archetype) == ObjectTypes::Archetype);
+		TEST_CHECK(InstancesComponent::GetObjectType(defaultObject) == ObjectTypes::Default);
+		TEST_CHECK(Instances.GetDefaultInstanceOf<AActor>() == defaultObject);
+		TEST_CHECK(Instances.GetAllDefaultInstancesOf<AActor>() == std::vector<AActor*>{ static_cast<AActor*>(defaultObject) });
+		TEST_CHECK(Instances.GetAllArchetypesOf<AActor>() == std::vector<AActor*>{ static_cast<AActor*>(archetype) });
+		TEST_CHECK(Instances.GetInstanceOf<AActor>() == instance);
+		TEST_CHECK(Instances.GetAllInstancesOf<AActor>().size() == 1);
+	}
+
+	// Pending kill objects are skipped by the instance queries, and once the index has seen a class no query builds a name or allocates anything besides what it returns.
+	TEST_CASE(InstanceQueriesDontAllocate)
+	{
+		ObjectTable objectTable;
+		UObject* defaultObject = objectTable.Create("Actor Engine.Default__Actor", AActor::StaticClass(), EObjectFlags::RF_ClassDefaultObject);
+		UObject* instance = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		objectTable.Create("Actor TheWorld.PersistentLevel.Actor_1", AActor::StaticClass(), EObjectFlags::RF_PendingKill);
+		TEST_CHECK(Instances.GetInstanceOf<AActor>() == instance);
+		TEST_CHECK(Instances.GetAllInstancesOf<AActor>() == std::vector<AActor*>{ static_cast<AActor*>(instance) });
+		TEST_CHECK(Instances.GetDefaultInstanceOf<AActor>() == defaultObject);
+
+		UObject::OnGetFullName = [](UObject* uObject) { TEST_CHECK(!"Instance queries shouldn't build names"); };
+		TEST_CHECK(CountAllocations([]() { Instances.GetInstanceOf<AActor>(); }) == 0);
+		TEST_CHECK(CountAllocations([]() { Instances.GetDefaultInstanceOf<AActor>(); }) == 0);
+		TEST_CHECK(CountAllocations([]() { Instances.GetAllInstancesOf<AActor>(); }) == 1); // Only the returned vector.
+		UObject::OnGetFullName = nullptr;
+	}
+
+	TEST_CASE(ClassQueriesIncludeSubclasses)
+	{
+		ObjectTable objectTable;
+		UObject* actor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		UObject* controller = objectTable.Create("PlayerController TheWorld.PersistentLevel.PlayerController_0", APlayerController::StaticClass());
+		UObject* engine = objectTable.Create("Engine Transient.GameEngine_0", UEngine::StaticClass());
+
+		TEST_CHECK(Instances.GetObjectsOf(AActor::StaticClass()) == std::vector<UObject*>{ actor, controller });
+		TEST_CHECK(Instances.GetInstanceOf<AActor>() == controller);
+		TEST_CHECK(Instances.GetInstanceOf<APlayerController>() == controller);
+
+		// Garbage collected and reused by an object of another class, the new class is queried first so nothing else has looked at the slot yet.
+		objectTable.Destroy(controller->ObjectInternalInteger);
+		objectTable.Reuse(controller->ObjectInternalInteger, "Engine Transient.GameEngine_1", UEngine::StaticClass());
+		TEST_CHECK(Instances.GetAllInstancesOf<UEngine>().size() == 2);
+		TEST_CHECK(Instances.GetInstanceOf<UEngine>() == engine); // Newest is the highest slot, not the last one handed out.
+		TEST_CHECK(Instances.GetObjectsOf(AActor::StaticClass()) == std::vector<UObject*>{ actor });
+	}
+
+	// Nothing ticks between the garbage collector reusing a slot and the next query, every kind of query has to notice it on its own.
+	TEST_CASE(ReusedSlotsAreFoundWithoutATick)
+	{
+		ObjectTable objectTable;
+		UObject* actor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		UObject* controller = objectTable.Create("PlayerController TheWorld.PersistentLevel.PlayerController_0", APlayerController::StaticClass());
+		TEST_CHECK(Instances.GetInstanceOf<AActor>() == controller);
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0") == actor);
+
+		objectTable.Destroy(controller->ObjectInternalInteger);
+		UObject* engine = objectTable.Reuse(controller->ObjectInternalInteger, "Engine Transient.GameEngine_0", UEngine::StaticClass());
+		TEST_CHECK(Instances.GetInstanceOf<UEngine>() == engine);
+
+		objectTable.Destroy(actor->ObjectInternalInteger);
+		UObject* olderEngine = objectTable.Reuse(actor->ObjectInternalInteger, "Engine Transient.GameEngine_1", UEngine::StaticClass());
+		TEST_CHECK(Instances.FindObjectByFullName("Engine Transient.GameEngine_1") == olderEngine);
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0") == nullptr);
+		TEST_CHECK(Instances.GetAllInstancesOf<UEngine>() == std::vector<UEngine*>{ static_cast<UEngine*>(engine), static_cast<UEngine*>(olderEngine) });
+		TEST_CHECK(Instances.GetObjectsOf(AActor::StaticClass()).empty());
+	}
+
+	// Names aren't unique while levels stream in and out, a stale slot that owned a name must not take it with it once it's unnamed.
+	TEST_CASE(FullNameIndexHandsOffDuplicateNames)
+	{
+		ObjectTable objectTable;
+		UObject* olderActor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		UObject* newerActor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0") == newerActor);
+
+		objectTable.Destroy(newerActor->ObjectInternalInteger);
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0") == olderActor);
+
+		// The lower slot is reused by an object with the same name while the higher one still owns it.
+		UObject* higherActor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0") == higherActor);
+		objectTable.Destroy(higherActor->ObjectInternalInteger);
+		UObject* reusedActor = objectTable.Reuse(olderActor->ObjectInternalInteger, "Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0") == reusedActor);
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_1") == nullptr);
+
+		// Every slot is named, not just the owner, so the trigram snapshot taken from the names has all of them.
+		UObject* duplicateActor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		UObject* lastActor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass());
+		TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0") == lastActor);
+		TEST_CHECK(Instances.BuildTrigramIndex());
+		std::vector<UObject*> nameMatches;
+
+		while (!Instances.FindNameMatches("Actor_0", AActor::StaticClass(), false, nameMatches))
+		{
+			std::this_thread::yield();
+		}
+
+		TEST_CHECK(nameMatches == std::vector<UObject*>{ lastActor, duplicateActor, reusedActor });
+		Instances.ClearTrigramIndex();
+	}
+
+	TEST_CASE(NameQueriesDontHoldTheIndexLock)
+	{
+		ObjectTable objectTable;
+
+		for (int32_t i = 0; i < 64; i++)
+		{
+			objectTable.Create("Actor TheWorld.PersistentLevel.Actor_" + std::to_string(i), AActor::StaticClass());
+		}
+
+		UObject* lastActor = objectTable.At(63);
+		TEST_CHECK(IndexProbe::IsIndexFreeDuring([&]() { TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_63") == lastActor); }));
+		TEST_CHECK(IndexProbe::IsIndexFreeDuring([&]() { TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_63") == lastActor); }));
+		TEST_CHECK(IndexProbe::IsIndexFreeDuring([&]() { TEST_CHECK(Instances.BuildTrigramIndex()); }));
+		std::vector<UObject*> nameMatches;
+
+		while (!Instances.FindNameMatches("Actor_63", AActor::StaticClass(), true, nameMatches))
+		{
+			std::this_thread::yield();
+		}
+
+		TEST_CHECK(IndexProbe::IsIndexFreeDuring([&]() { Instances.FindNameMatches("Actor_63", AActor::StaticClass(), true, nameMatches); }));
+		TEST_CHECK(nameMatches == std::vector<UObject*>{ lastActor });
+		Instances.ClearTrigramIndex();
+	}
+
+	// How every typed query found its objects before the class index, a reverse walk over all of "GObjects" asking each object if it's the class.
+	static UObject* FindInstanceByWalk(UClass* uClass)
+	{
+		for (int32_t i = static_cast<int32_t>(UObject::GObjObjects()->size() - INSTANCES_INTERATE_OFFSET) - 1; i >= 0; i--)
+		{
+			UObject* uObject = UObject::GObjObjects()->at(i);
+
+			if (uObject && uObject->IsA(uClass) && !InstancesComponent::IsDefaultObject(uObject))
+			{
+				return uObject;
+			}
+		}
+
+		return nullptr;
+	}
+
+	BENCHMARK_CASE(ClassIndexVersusFullWalk)
+	{
+		ObjectTable objectTable;
+		std::vector<UClass*> actorClasses;
+
+		for (size_t i = 0; i < INDEX_BENCHMARK_CLASSES; i++)
+		{
+			actorClasses.push_back(objectTable.CreateClass("Class TAGame.Actor_" + std::to_string(i), AActor::StaticClass()));
+		}
+
+		for (size_t i = 0; i < INDEX_BENCHMARK_OBJECTS; i++)
+		{
+			if (i == (INDEX_BENCHMARK_OBJECTS / 2))
+			{
+				objectTable.Create("Engine Transient.GameEngine_0", UEngine::StaticClass());
+			}
+
+			objectTable.Create("Actor TheWorld.PersistentLevel.Actor_" + std::to_string(i), actorClasses[i % actorClasses.size()]);
+		}
+
+		UObject* walkResult = nullptr;
+		UObject* indexResult = nullptr;
+		double walkTime = MeasureNanoseconds(INDEX_BENCHMARK_QUERIES / 10, [&]() { walkResult = FindInstanceByWalk(UEngine::StaticClass()); });
+		double buildTime = MeasureNanoseconds(1, [&]() { indexResult = Instances.GetInstanceOf<UEngine>(); });
+		double indexTime = MeasureNanoseconds(INDEX_BENCHMARK_QUERIES, [&]() { indexResult = Instances.GetInstanceOf<UEngine>(); });
+		TEST_CHECK((indexResult != nullptr) && (indexResult == walkResult));
+
+		// Reused slots are found by comparing every slot with "GObjects", which every query pays for even when nothing changed.
+		for (size_t i = 0; i < 1000; i++)
+		{
+			size_t objectIndex = (INDEX_BENCHMARK_CLASSES + (i * 997));
+			objectTable.Destroy(objectIndex);
+			objectTable.Reuse(objectIndex, "Actor TheWorld.PersistentLevel.Reused_" + std::to_string(i), actorClasses[0]);
+		}
+
+		double churnTime = MeasureNanoseconds(1, [&]() { indexResult = Instances.GetInstanceOf<UEngine>(); });
+		std::vector<UObject*> classObjects;
+		double classTime = MeasureNanoseconds(INDEX_BENCHMARK_QUERIES, [&]() { classObjects = Instances.GetObjectsOf(actorClasses[0]); });
+		TEST_CHECK(indexResult == walkResult);
+		TEST_CHECK(classObjects.size() == ((INDEX_BENCHMARK_OBJECTS / INDEX_BENCHMARK_CLASSES) + 1000));
+
+		TestRunner::Report(std::to_string(INDEX_BENCHMARK_OBJECTS) + " objects, " + std::to_string(INDEX_BENCHMARK_CLASSES) + " classes");
+		TestRunner::Report("Full walk GetInstanceOf: " + std::to_string(walkTime / 1000.0) + "us");
+		TestRunner::Report("Index build: " + std::to_string(buildTime / 1000.0) + "us, GetInstanceOf: " + std::to_string(indexTime / 1000.0) + "us (" + std::to_string(walkTime / indexTime) + "x)");
+		TestRunner::Report("GetInstanceOf after 1000 reused slots: " + std::to_string(churnTime / 1000.0) + "us, GetObjectsOf a single class: " + std::to_string(classTime / 1000.0) + "us");
+	}
+}
@@ -0,0 +1,24 @@
+#include "Tests.hpp"
+
+// Usage: "CodeRedTests.exe [filter] [--bench]", only tests whose name contains the filter are run, benchmarks are only run with "--bench".
+int main(int argc, char** argv)
+{
+	std::string filter;
+	bool bBenchmarks = false;
+
+	for (int32_t i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--bench")
+		{
+			bBenchmarks = true;
+		}
+		else
+		{
+			filter = argument;
+		}
+	}
+
+	return ((CodeRed::Tests::TestRunner::Run(filter, bBenchmarks) == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
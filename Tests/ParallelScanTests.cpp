@@ -0,0 +1,121 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t SCAN_TEST_OBJECTS = 40000; // Enough for several chunks of "INSTANCES_SCAN_CHUNK_SIZE".
+	static constexpr size_t SCAN_BENCHMARK_OBJECTS = 1000000;
+
+	TEST_CASE(ThreadPoolParallelForCoversEveryItem)
+	{
+		ThreadPool threadPool;
+		TEST_CHECK(threadPool.Start(3, 16));
+
+		for (size_t itemCount : { size_t(0), size_t(5), size_t(1000003) })
+		{
+			std::vector<std::atomic<uint8_t>> itemVisits(itemCount);
+			std::vector<std::atomic<uint8_t>> chunkVisits(8);
+
+			threadPool.ParallelFor(itemCount, 8, [&](size_t begin, size_t end, size_t chunkIndex) {
+				chunkVisits[chunkIndex]++;
+
+				for (size_t i = begin; i < end; i++)
+				{
+					itemVisits[i]++;
+				}
+			});
+
+			TEST_CHECK(std::all_of(itemVisits.begin(), itemVisits.end(), [](const std::atomic<uint8_t>& visits) { return (visits == 1); }));
+			TEST_CHECK(std::all_of(chunkVisits.begin(), chunkVisits.end(), [](const std::atomic<uint8_t>& visits) { return (visits <= 1); }));
+		}
+
+		// A stopped pool can't queue anything, so every chunk runs on the calling thread instead.
+		threadPool.Stop();
+		size_t itemsVisited = 0;
+		threadPool.ParallelFor(100, 4, [&](size_t begin, size_t end, size_t chunkIndex) { itemsVisited += (end - begin); });
+		TEST_CHECK(itemsVisited == 100);
+	}
+
+	// Every thread count has to give exactly what a single loop over "GObjects" would, including which duplicate name wins.
+	TEST_CASE(ParallelScanMatchesSingleThread)
+	{
+		ObjectTable objectTable;
+		UClass* actorClass = nullptr;
+		UFunction* tickFunction = nullptr;
+		UObject* namedActor = nullptr;
+
+		for (size_t i = 0; i < SCAN_TEST_OBJECTS; i++)
+		{
+			if ((i % 1000) == 0)
+			{
+				actorClass = objectTable.CreateClass("Class Engine.Actor", UObject::StaticClass()); // Duplicates, the last one is what a single loop ends up with.
+				tickFunction = objectTable.CreateFunction("Function Engine.Actor.Tick");
+			}
+			else
+			{
+				UObject* actor = objectTable.Create("Actor TheWorld.PersistentLevel.Actor_" + std::to_string(i), AActor::StaticClass());
+				namedActor = ((i == 1234) ? actor : namedActor);
+			}
+		}
+
+		std::vector<UObject*> actorObjects = Instances.GetObjectsOf(AActor::StaticClass());
+		std::vector<UObject*> singleMatches;
+
+		for (auto objectIt = actorObjects.rbegin(); objectIt != actorObjects.rend(); objectIt++)
+		{
+			if ((*objectIt)->GetFullName().find("Actor_12") != std::string::npos)
+			{
+				singleMatches.push_back(*objectIt);
+			}
+		}
+
+		for (size_t threadCount : { size_t(1), size_t(2), size_t(4), size_t(0) })
+		{
+			Instances.OnDestroy(); // Only clears the static caches and stops the pool, the thread count is kept.
+			Instances.SetScanThreads(threadCount);
+			TEST_CHECK(Instances.FindStaticClass("Class Engine.Actor") == actorClass);
+			TEST_CHECK(Instances.FindStaticFunction("Function Engine.Actor.Tick") == tickFunction);
+			TEST_CHECK(Instances.FindStaticClass("Class Engine.Pawn") == nullptr);
+
+			std::vector<UObject*> nameMatches;
+			Instances.FindNameMatchesByScan("Actor_12", actorObjects, false, nameMatches);
+			TEST_CHECK(nameMatches == singleMatches);
+			Instances.FindNameMatchesByScan("Actor_12", actorObjects, true, nameMatches);
+			TEST_CHECK((nameMatches.size() == 1) && (nameMatches[0] == singleMatches[0]));
+			TEST_CHECK(Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_1234") == namedActor);
+			Instances.ClearClassIndex();
+		}
+	}
+
+	BENCHMARK_CASE(ParallelScanScaling)
+	{
+		ObjectTable objectTable;
+
+		for (size_t i = 0; i < SCAN_BENCHMARK_OBJECTS; i++)
+		{
+			objectTable.Create("Actor TheWorld.PersistentLevel.Actor_" + std::to_string(i), AActor::StaticClass());
+		}
+
+		std::vector<UObject*> actorObjects = Instances.GetObjectsOf(AActor::StaticClass());
+		size_t maxThreads = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), INSTANCES_SCAN_MAX_THREADS);
+		double singleTime = 0.0;
+
+		for (size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+		{
+			Instances.OnDestroy();
+			Instances.SetScanThreads(threadCount);
+			std::vector<UObject*> nameMatches;
+
+			// Static caches and the full name index both name every object, substring scans only name one class.
+			double scanTime = (MeasureNanoseconds(1, [&]() {
+				Instances.FindStaticClass("Class Engine.Actor");
+				Instances.FindNameMatchesByScan("Actor_99999", actorObjects, false, nameMatches);
+				Instances.FindObjectByFullName("Actor TheWorld.PersistentLevel.Actor_0");
+			}) / 1000000.0);
+
+			singleTime = ((threadCount == 1) ? scanTime : singleTime);
+			TEST_CHECK(nameMatches.size() == 11);
+			TestRunner::Report(std::to_string(threadCount) + " thread(s), " + std::to_string(scanTime) + "ms, " + std::to_string(singleTime / scanTime) + "x");
+		}
+	}
+}
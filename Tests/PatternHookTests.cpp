@@ -0,0 +1,82 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	TEST_CASE(PatternHookResolvesAppendedFunctions)
+	{
+		ObjectTable objectTable;
+		UFunction* actorTick = objectTable.CreateFunction("Function Engine.Actor.Tick");
+		UFunction* actorJump = objectTable.CreateFunction("Function Engine.Actor.Jump");
+
+		TEST_CHECK(EventsComponent::HookEventsPre("Function Engine.*.Tick", [](PreEvent& event) {}) != 0);
+		TEST_CHECK(EventsComponent::IsPreHooked(actorTick));
+		TEST_CHECK(!EventsComponent::IsPreHooked(actorJump));
+
+		UFunction* pawnTick = objectTable.CreateFunction("Function Engine.Pawn.Tick");
+		TEST_CHECK(!EventsComponent::IsPreHooked(pawnTick));
+		EventsComponent::ResolvePatternHooks();
+		TEST_CHECK(EventsComponent::IsPreHooked(pawnTick));
+	}
+
+	// The garbage collector hands out freed slots again, and a functions "ObjectInternalInteger" is its slot, so bindings have to follow what the slot holds.
+	TEST_CASE(PatternHookFollowsReusedSlots)
+	{
+		ObjectTable objectTable;
+		UFunction* actorTick = objectTable.CreateFunction("Function Engine.Actor.Tick");
+		UFunction* pawnTick = objectTable.CreateFunction("Function Engine.Pawn.Tick");
+		size_t pawnIndex = pawnTick->ObjectInternalInteger;
+		uint32_t patternId = EventsComponent::HookEventsPre("Function Engine.*.Tick", [](PreEvent& event) {});
+		TEST_CHECK(patternId != 0);
+		TEST_CHECK(EventsComponent::IsPreHooked(pawnTick));
+
+		// Reused by a function that doesn't match, the old binding has to go.
+		objectTable.Destroy(pawnIndex);
+		UFunction* pawnJump = objectTable.ReuseFunction(pawnIndex, "Function Engine.Pawn.Jump");
+		EventsComponent::ResolvePatternHooks();
+		TEST_CHECK(!EventsComponent::IsPreHooked(pawnJump));
+		TEST_CHECK(EventsComponent::IsPreHooked(actorTick));
+
+		// Reused again by one that does, it gets bound without being appended.
+		UFunction* pawnTickReloaded = objectTable.ReuseFunction(pawnIndex, "Function Engine.Pawn.Tick");
+		EventsComponent::ResolvePatternHooks();
+		TEST_CHECK(EventsComponent::IsPreHooked(pawnTickReloaded));
+
+		// Hooks added by index on purpose stay when the pattern binding is dropped.
+		TEST_CHECK(EventsComponent::HookEventPre(pawnIndex, [](PreEvent& event) {}) != 0);
+		objectTable.ReuseFunction(pawnIndex, "Function Engine.Pawn.Jump");
+		EventsComponent::ResolvePatternHooks();
+		TEST_CHECK(EventsComponent::IsPreHooked(pawnIndex));
+		TEST_CHECK(EventsComponent::UnhookEvent(patternId));
+		TEST_CHECK(EventsComponent::IsPreHooked(pawnIndex));
+		TEST_CHECK(!EventsComponent::IsPreHooked(actorTick));
+	}
+
+	TEST_CASE(PatternHookDestroyedSlotIsUnbound)
+	{
+		ObjectTable objectTable;
+		UFunction* actorTick = objectTable.CreateFunction("Function Engine.Actor.Tick");
+		size_t actorIndex = actorTick->ObjectInternalInteger;
+		TEST_CHECK(EventsComponent::HookEventsPre("Function Engine.*.Tick", [](PreEvent& event) {}) != 0);
+		TEST_CHECK(EventsComponent::IsPreHooked(actorIndex));
+
+		objectTable.Destroy(actorIndex);
+		EventsComponent::ResolvePatternHooks();
+		TEST_CHECK(!EventsComponent::IsPreHooked(actorIndex));
+	}
+
+	TEST_CASE(ClassHookFollowsReusedSlots)
+	{
+		ObjectTable objectTable;
+		UClass* actorClass = objectTable.CreateClass("Class Engine.Actor", UObject::StaticClass());
+		UClass* pawnClass = objectTable.CreateClass("Class Engine.Pawn", actorClass);
+		UFunction* actorTick = objectTable.CreateFunction("Function Engine.Actor.Tick", 0, actorClass);
+		size_t tickIndex = actorTick->ObjectInternalInteger;
+		TEST_CHECK(EventsComponent::HookClassPost(actorClass, [](const PostEvent& event) {}) != 0);
+		TEST_CHECK(EventsComponent::IsPostHooked(tickIndex));
+
+		objectTable.ReuseFunction(tickIndex, "Function Engine.Pawn.Tick", 0, pawnClass);
+		EventsComponent::ResolvePatternHooks();
+		TEST_CHECK(!EventsComponent::IsPostHooked(tickIndex));
+	}
+}
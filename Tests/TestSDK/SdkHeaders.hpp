@@ -0,0 +1,238 @@
+#pragma once
+
+/*
+# =================================================================================================== #
+# Test sdk used by the "CodeRedTests" project instead of the placeholder one, only defined with "CR_TESTS".
+# It has the same layout as the placeholder sdk, but objects have real names and classes so the components can be tested without a game.
+# =================================================================================================== #
+*/
+
+#include "../../PlaceholderSDK/GameDefines.hpp"
+
+struct FLinearColor
+{
+	float R;
+	float G; 
+	float B;
+	float A;
+};
+
+struct FColor
+{
+	uint8_t B;
+	uint8_t G;
+	uint8_t R;
+	uint8_t A;
+};
+
+struct UGameViewportClient_TA_execHandleKeyPress_Params
+{
+	int32_t ControllerId;
+	struct FName Key;
+	uint8_t EventType;
+	float AmountDepressed;
+	uint32_t bGamepad : 1;
+	uint32_t ReturnValue : 1;
+};
+
+enum class EInputEvent : uint8_t
+{
+	IE_Pressed = 0,
+	IE_Released = 1,
+	IE_Repeat = 2,
+	IE_DoubleClick = 3,
+	IE_Axis = 4,
+	IE_END = 5
+};
+
+class UObject
+{
+public:
+	struct FPointer VfTableObject;
+	int32_t ObjectInternalInteger;
+	uint64_t ObjectFlags;
+	class UObject* Outer;
+	class UClass* Class;
+	std::string TestFullName; // Returned by "GetFullName", set by the tests "ObjectTable".
+	static inline void(*OnGetFullName)(class UObject* uObject); // Called every time a name is read, so tests can check what else can run while a query is naming objects.
+
+public:
+	static TArray<class UObject*>* GObjObjects() { return GObjects; };
+
+	std::string GetName() { return TestFullName.substr(TestFullName.find_last_of(". ") + 1); };
+	std::string GetNameCPP() { return GetName(); };
+	std::string GetFullName() { if (OnGetFullName) { OnGetFullName(this); } return TestFullName; };
+	struct FName GetPackageName() { return L"None"; };
+	class UObject* GetPackageObj()  { return nullptr; };
+	bool IsA(class UClass* uClass);
+	bool IsA(int objInternalInteger);
+	template<typename T> bool IsA()
+	{
+		return IsA(T::StaticClass());
+	}
+	static UClass* StaticClass();
+};
+
+class UField : public UObject
+{
+public:
+	class UField* Next;
+
+public:
+	static UClass* StaticClass();
+};
+
+class UStruct : public UField
+{
+public:
+	class UField* SuperField;
+
+public:
+	static UClass* StaticClass();
+};
+
+class UClass : public UStruct
+{
+public:
+	static UClass* StaticClass();
+	static UClass* CreateStatic(const std::string& fullName, class UClass* superClass); // Never added to "GObjects", tests that need a class in it create their own.
+};
+
+class UFunction : public UStruct
+{
+public:
+	uint64_t FunctionFlags;
+	uint16_t ParamsSize;
+	FPointer Func;
+
+public:
+	static UClass* StaticClass();
+};
+
+class UAudioDevice : public UObject
+{
+public:
+	static UClass* StaticClass();
+};
+
+class UDateTime : public UObject
+{
+public:
+	static UClass* StaticClass();
+};
+
+class AHUD : public UObject
+{
+public:
+	class UCanvas* Canvas;
+
+public:
+	static UClass* StaticClass();
+};
+
+class ULocalPlayer : public UObject
+{
+public:
+	static UClass* StaticClass();
+};
+
+class UGameViewportClient : public UObject
+{
+public:
+	static UClass* StaticClass();
+};
+
+class UEngine : public UObject
+{
+public:
+	TArray<class ULocalPlayer*> GamePlayers;
+
+public:
+	static UClass* StaticClass();
+
+	static class UEngine* GetEngine() { return nullptr; }
+	static class UAudioDevice* GetAudioDevice() { return nullptr; }
+	static class AWorldInfo* GetCurrentWorldInfo() { return nullptr; }
+};
+
+class AActor : public UObject
+{
+public:
+	static UClass* StaticClass();
+
+	void ConsoleCommand(const std::string& cmd) {}
+};
+
+class AWorldInfo : public AActor
+{
+public:
+	static UClass* StaticClass();
+};
+
+class APlayerController : public AActor
+{
+public:
+	static UClass* StaticClass();
+};
+
+struct FFrame
+{
+	class UStruct* Node;
+	class UObject* Object;
+	uint8_t* Code;
+	uint8_t* Locals;
+};
+
+inline bool UObject::IsA(class UClass* uClass)
+{
+	for (UClass* superClass = Class; superClass; superClass = static_cast<UClass*>(superClass->SuperField))
+	{
+		if (superClass == uClass)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+inline bool UObject::IsA(int objInternalInteger)
+{
+	for (UClass* superClass = Class; superClass; superClass = static_cast<UClass*>(superClass->SuperField))
+	{
+		if (superClass->ObjectInternalInteger == objInternalInteger)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+inline UClass* UClass::CreateStatic(const std::string& fullName, class UClass* superClass)
+{
+	UClass* staticClass = new UClass{};
+	staticClass->ObjectInternalInteger = -1;
+	staticClass->TestFullName = fullName;
+	staticClass->SuperField = superClass;
+	return staticClass;
+}
+
+#define TEST_STATIC_CLASS(className, superClass, fullName) inline UClass* className::StaticClass() { static UClass* staticClass = UClass::CreateStatic(fullName, superClass); return staticClass; }
+
+TEST_STATIC_CLASS(UObject, nullptr, "Class Core.Object")
+TEST_STATIC_CLASS(UField, UObject::StaticClass(), "Class Core.Field")
+TEST_STATIC_CLASS(UStruct, UField::StaticClass(), "Class Core.Struct")
+TEST_STATIC_CLASS(UClass, UStruct::StaticClass(), "Class Core.Class")
+TEST_STATIC_CLASS(UFunction, UStruct::StaticClass(), "Class Core.Function")
+TEST_STATIC_CLASS(UAudioDevice, UObject::StaticClass(), "Class Engine.AudioDevice")
+TEST_STATIC_CLASS(UDateTime, UObject::StaticClass(), "Class Core.DateTime")
+TEST_STATIC_CLASS(AHUD, UObject::StaticClass(), "Class Engine.HUD")
+TEST_STATIC_CLASS(ULocalPlayer, UObject::StaticClass(), "Class Engine.LocalPlayer")
+TEST_STATIC_CLASS(UGameViewportClient, UObject::StaticClass(), "Class Engine.GameViewportClient")
+TEST_STATIC_CLASS(UEngine, UObject::StaticClass(), "Class Engine.Engine")
+TEST_STATIC_CLASS(AActor, UObject::StaticClass(), "Class Engine.Actor")
+TEST_STATIC_CLASS(AWorldInfo, AActor::StaticClass(), "Class Engine.WorldInfo")
+TEST_STATIC_CLASS(APlayerController, AActor::StaticClass(), "Class Engine.PlayerController")
+
+#undef TEST_STATIC_CLASS
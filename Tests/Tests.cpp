@@ -0,0 +1,192 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+static thread_local size_t ThreadAllocations = 0; // Only counts, every allocation still goes through "malloc".
+
+void* operator new(size_t size)
+{
+	ThreadAllocations++;
+	void* memory = std::malloc(size ? size : 1);
+
+	if (!memory)
+	{
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	std::free(memory);
+}
+
+namespace CodeRed::Tests
+{
+	std::vector<TestCase>& TestRunner::GetCases()
+	{
+		static std::vector<TestCase> testCases; // Function local so registering from other translation units doesn't depend on initialization order.
+		return testCases;
+	}
+
+	bool TestRunner::Register(const char* name, void(*function)(), bool bBenchmark)
+	{
+		GetCases().push_back(TestCase{ name, function, bBenchmark });
+		return true;
+	}
+
+	void TestRunner::Check(bool bPassed, const char* expression, const char* file, int32_t line)
+	{
+		m_checks++;
+
+		if (!bPassed)
+		{
+			m_failures++;
+			std::cout << "  FAILED: " << expression << " (" << std::filesystem::path(file).filename().string() << ":" << line << ")" << std::endl;
+		}
+	}
+
+	void TestRunner::Report(const std::string& result)
+	{
+		std::cout << "  " << (m_currentTest ? m_currentTest : "") << ": " << result << std::endl;
+	}
+
+	int32_t TestRunner::Run(const std::string& filter, bool bBenchmarks)
+	{
+		std::vector<TestCase> testCases = GetCases();
+		std::sort(testCases.begin(), testCases.end(), [](const TestCase& a, const TestCase& b) { return (std::strcmp(a.Name, b.Name) < 0); });
+		uint32_t testsRan = 0;
+
+		for (const TestCase& testCase : testCases)
+		{
+			if ((testCase.bBenchmark != bBenchmarks) || (std::string_view(testCase.Name).find(filter) == std::string_view::npos))
+			{
+				continue;
+			}
+
+			uint32_t previousFailures = m_failures;
+			m_currentTest = testCase.Name;
+			std::cout << "[ RUN  ] " << testCase.Name << std::endl;
+			testCase.Function();
+			std::cout << ((m_failures == previousFailures) ? "[  OK  ] " : "[ FAIL ] ") << testCase.Name << std::endl;
+			m_currentTest = nullptr;
+			testsRan++;
+		}
+
+		std::cout << testsRan << " test(s), " << m_checks << " check(s), " << m_failures << " failure(s)." << std::endl;
+		return static_cast<int32_t>(m_failures);
+	}
+
+	ObjectTable::ObjectTable() : m_previousObjects(GObjects)
+	{
+		for (size_t i = 0; i < INSTANCES_INTERATE_OFFSET; i++)
+		{
+			m_objects.push_back(nullptr);
+		}
+
+		GObjects = &m_objects;
+	}
+
+	ObjectTable::~ObjectTable()
+	{
+		// Both components cache object indexes and pointers, so they're reset before the objects are freed.
+		Events.OnDestroy();
+		Instances.OnDestroy();
+		Instances.OnCreate();
+		GObjects = m_previousObjects;
+	}
+
+	size_t ObjectTable::Size() const
+	{
+		return (static_cast<size_t>(m_objects.size()) - INSTANCES_INTERATE_OFFSET);
+	}
+
+	class UObject* ObjectTable::At(size_t objectIndex) const
+	{
+		return m_objects.at(static_cast<int32_t>(objectIndex));
+	}
+
+	class UObject* ObjectTable::Create(const std::string& fullName, class UClass* uClass, uint64_t objectFlags)
+	{
+		UObject* newObject = Allocate<UObject>(fullName, uClass, objectFlags);
+		Insert(newObject);
+		return newObject;
+	}
+
+	class UClass* ObjectTable::CreateClass(const std::string& fullName, class UClass* superClass)
+	{
+		UClass* newClass = Allocate<UClass>(fullName, UClass::StaticClass(), 0);
+		newClass->SuperField = superClass;
+		Insert(newClass);
+		return newClass;
+	}
+
+	class UFunction* ObjectTable::CreateFunction(const std::string& fullName, uint16_t paramsSize, class UObject* outer)
+	{
+		UFunction* newFunction = Allocate<UFunction>(fullName, UFunction::StaticClass(), 0);
+		newFunction->ParamsSize = paramsSize;
+		newFunction->Outer = outer;
+		Insert(newFunction);
+		return newFunction;
+	}
+
+	void ObjectTable::Destroy(size_t objectIndex)
+	{
+		m_objects.at(static_cast<int32_t>(objectIndex)) = nullptr;
+	}
+
+	class UObject* ObjectTable::Reuse(size_t objectIndex, const std::string& fullName, class UClass* uClass, uint64_t objectFlags)
+	{
+		UObject* newObject = Allocate<UObject>(fullName, uClass, objectFlags);
+		Replace(objectIndex, newObject);
+		return newObject;
+	}
+
+	class UFunction* ObjectTable::ReuseFunction(size_t objectIndex, const std::string& fullName, uint16_t paramsSize, class UObject* outer)
+	{
+		UFunction* newFunction = Allocate<UFunction>(fullName, UFunction::StaticClass(), 0);
+		newFunction->ParamsSize = paramsSize;
+		newFunction->Outer = outer;
+		Replace(objectIndex, newFunction);
+		return newFunction;
+	}
+
+	void ObjectTable::Insert(class UObject* uObject)
+	{
+		int32_t objectIndex = static_cast<int32_t>(Size());
+		uObject->ObjectInternalInteger = objectIndex;
+		m_objects.at(objectIndex) = uObject;
+		m_objects.push_back(nullptr);
+	}
+
+	void ObjectTable::Replace(size_t objectIndex, class UObject* uObject)
+	{
+		uObject->ObjectInternalInteger = static_cast<int32_t>(objectIndex);
+		m_objects.at(static_cast<int32_t>(objectIndex)) = uObject;
+	}
+
+	double MeasureNanoseconds(size_t iterations, const Delegate<void()>& body)
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < iterations; i++)
+		{
+			body();
+		}
+
+		std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+		return (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count()) / static_cast<double>(iterations ? iterations : 1));
+	}
+
+	size_t CountAllocations(const Delegate<void()>& body)
+	{
+		size_t previousAllocations = ThreadAllocations;
+		body();
+		return (ThreadAllocations - previousAllocations);
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "../pch.hpp"
+
+namespace CodeRed::Tests
+{
+	// A single test or benchmark, registered before "main" runs by the "TEST_CASE" and "BENCHMARK_CASE" macros.
+	struct TestCase
+	{
+		const char* Name;
+		void(*Function)();
+		bool bBenchmark; // Benchmarks only run when "--bench" is passed, they report numbers instead of just passing or failing.
+	};
+
+	class TestRunner
+	{
+	private:
+		static inline const char* m_currentTest;
+		static inline uint32_t m_checks;
+		static inline uint32_t m_failures;
+
+	public:
+		static std::vector<TestCase>& GetCases();
+		static bool Register(const char* name, void(*function)(), bool bBenchmark);
+		static void Check(bool bPassed, const char* expression, const char* file, int32_t line); // Failed checks are printed but don't stop the test, so every broken expectation shows up at once.
+		static void Report(const std::string& result); // Prints a benchmark result under the name of the running test.
+		static int32_t Run(const std::string& filter, bool bBenchmarks); // Runs every test whose name contains the filter, returns the amount of failed checks.
+	};
+
+	// Replaces "GObjects" with a table the test controls, and resets the components it touched once it goes out of scope.
+	// Slots are given out in order with the same ten trailing empty slots the components skip, and every object's "ObjectInternalInteger" is its slot.
+	class ObjectTable
+	{
+	private:
+		TArray<class UObject*>* m_previousObjects;
+		TArray<class UObject*> m_objects;
+		std::vector<std::shared_ptr<void>> m_ownedObjects; // Type erased so objects are freed as what they were created as, "UObject" has no virtual destructor.
+
+	public:
+		ObjectTable();
+		ObjectTable(const ObjectTable& objectTable) = delete;
+		~ObjectTable();
+
+	public:
+		size_t Size() const; // Amount of slots the components will look at, not counting the trailing empty ones.
+		class UObject* At(size_t objectIndex) const;
+		class UObject* Create(const std::string& fullName, class UClass* uClass, uint64_t objectFlags = 0);
+		class UClass* CreateClass(const std::string& fullName, class UClass* superClass);
+		class UFunction* CreateFunction(const std::string& fullName, uint16_t paramsSize = 0, class UObject* outer = nullptr);
+		void Destroy(size_t objectIndex); // Empties the slot like the garbage collector would, the object itself stays allocated so stale pointers can still be compared.
+		class UObject* Reuse(size_t objectIndex, const std::string& fullName, class UClass* uClass, uint64_t objectFlags = 0); // Puts a new object in an existing slot, like the garbage collector handing it out again.
+		class UFunction* ReuseFunction(size_t objectIndex, const std::string& fullName, uint16_t paramsSize = 0, class UObject* outer = nullptr);
+
+	private:
+		template <typename T> T* Allocate(const std::string& fullName, class UClass* uClass, uint64_t objectFlags)
+		{
+			std::shared_ptr<T> newObject = std::make_shared<T>();
+			newObject->ObjectFlags = objectFlags;
+			newObject->Class = uClass;
+			newObject->TestFullName = fullName;
+			m_ownedObjects.push_back(newObject);
+			return newObject.get();
+		}
+
+		void Insert(class UObject* uObject);
+		void Replace(size_t objectIndex, class UObject* uObject);
+
+	public:
+		ObjectTable& operator=(const ObjectTable& objectTable) = delete;
+	};
+
+	// Returns how long the body took to run the given amount of iterations, divided by the iterations.
+	double MeasureNanoseconds(size_t iterations, const Delegate<void()>& body);
+
+	// Returns how many times the body called "operator new" on the calling thread, counted by the replacement in "Tests.cpp".
+	size_t CountAllocations(const Delegate<void()>& body);
+}
+
+#define TEST_CASE(testName) static void testName(); static const bool testName##Registered = CodeRed::Tests::TestRunner::Register(#testName, testName, false); static void testName()
+#define BENCHMARK_CASE(testName) static void testName(); static const bool testName##Registered = CodeRed::Tests::TestRunner::Register(#testName, testName, true); static void testName()
+#define TEST_CHECK(...) CodeRed::Tests::TestRunner::Check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__) // Variadic so template arguments with commas don't need extra parentheses.
@@ -0,0 +1,166 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	static constexpr size_t TRIGRAM_TEST_NAMES = 20000;
+	static constexpr size_t TRIGRAM_BENCHMARK_NAMES = 1000000;
+	static constexpr size_t TRIGRAM_QUERIES = 200;
+
+	// Names shaped like "Texture2D Park_P.Textures.Noise_Rock_12", most share long prefixes like real packages do.
+	static std::vector<std::string> CreateNames(size_t nameCount)
+	{
+		static const std::array<const char*, 6> classNames = { "Texture2D", "Material", "StaticMesh", "SoundCue", "Function", "ParticleSystem" };
+		static const std::array<const char*, 8> packageNames = { "Park_P", "Stadium_P", "Engine", "TAGame", "GameInfo_Soccar", "Wasteland_P", "Core", "UI" };
+		static const std::array<const char*, 10> wordNames = { "Noise", "Rock", "Grass", "Boost", "Ball", "Goal", "Car", "Wheel", "Decal", "Light" };
+		std::mt19937 randomEngine(0x7216);
+		std::vector<std::string> names;
+		names.reserve(nameCount);
+
+		for (size_t i = 0; i < nameCount; i++)
+		{
+			names.push_back(std::string(classNames[randomEngine() % classNames.size()]) + " " + packageNames[randomEngine() % packageNames.size()] + "." + wordNames[randomEngine() % wordNames.size()] + "s." + wordNames[randomEngine() % wordNames.size()] + "_" + wordNames[randomEngine() % wordNames.size()] + "_" + std::to_string(i));
+		}
+
+		return names;
+	}
+
+	// Random slices of real names, plus a few that can't match anything.
+	static std::vector<std::string> CreateQueries(const std::vector<std::string>& names, size_t queryCount)
+	{
+		std::mt19937 randomEngine(0x5EED);
+		std::vector<std::string> queries = { "Noise", "Rock_Ball", "Texture2D Park", "NotInAnyName", "_12", "zzz" };
+
+		while (queries.size() < queryCount)
+		{
+			const std::string& name = names[randomEngine() % names.size()];
+			size_t length = (TRIGRAM_LENGTH + (randomEngine() % 10));
+			size_t position = (randomEngine() % (name.size() - length));
+			queries.push_back(name.substr(position, length));
+		}
+
+		return queries;
+	}
+
+	TEST_CASE(TrigramCandidatesCoverBruteForce)
+	{
+		std::vector<std::string> names = CreateNames(TRIGRAM_TEST_NAMES);
+		TrigramIndex trigramIndex;
+
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			trigramIndex.Add(static_cast<uint32_t>(i), names[i]);
+		}
+
+		TEST_CHECK(trigramIndex.GetNameCount() == names.size());
+		TEST_CHECK(!trigramIndex.Add(0, "Out of order"));
+		std::vector<uint32_t> candidates;
+		TEST_CHECK(!trigramIndex.Query("No", candidates));
+		size_t missedMatches = 0;
+		size_t wrongMatches = 0;
+
+		for (const std::string& query : CreateQueries(names, TRIGRAM_QUERIES))
+		{
+			TEST_CHECK(trigramIndex.Query(query, candidates));
+			TEST_CHECK(std::is_sorted(candidates.begin(), candidates.end()));
+			std::vector<uint32_t> verifiedMatches;
+
+			for (uint32_t candidate : candidates)
+			{
+				if (names[candidate].find(query) != std::string::npos)
+				{
+					verifiedMatches.push_back(candidate);
+				}
+			}
+
+			std::vector<uint32_t> bruteMatches;
+
+			for (size_t i = 0; i < names.size(); i++)
+			{
+				if (names[i].find(query) != std::string::npos)
+				{
+					bruteMatches.push_back(static_cast<uint32_t>(i));
+				}
+			}
+
+			// Candidates can have extra names, but never miss one that really contains the substring.
+			missedMatches += (bruteMatches.size() - std::min(bruteMatches.size(), verifiedMatches.size()));
+			wrongMatches += (verifiedMatches != bruteMatches);
+		}
+
+		TEST_CHECK(missedMatches == 0);
+		TEST_CHECK(wrongMatches == 0);
+
+		trigramIndex.Clear();
+		TEST_CHECK(trigramIndex.IsEmpty());
+		TEST_CHECK(trigramIndex.Query("Noise", candidates) && candidates.empty());
+	}
+
+	// Slots reused after the index was built aren't in it, queries have to find them without waiting for a tick or a rebuild.
+	TEST_CASE(TrigramQueriesFindReusedSlots)
+	{
+		ObjectTable objectTable;
+		UObject* rockTexture = objectTable.Create("Actor TheWorld.PersistentLevel.Noise_Rock", AActor::StaticClass());
+		UObject* grassTexture = objectTable.Create("Actor TheWorld.PersistentLevel.Noise_Grass", AActor::StaticClass());
+		TEST_CHECK(Instances.BuildTrigramIndex());
+		std::vector<UObject*> nameMatches;
+
+		while (!Instances.FindNameMatches("Noise", AActor::StaticClass(), false, nameMatches))
+		{
+			std::this_thread::yield();
+		}
+
+		TEST_CHECK(nameMatches == std::vector<UObject*>{ grassTexture, rockTexture });
+
+		objectTable.Destroy(rockTexture->ObjectInternalInteger);
+		UObject* ballTexture = objectTable.Reuse(rockTexture->ObjectInternalInteger, "Actor TheWorld.PersistentLevel.Noise_Ball", AActor::StaticClass());
+		TEST_CHECK(Instances.FindNameMatches("Noise_Ball", AActor::StaticClass(), true, nameMatches));
+		TEST_CHECK(nameMatches == std::vector<UObject*>{ ballTexture });
+		TEST_CHECK(Instances.FindNameMatches("Noise_Rock", AActor::StaticClass(), false, nameMatches) && nameMatches.empty());
+		Instances.ClearTrigramIndex();
+	}
+
+	BENCHMARK_CASE(TrigramIndexMillionNames)
+	{
+		std::vector<std::string> names = CreateNames(TRIGRAM_BENCHMARK_NAMES);
+		std::vector<std::string> queries = CreateQueries(names, TRIGRAM_QUERIES);
+		TrigramIndex trigramIndex;
+		std::chrono::steady_clock::time_point buildStart = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			trigramIndex.Add(static_cast<uint32_t>(i), names[i]);
+		}
+
+		double buildTime = (static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - buildStart).count()) / 1000.0);
+		std::vector<uint32_t> candidates;
+		size_t queryIndex = 0;
+		size_t indexMatches = 0;
+		size_t scanMatches = 0;
+
+		double indexTime = MeasureNanoseconds(queries.size(), [&]() {
+			const std::string& query = queries[queryIndex++];
+			trigramIndex.Query(query, candidates);
+
+			for (uint32_t candidate : candidates)
+			{
+				indexMatches += (names[candidate].find(query) != std::string::npos);
+			}
+		});
+
+		queryIndex = 0;
+
+		double scanTime = MeasureNanoseconds(queries.size(), [&]() {
+			const std::string& query = queries[queryIndex++];
+
+			for (const std::string& name : names)
+			{
+				scanMatches += (name.find(query) != std::string::npos);
+			}
+		});
+
+		TEST_CHECK(indexMatches == scanMatches);
+		TestRunner::Report(std::to_string(names.size()) + " names, built in " + std::to_string(buildTime) + "ms using " + std::to_string(trigramIndex.GetMemoryUsage() / 1024) + "KB for " + std::to_string(trigramIndex.GetTrigramCount()) + " trigrams.");
+		TestRunner::Report("Indexed query " + std::to_string(indexTime / 1000.0) + "us, full scan " + std::to_string(scanTime / 1000.0) + "us on average, including checking every candidate.");
+	}
+}
@@ -0,0 +1,62 @@
+#include "Tests.hpp"
+#include "../Components/Includes.hpp"
+
+namespace CodeRed::Tests
+{
+	// The engine reports five bytes for this, the compiler pads it out to eight.
+	struct PaddedParams
+	{
+		int32_t Value;
+		uint8_t Flag;
+	};
+
+	struct EmptyParams {};
+
+	TEST_CASE(TypedHookAllowsTrailingPadding)
+	{
+		ObjectTable objectTable;
+		UFunction* unpaddedFunction = objectTable.CreateFunction("Function Engine.Actor.Unpadded", 5);
+		UFunction* paddedFunction = objectTable.CreateFunction("Function Engine.Actor.Padded", sizeof(PaddedParams));
+		objectTable.CreateFunction("Function Engine.Actor.TooSmall", 4);
+		objectTable.CreateFunction("Function Engine.Actor.TooLarge", (sizeof(PaddedParams) + 1));
+		UFunction* emptyFunction = objectTable.CreateFunction("Function Engine.Actor.Empty", 0);
+		auto callback = [](AActor& actor, PaddedParams& params, PreEvent& event) {};
+
+		TEST_CHECK(EventsComponent::HookEventPre<AActor, PaddedParams>("Function Engine.Actor.Unpadded", callback) != 0);
+		TEST_CHECK(EventsComponent::HookEventPre<AActor, PaddedParams>("Function Engine.Actor.Padded", callback) != 0);
+		TEST_CHECK(EventsComponent::HookEventPre<AActor, PaddedParams>("Function Engine.Actor.TooSmall", callback) == 0);
+		TEST_CHECK(EventsComponent::HookEventPre<AActor, PaddedParams>("Function Engine.Actor.TooLarge", callback) == 0);
+		TEST_CHECK(EventsComponent::HookEventPost<AActor, EmptyParams>("Function Engine.Actor.Empty", [](AActor& actor, EmptyParams& params, const PostEvent& event) {}) != 0);
+		TEST_CHECK(EventsComponent::IsPreHooked(unpaddedFunction));
+		TEST_CHECK(EventsComponent::IsPreHooked(paddedFunction));
+		TEST_CHECK(EventsComponent::IsPostHooked(emptyFunction));
+	}
+
+	TEST_CASE(TypedHookSkipsMissingCallerOrParams)
+	{
+		ObjectTable objectTable;
+		UFunction* function = objectTable.CreateFunction("Function Engine.Actor.Touch", 5);
+		AActor* caller = static_cast<AActor*>(objectTable.Create("Actor TheWorld.PersistentLevel.Actor_0", AActor::StaticClass()));
+		PaddedParams params{ 42, 1 };
+		int32_t seenValue = 0;
+		uint32_t preCalls = 0;
+		uint32_t postCalls = 0;
+
+		TEST_CHECK(EventsComponent::HookEventPre<AActor, PaddedParams>("Function Engine.Actor.Touch", [&](AActor& actor, PaddedParams& typedParams, PreEvent& event) {
+			seenValue = typedParams.Value;
+			preCalls++;
+		}) != 0);
+
+		TEST_CHECK(EventsComponent::HookEventPost<AActor, PaddedParams>("Function Engine.Actor.Touch", [&](AActor& actor, PaddedParams& typedParams, const PostEvent& event) { postCalls++; }) != 0);
+
+		EventsComponent::DispatchEvent(caller, function, nullptr, nullptr, EventTypes::ProcessEvent, []() {});
+		EventsComponent::DispatchEvent(nullptr, function, &params, nullptr, EventTypes::ProcessEvent, []() {});
+		TEST_CHECK(preCalls == 0);
+		TEST_CHECK(postCalls == 0);
+
+		EventsComponent::DispatchEvent(caller, function, &params, nullptr, EventTypes::ProcessEvent, []() {});
+		TEST_CHECK(preCalls == 1);
+		TEST_CHECK(postCalls == 1);
+		TEST_CHECK(seenValue == 42);
+	}
+}
@@ -8,6 +8,12 @@
 namespace CodeRed
 {
 	static constexpr size_t INSTANCES_INTERATE_OFFSET = 10;
+	static constexpr size_t INSTANCES_COMPARE_BLOCK_SIZE = 1024; // How many indexed slots are compared with "GObjects" at once when looking for reused slots, only blocks that differ are checked slot by slot.
+	static constexpr size_t INSTANCES_SCAN_CHUNK_SIZE = 8192; // Minimum amount of objects each thread gets in a parallel scan, smaller scans aren't worth splitting up.
+	static constexpr size_t INSTANCES_SCAN_MAX_THREADS = 16;
+	static constexpr uint32_t INSTANCES_NAME_NO_OWNER = 0xFFFFFFFF; // Full names whose owning slot was unnamed, the other slots with that name are checked again on the next lookup.
+	static constexpr size_t INSTANCES_TRIGRAM_DIRTY_LIMIT = 65536; // How many slots can change after the trigram index was built before a warning to rebuild it is written, as every query has to check them by hand.
+	static constexpr size_t EVENTS_RESOLVE_DIFF_BUDGET = 16384; // How many already resolved "GObjects" slots are rechecked each tick for functions that were garbage collected or loaded into a reused slot.
 	static constexpr uint64_t GOLDEN_RATIO_MAGIC = 0x9E3779B9;
 
 	enum class EventTypes : uint8_t
@@ -12,8 +12,10 @@
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
+#include <cstring>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
 #include <string>
 #include <numeric>
@@ -22,14 +24,32 @@
 #include <random>
 #include <inttypes.h>
 #include <filesystem>
+#include <atomic>
+#include <bit>
+#include <array>
+#include <optional>
 
 // CodeRed Macros
 #define WALKTHROUGH
+#define EVENT_PROFILER // Comment out to compile the "EventProfiler" out of the dispatch path, "events_profile" then has nothing to record.
 
 #include "Types.hpp"
+#ifdef CR_TESTS
+#include "Tests/TestSDK/SdkHeaders.hpp"
+#else
 #include "PlaceHolderSDK/SdkHeaders.hpp"
+#endif
+#include "Framework/Delegate/Delegate.hpp"
 #include "Framework/FunctionHook/FunctionHook.hpp"
-#include "Framework/EventGuard/EventGuard.hpp"
+#include "Framework/ThreadPool/ThreadPool.hpp"
+#include "Framework/BufferPool/BufferPool.hpp"
+#include "Framework/DispatchFrame/DispatchFrame.hpp"
+#include "Framework/AtomicBitset/AtomicBitset.hpp"
+#include "Framework/EpochGuard/EpochGuard.hpp"
+#include "Framework/EventProfiler/EventProfiler.hpp"
+#include "Framework/EventRecorder/EventRecorder.hpp"
+#include "Framework/EventCensus/EventCensus.hpp"
+#include "Framework/TrigramIndex/TrigramIndex.hpp"
 
 #ifdef CR_DETOURS
 #include <detours.h>